@@ -79,21 +79,11 @@ IntfMgr::IntfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, c
 void IntfMgr::setIntfIp(const string &alias, const string &opCmd,
                         const IpPrefix &ipPrefix)
 {
-    stringstream    cmd;
-    string          res;
-    string          ipPrefixStr = ipPrefix.to_string();
-    string          broadcastIpStr = ipPrefix.getBroadcastIp().to_string();
     int             prefixLen = ipPrefix.getMaskLength();
+    uint32_t        metric = 0;
 
-    if (ipPrefix.isV4())
+    if (!ipPrefix.isV4())
     {
-        (prefixLen < 31) ?
-        (cmd << IP_CMD << " address " << shellquote(opCmd) << " " << shellquote(ipPrefixStr) << " broadcast " << shellquote(broadcastIpStr) <<" dev " << shellquote(alias)) :
-        (cmd << IP_CMD << " address " << shellquote(opCmd) << " " << shellquote(ipPrefixStr) << " dev " << shellquote(alias));
-    }
-    else
-    {
-        string metric = "";
         // Kernel adds connected route with default metric of 256. But the metric is not
         // communicated to frr unless the ip address is added with explicit metric
         // In voq system, We need the static route to the remote neighbor and connected
@@ -103,53 +93,48 @@ void IntfMgr::setIntfIp(const string &alias, const string &opCmd,
         // to set the metric explicitly.
         if(mySwitchType == "voq")
         {
-           metric = " metric 256";
+           metric = 256;
         }
-
-        (prefixLen < 127) ?
-        (cmd << IP_CMD << " -6 address " << shellquote(opCmd) << " " << shellquote(ipPrefixStr) << " broadcast " << shellquote(broadcastIpStr) <<
-         " dev " << shellquote(alias) << metric) :
-        (cmd << IP_CMD << " -6 address " << shellquote(opCmd) << " " << shellquote(ipPrefixStr) << " dev " << shellquote(alias) << metric);
     }
 
-    int ret = swss::exec(cmd.str(), res);
-    if (ret)
+    // Sent at the end of the task
+    if (opCmd == "add")
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+        // The kernel ignores the broadcast address of IPv6 prefixes
+        m_kernelCfg.addAddress(alias, ipPrefix, ipPrefix.isV4() && prefixLen < 31, metric);
+    }
+    else
+    {
+        m_kernelCfg.delAddress(alias, ipPrefix);
     }
 }
 
 void IntfMgr::setIntfMac(const string &alias, const string &mac_str)
 {
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD << " link set " << alias << " address " << mac_str;
-
-    int ret = swss::exec(cmd.str(), res);
-    if (ret)
+    // ip link set <alias> address <mac>, sent at the end of the task
+    try
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+        m_kernelCfg.setLinkMac(alias, MacAddress(mac_str));
+    }
+    catch (const std::invalid_argument &e)
+    {
+        SWSS_LOG_ERROR("Invalid MAC address %s for %s", mac_str.c_str(), alias.c_str());
     }
 }
 
 void IntfMgr::setIntfVrf(const string &alias, const string &vrfName)
 {
-    stringstream cmd;
-    string res;
+    // ip link set <alias> master <vrf>|nomaster, sent at the end of the task
+    m_kernelCfg.setLinkMaster(alias, vrfName);
+}
 
-    if (!vrfName.empty())
-    {
-        cmd << IP_CMD << " link set " << shellquote(alias) << " master " << shellquote(vrfName);
-    }
-    else
-    {
-        cmd << IP_CMD << " link set " << shellquote(alias) << " nomaster";
-    }
-    int ret = swss::exec(cmd.str(), res);
-    if (ret)
+void IntfMgr::flushKernelCfg()
+{
+    string error;
+
+    if (!m_kernelCfg.flush(error))
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+        SWSS_LOG_ERROR("Command '%s' failed", error.c_str());
     }
 }
 
@@ -418,9 +403,6 @@ void IntfMgr::updateSubIntfMtu(const string &alias, const string &mtu)
 
 std::string IntfMgr::setHostSubIntfMtu(const string &alias, const string &mtu, const string &parent_mtu)
 {
-    stringstream cmd;
-    string res;
-
     string subifMtu = mtu;
     subIntf subIf(alias);
 
@@ -432,8 +414,11 @@ std::string IntfMgr::setHostSubIntfMtu(const string &alias, const string &mtu, c
         subifMtu = parent_mtu;
     }
     SWSS_LOG_INFO("subintf %s active mtu: %s", alias.c_str(), subifMtu.c_str());
-    cmd << IP_CMD " link set " << shellquote(alias) << " mtu " << shellquote(subifMtu);
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+
+    /* Applied right away, a failure throws to fail the sub interface task alone */
+    flushKernelCfg();
+    m_kernelCfg.setLinkMtu(alias, subifMtu);
+    m_kernelCfg.flush();
 
     return subifMtu;
 }
@@ -465,14 +450,14 @@ void IntfMgr::updateSubIntfAdminStatus(const string &alias, const string &admin)
 
 std::string IntfMgr::setHostSubIntfAdminStatus(const string &alias, const string &admin_status, const string &parent_admin_status)
 {
-    stringstream cmd;
-    string res;
-
     if (parent_admin_status == "up" || admin_status == "down")
     {
         SWSS_LOG_INFO("subintf %s admin_status: %s", alias.c_str(), admin_status.c_str());
-        cmd << IP_CMD " link set " << shellquote(alias) << " " << shellquote(admin_status);
-        EXEC_WITH_ERROR_THROW(cmd.str(), res);
+
+        /* Applied right away, a failure throws to fail the sub interface task alone */
+        flushKernelCfg();
+        m_kernelCfg.setLinkAdminState(alias, admin_status);
+        m_kernelCfg.flush();
         return admin_status;
     }
     else
@@ -949,6 +934,9 @@ bool IntfMgr::doIntfGeneralTask(const vector<string>& keys,
     }
     else if (op == DEL_COMMAND)
     {
+        /* The address removals of the task must be applied before they are counted */
+        flushKernelCfg();
+
         /* make sure all ip addresses associated with interface are removed, otherwise these ip address would
            be set with global vrf and it may cause ip address conflict. */
         if (getIntfIpCount(alias))
@@ -956,7 +944,9 @@ bool IntfMgr::doIntfGeneralTask(const vector<string>& keys,
             return false;
         }
 
+        /* Unbind the interface now, it may be removed right after */
         setIntfVrf(alias, "");
+        flushKernelCfg();
 
         if (is_lo)
         {
@@ -1111,6 +1101,9 @@ void IntfMgr::doTask(Consumer &consumer)
         it = consumer.m_toSync.erase(it);
     }
 
+    /* Apply the addresses, MACs and VRF bindings of the task in one go */
+    flushKernelCfg();
+
     if (!m_replayDone && WarmStart::isWarmStart() && m_pendingReplayIntfList.empty() )
     {
         setWarmReplayDoneState();
@@ -4,6 +4,7 @@
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "orch.h"
+#include "kernelcfg.h"
 
 #include <map>
 #include <string>
@@ -38,10 +39,13 @@ private:
     std::set<std::string> m_pendingReplayIntfList;
     std::set<std::string> m_ipv6LinkLocalModeList;
     std::string mySwitchType;
+    KernelCfg m_kernelCfg;
 
     void setIntfIp(const std::string &alias, const std::string &opCmd, const IpPrefix &ipPrefix);
     void setIntfVrf(const std::string &alias, const std::string &vrfName);
     void setIntfMac(const std::string &alias, const std::string &macAddr);
+    /* Send the requests queued by setIntfIp, setIntfMac and setIntfVrf */
+    void flushKernelCfg();
     bool setIntfMpls(const std::string &alias, const std::string &mpls);
 
     bool doIntfGeneralTask(const std::vector<std::string>& keys, std::vector<FieldValueTuple> data, const std::string& op);
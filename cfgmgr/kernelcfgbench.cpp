@@ -0,0 +1,160 @@
+#include <getopt.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "exec.h"
+#include "shellcmd.h"
+#include "kernelcfg.h"
+
+using namespace std;
+using namespace swss;
+
+/*
+ * Measure how long applying a boot-time interface config takes: MTU, MAC,
+ * IPv4 address and admin state for each of <links> veth interfaces, once
+ * with one ip command per operation as the cfgmgr daemons used to, once
+ * with one KernelCfg flush per operation as they do now, and once with the
+ * whole config in one KernelCfg batch. Needs CAP_NET_ADMIN, the interfaces
+ * are created for the run and removed afterwards.
+ */
+
+#define BENCH_LINK_PREFIX "kcbench"
+
+void usage()
+{
+    cout << "usage: kernelcfgbench [-n links]" << endl;
+    cout << "    -n links: number of interfaces to configure (default 256)" << endl;
+}
+
+static string linkName(int i)
+{
+    return BENCH_LINK_PREFIX + to_string(i);
+}
+
+static string linkMac(int i)
+{
+    char mac[18];
+    snprintf(mac, sizeof(mac), "02:00:00:00:%02x:%02x", (i >> 8) & 0xff, i & 0xff);
+    return mac;
+}
+
+static string linkPrefix(int i)
+{
+    return "10." + to_string(100 + (i >> 8)) + "." + to_string(i & 0xff) + ".1/24";
+}
+
+static void run(const string &cmd)
+{
+    string res;
+    EXEC_WITH_ERROR_THROW(cmd, res);
+}
+
+/* Bring the interfaces back to their initial state between the runs */
+static void reset(int links)
+{
+    KernelCfg kernelCfg;
+    for (int i = 0; i < links; i++)
+    {
+        kernelCfg.setLinkAdminState(linkName(i), false);
+        kernelCfg.setLinkMtu(linkName(i), 1500);
+        kernelCfg.delAddress(linkName(i), IpPrefix(linkPrefix(i)));
+    }
+    string error;
+    kernelCfg.flush(error);
+}
+
+static void applyShell(int links)
+{
+    for (int i = 0; i < links; i++)
+    {
+        run(string(IP_CMD) + " link set dev " + linkName(i) + " mtu 9100");
+        run(string(IP_CMD) + " link set dev " + linkName(i) + " address " + linkMac(i));
+        run(string(IP_CMD) + " address add " + linkPrefix(i) + " dev " + linkName(i));
+        run(string(IP_CMD) + " link set dev " + linkName(i) + " up");
+    }
+}
+
+static void applyKernelCfg(int links, bool batch)
+{
+    KernelCfg kernelCfg;
+    for (int i = 0; i < links; i++)
+    {
+        kernelCfg.setLinkMtu(linkName(i), 9100);
+        if (!batch) kernelCfg.flush();
+        kernelCfg.setLinkMac(linkName(i), MacAddress(linkMac(i)));
+        if (!batch) kernelCfg.flush();
+        kernelCfg.addAddress(linkName(i), IpPrefix(linkPrefix(i)), true);
+        if (!batch) kernelCfg.flush();
+        kernelCfg.setLinkAdminState(linkName(i), true);
+        kernelCfg.flush();
+    }
+}
+
+template <typename F>
+static void measure(const string &name, int links, F apply)
+{
+    reset(links);
+
+    auto begin = chrono::steady_clock::now();
+    apply();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - begin;
+
+    cout << name << ": " << links * 4 << " operations in " << elapsed.count() << " s ("
+         << (elapsed.count() > 0 ? links * 4 / elapsed.count() : 0) << " operations/s)" << endl;
+}
+
+int main(int argc, char **argv)
+{
+    int links = 256;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            links = atoi(optarg);
+            break;
+        case 'h':
+            usage();
+            return EXIT_SUCCESS;
+        default:
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (links <= 0 || links > 0xffff || optind != argc)
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    int ret = EXIT_SUCCESS;
+    int created = 0;
+    try
+    {
+        for (; created < links; created++)
+        {
+            run(string(IP_CMD) + " link add " + linkName(created) + " type veth peer name " +
+                linkName(created) + "p");
+        }
+
+        measure("ip commands", links, [&]() { applyShell(links); });
+        measure("KernelCfg, flush per operation", links, [&]() { applyKernelCfg(links, false); });
+        measure("KernelCfg, flush per interface", links, [&]() { applyKernelCfg(links, true); });
+    }
+    catch (const exception &e)
+    {
+        cerr << e.what() << endl;
+        ret = EXIT_FAILURE;
+    }
+
+    for (int i = 0; i < created; i++)
+    {
+        string res;
+        swss::exec(string(IP_CMD) + " link del " + linkName(i), res);
+    }
+
+    return ret;
+}
@@ -22,12 +22,8 @@ PortMgr::PortMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, c
 
 bool PortMgr::setPortMtu(const string &alias, const string &mtu)
 {
-    stringstream cmd;
-    string res;
-
-    // ip link set dev <port_name> mtu <mtu>
-    cmd << IP_CMD << " link set dev " << shellquote(alias) << " mtu " << shellquote(mtu);
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    // ip link set dev <port_name> mtu <mtu>, sent at the end of the task
+    m_kernelCfg.setLinkMtu(alias, mtu);
 
     // Set the port MTU in application database to update both
     // the port MTU and possibly the port based router interface MTU
@@ -56,12 +52,8 @@ bool PortMgr::setPortTpid(const string &alias, const string &tpid)
 
 bool PortMgr::setPortAdminStatus(const string &alias, const bool up)
 {
-    stringstream cmd;
-    string res;
-
-    // ip link set dev <port_name> [up|down]
-    cmd << IP_CMD << " link set dev " << shellquote(alias) << (up ? " up" : " down");
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    // ip link set dev <port_name> [up|down], sent at the end of the task
+    m_kernelCfg.setLinkAdminState(alias, up);
 
     vector<FieldValueTuple> fvs;
     FieldValueTuple fv("admin_status", (up ? "up" : "down"));
@@ -192,4 +184,7 @@ void PortMgr::doTask(Consumer &consumer)
 
         it = consumer.m_toSync.erase(it);
     }
+
+    /* Apply the kernel settings of all the ports of the task in one go */
+    m_kernelCfg.flush();
 }
@@ -3,6 +3,7 @@
 #include "dbconnector.h"
 #include "orch.h"
 #include "producerstatetable.h"
+#include "kernelcfg.h"
 
 #include <map>
 #include <set>
@@ -25,6 +26,7 @@ private:
     Table m_cfgLagMemberTable;
     Table m_statePortTable;
     ProducerStateTable m_appPortTable;
+    KernelCfg m_kernelCfg;
 
     std::set<std::string> m_portList;
 
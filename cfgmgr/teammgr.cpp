@@ -278,6 +278,8 @@ void TeamMgr::doLagTask(Consumer &consumer)
         {
             if (m_lagList.find(alias) != m_lagList.end())
             {
+                /* Settings still queued for the LAG must reach it before it goes */
+                m_kernelCfg.flush();
                 removeLag(alias);
                 m_lagList.erase(alias);
             }
@@ -285,6 +287,9 @@ void TeamMgr::doLagTask(Consumer &consumer)
 
         it = consumer.m_toSync.erase(it);
     }
+
+    /* Apply the kernel settings of all the LAGs of the task in one go */
+    m_kernelCfg.flush();
 }
 
 void TeamMgr::doLagMemberTask(Consumer &consumer)
@@ -420,12 +425,8 @@ bool TeamMgr::setLagAdminStatus(const string &alias, const string &admin_status)
 {
     SWSS_LOG_ENTER();
 
-    stringstream cmd;
-    string res;
-
-    // ip link set dev <port_channel_name> [up|down]
-    cmd << IP_CMD << " link set dev " << shellquote(alias) << " " << shellquote(admin_status);
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    // ip link set dev <port_channel_name> [up|down], sent at the end of the task
+    m_kernelCfg.setLinkAdminState(alias, admin_status);
 
     SWSS_LOG_NOTICE("Set port channel %s admin status to %s",
             alias.c_str(), admin_status.c_str());
@@ -437,12 +438,8 @@ bool TeamMgr::setLagMtu(const string &alias, const string &mtu)
 {
     SWSS_LOG_ENTER();
 
-    stringstream cmd;
-    string res;
-
-    // ip link set dev <port_channel_name> mtu <mtu_value>
-    cmd << IP_CMD << " link set dev " << shellquote(alias) << " mtu " << shellquote(mtu);
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    // ip link set dev <port_channel_name> mtu <mtu_value>, sent at the end of the task
+    m_kernelCfg.setLinkMtu(alias, mtu);
 
     vector<FieldValueTuple> fvs;
     FieldValueTuple fv("mtu", mtu);
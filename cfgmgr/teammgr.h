@@ -7,6 +7,7 @@
 #include "netmsg.h"
 #include "orch.h"
 #include "producerstatetable.h"
+#include "kernelcfg.h"
 #include <sys/types.h>
 
 namespace swss {
@@ -34,6 +35,7 @@ private:
     std::set<std::string> m_lagList;
 
     MacAddress m_mac;
+    KernelCfg m_kernelCfg;
 
     void doTask(Consumer &consumer);
     void doLagTask(Consumer &consumer);
@@ -23,12 +23,13 @@ extern MacAddress gMacAddress;
 
 VlanMgr::VlanMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames) :
         Orch(cfgDb, tableNames),
+        m_statePipeline(stateDb),
         m_cfgVlanTable(cfgDb, CFG_VLAN_TABLE_NAME),
         m_cfgVlanMemberTable(cfgDb, CFG_VLAN_MEMBER_TABLE_NAME),
         m_statePortTable(stateDb, STATE_PORT_TABLE_NAME),
         m_stateLagTable(stateDb, STATE_LAG_TABLE_NAME),
         m_stateVlanTable(stateDb, STATE_VLAN_TABLE_NAME),
-        m_stateVlanMemberTable(stateDb, STATE_VLAN_MEMBER_TABLE_NAME),
+        m_stateVlanMemberTable(&m_statePipeline, STATE_VLAN_MEMBER_TABLE_NAME, true),
         m_appVlanTableProducer(appDb, APP_VLAN_TABLE_NAME),
         m_appVlanMemberTableProducer(appDb, APP_VLAN_MEMBER_TABLE_NAME),
         replayDone(false)
@@ -159,13 +160,9 @@ bool VlanMgr::setHostVlanAdminState(int vlan_id, const string &admin_status)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
+    // Equivalent to, sent at the end of the task:
     // /sbin/ip link set Vlan{{vlan_id}} {{admin_status}}
-    ostringstream cmds;
-    cmds << IP_CMD " link set " VLAN_PREFIX + std::to_string(vlan_id) + " " << shellquote(admin_status);
-
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds.str(), res);
+    m_kernelCfg.setLinkAdminState(VLAN_PREFIX + std::to_string(vlan_id), admin_status);
 
     return true;
 }
@@ -174,14 +171,11 @@ bool VlanMgr::setHostVlanMtu(int vlan_id, uint32_t mtu)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
+    // Equivalent to:
     // /sbin/ip link set Vlan{{vlan_id}} mtu {{mtu}}
-    const std::string cmds = std::string("")
-      + IP_CMD + " link set " + VLAN_PREFIX + std::to_string(vlan_id) + " mtu " + std::to_string(mtu);
-
-    std::string res;
-    int ret = swss::exec(cmds, res);
-    if (ret == 0)
+    std::string error;
+    m_kernelCfg.setLinkMtu(VLAN_PREFIX + std::to_string(vlan_id), mtu);
+    if (m_kernelCfg.flush(error))
     {
         return true;
     }
@@ -194,78 +188,117 @@ bool VlanMgr::setHostVlanMac(int vlan_id, const string &mac)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
-    // /sbin/ip link set Vlan{{vlan_id}} address {{mac}}
-    ostringstream cmds;
-    cmds << IP_CMD " link set " VLAN_PREFIX + std::to_string(vlan_id) + " address " << shellquote(mac) << " && "
-            IP_CMD " link set " DOT1Q_BRIDGE_NAME " address " << shellquote(mac);
-
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds.str(), res);
+    // Equivalent to, the bridge MAC being sent at the end of the task:
+    // /sbin/ip link set Vlan{{vlan_id}} address {{mac}} &&
+    // /sbin/ip link set Bridge address {{mac}}
+    MacAddress macAddress(mac);
+    m_kernelCfg.setLinkMac(VLAN_PREFIX + std::to_string(vlan_id), macAddress);
+    // The bridge MAC is left alone if the VLAN MAC can't be set
+    m_kernelCfg.flush();
+    m_kernelCfg.setLinkMac(DOT1Q_BRIDGE_NAME, macAddress);
 
     return true;
 }
 
-bool VlanMgr::addHostVlanMember(int vlan_id, const string &port_alias, const string& tagging_mode)
+/* Call f(begin, end) for each run of consecutive VLAN ids */
+template <typename F>
+static void forEachVlanRange(const set<uint16_t> &vlan_ids, F f)
 {
-    SWSS_LOG_ENTER();
-
-    std::string tagging_cmd;
-    if (tagging_mode == "untagged" || tagging_mode == "priority_tagged")
+    auto it = vlan_ids.begin();
+    while (it != vlan_ids.end())
     {
-        tagging_cmd = "pvid untagged";
+        uint16_t begin = *it, end = *it;
+        while (++it != vlan_ids.end() && *it == end + 1)
+        {
+            end = *it;
+        }
+        f(begin, end);
     }
+}
 
-    // The command should be generated as:
-    // /bin/bash -c "/sbin/ip link set {{port_alias}} master Bridge &&
-    //               /sbin/bridge vlan del vid 1 dev {{ port_alias }} &&
-    //               /sbin/bridge vlan add vid {{vlan_id}} dev {{port_alias}} {{tagging_mode}}"
-    ostringstream cmds, inner;
-    inner << IP_CMD " link set " << shellquote(port_alias) << " master " DOT1Q_BRIDGE_NAME " && "
-      BRIDGE_CMD " vlan del vid " DEFAULT_VLAN_ID " dev " << shellquote(port_alias) << " && "
-      BRIDGE_CMD " vlan add vid " + std::to_string(vlan_id) + " dev " << shellquote(port_alias) << " " + tagging_cmd;
-    cmds << BASH_CMD " -c " << shellquote(inner.str());
+void VlanMgr::applyHostVlanMembers(const string &port_alias, const HostVlanMemberUpdate &update)
+{
+    SWSS_LOG_ENTER();
 
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds.str(), res);
+    // Equivalent to, with consecutive VLANs merged into ranges:
+    // /sbin/bridge vlan del vid {{removed_vlan_ids}} dev {{port_alias}} &&
+    // /sbin/ip link set {{port_alias}} master Bridge &&
+    // /sbin/bridge vlan del vid 1 dev {{port_alias}} &&
+    // /sbin/bridge vlan add vid {{tagged_vlan_ids}} dev {{port_alias}} &&
+    // /sbin/bridge vlan add vid {{untagged_vlan_id}} dev {{port_alias}} pvid untagged
+    forEachVlanRange(update.removed, [&](uint16_t begin, uint16_t end) {
+        m_kernelCfg.delBridgeVlanRange(port_alias, begin, end);
+    });
+
+    if (!update.tagged.empty() || !update.untagged.empty())
+    {
+        m_kernelCfg.setLinkMaster(port_alias, DOT1Q_BRIDGE_NAME);
+        m_kernelCfg.delBridgeVlan(port_alias, (uint16_t)stoi(DEFAULT_VLAN_ID));
 
-    return true;
+        forEachVlanRange(update.tagged, [&](uint16_t begin, uint16_t end) {
+            m_kernelCfg.addBridgeVlanRange(port_alias, begin, end, false);
+        });
+        for (auto vlan_id : update.untagged)
+        {
+            m_kernelCfg.addBridgeVlan(port_alias, vlan_id, true, true);
+        }
+    }
+
+    m_kernelCfg.flush();
 }
 
-bool VlanMgr::removeHostVlanMember(int vlan_id, const string &port_alias)
+void VlanMgr::detachHostVlanMembers(const set<string> &port_aliases)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
-    // /bin/bash -c '/sbin/bridge vlan del vid {{vlan_id}} dev {{port_alias}} &&
-    //               ( vlanShow=$(/sbin/bridge vlan show dev {{port_alias}});
-    //               ret=$?;
-    //               if [ $ret -eq 0 ]; then
-    //               if (! echo "$vlanShow" | grep -q {{port_alias}})
-    //                 || (echo "$vlanShow" | grep -q None$)
-    //                 || (echo "$vlanShow" | grep -q {{port_alias}}$); then
-    //               /sbin/ip link set {{port_alias}} nomaster;
-    //               fi;
-    //               else exit $ret; fi )'
+    if (port_aliases.empty())
+    {
+        return;
+    }
 
     // When port is not member of any VLAN, it shall be detached from Dot1Q bridge!
-    ostringstream cmds, inner;
-    inner << BRIDGE_CMD " vlan del vid " + std::to_string(vlan_id) + " dev " << shellquote(port_alias) << " && ( "
-      "vlanShow=$(" BRIDGE_CMD " vlan show dev " << shellquote(port_alias) << "); "
-      "ret=$?; "
-      "if [ $ret -eq 0 ]; then "
-      "if (! echo \"$vlanShow\" | " GREP_CMD " -q " << shellquote(port_alias) << ") "
-      " || (echo \"$vlanShow\" | " GREP_CMD " -q None$) "
-      " || (echo \"$vlanShow\" | " GREP_CMD " -q " << shellquote(port_alias) << "$); then "
-      IP_CMD " link set " << shellquote(port_alias) << " nomaster; "
-      "fi; "
-      "else exit $ret; fi )";
-    cmds << BASH_CMD " -c " << shellquote(inner.str());
+    // Equivalent to, for each such port:
+    // /sbin/ip link set {{port_alias}} nomaster
+    set<string> members;
+    m_kernelCfg.getBridgeVlanPorts(members);
 
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds.str(), res);
+    for (const auto &port_alias : port_aliases)
+    {
+        if (members.find(port_alias) == members.end())
+        {
+            m_kernelCfg.setLinkMaster(port_alias, "");
+        }
+    }
 
-    return true;
+    string error;
+    if (!m_kernelCfg.flush(error))
+    {
+        SWSS_LOG_WARN("Command '%s' failed", error.c_str());
+    }
+}
+
+void VlanMgr::publishVlanMember(uint16_t vlan_id, const string &port_alias, const KeyOpFieldsValuesTuple &entry)
+{
+    string key = VLAN_PREFIX + to_string(vlan_id);
+    key += DEFAULT_KEY_SEPARATOR;
+    key += port_alias;
+
+    if (kfvOp(entry) == SET_COMMAND)
+    {
+        m_appVlanMemberTableProducer.set(key, kfvFieldsValues(entry));
+
+        vector<FieldValueTuple> fvVector;
+        FieldValueTuple s("state", "ok");
+        fvVector.push_back(s);
+        m_stateVlanMemberTable.set(kfvKey(entry), fvVector);
+
+        m_vlanMemberReplay.erase(kfvKey(entry));
+    }
+    else
+    {
+        m_appVlanMemberTableProducer.del(key);
+        m_stateVlanMemberTable.del(kfvKey(entry));
+    }
 }
 
 bool VlanMgr::isVlanMacOk()
@@ -417,6 +450,8 @@ void VlanMgr::doVlanTask(Consumer &consumer)
         {
             if (m_vlans.find(key) != m_vlans.end())
             {
+                /* Settings still queued for the VLAN must reach it before it goes */
+                m_kernelCfg.flush();
                 removeHostVlan(vlan_id);
                 m_vlans.erase(key);
                 m_appVlanTableProducer.del(key);
@@ -436,6 +471,10 @@ void VlanMgr::doVlanTask(Consumer &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    /* Apply the admin state and MAC of all the VLANs of the task in one go */
+    m_kernelCfg.flush();
+
     if (!replayDone && m_vlanReplay.empty() &&
         m_vlanMemberReplay.empty() &&
         WarmStart::isWarmStart())
@@ -552,6 +591,11 @@ void VlanMgr::processUntaggedVlanMembers(string vlan, const string &members)
 
 void VlanMgr::doVlanMemberTask(Consumer &consumer)
 {
+    /* The member changes are programmed per port once the whole batch is parsed */
+    map<string, HostVlanMemberUpdate> updates;
+    /* Members removed by this batch, their state is still ok until then */
+    set<string> removedKeys;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -590,7 +634,7 @@ void VlanMgr::doVlanMemberTask(Consumer &consumer)
        // TODO:  store port/lag/VLAN data in local data structure and perform more validations.
         if (op == SET_COMMAND)
         {
-             if (isVlanMemberStateOk(kfvKey(t)))
+             if (isVlanMemberStateOk(kfvKey(t)) && removedKeys.find(kfvKey(t)) == removedKeys.end())
              {
                 SWSS_LOG_DEBUG("%s already set", kfvKey(t).c_str());
                 m_vlanMemberReplay.erase(kfvKey(t));
@@ -624,31 +668,25 @@ void VlanMgr::doVlanMemberTask(Consumer &consumer)
                 continue;
             }
 
-            if (addHostVlanMember(vlan_id, port_alias, tagging_mode))
+            auto &update = updates[port_alias];
+            if (tagging_mode == "tagged")
             {
-                key = VLAN_PREFIX + to_string(vlan_id);
-                key += DEFAULT_KEY_SEPARATOR;
-                key += port_alias;
-                m_appVlanMemberTableProducer.set(key, kfvFieldsValues(t));
-
-                vector<FieldValueTuple> fvVector;
-                FieldValueTuple s("state", "ok");
-                fvVector.push_back(s);
-                m_stateVlanMemberTable.set(kfvKey(t), fvVector);
-
-                m_vlanMemberReplay.erase(kfvKey(t));
+                update.tagged.insert((uint16_t)vlan_id);
+            }
+            else
+            {
+                update.untagged.push_back((uint16_t)vlan_id);
             }
+            update.entries.emplace_back((uint16_t)vlan_id, t);
         }
         else if (op == DEL_COMMAND)
         {
             if (isVlanMemberStateOk(kfvKey(t)))
             {
-                removeHostVlanMember(vlan_id, port_alias);
-                key = VLAN_PREFIX + to_string(vlan_id);
-                key += DEFAULT_KEY_SEPARATOR;
-                key += port_alias;
-                m_appVlanMemberTableProducer.del(key);
-                m_stateVlanMemberTable.del(kfvKey(t));
+                auto &update = updates[port_alias];
+                update.removed.insert((uint16_t)vlan_id);
+                update.entries.emplace_back((uint16_t)vlan_id, t);
+                removedKeys.insert(kfvKey(t));
             }
             else
             {
@@ -663,6 +701,23 @@ void VlanMgr::doVlanMemberTask(Consumer &consumer)
         /* Other than the case of member port/lag is not ready, no retry will be performed */
         it = consumer.m_toSync.erase(it);
     }
+
+    set<string> detached;
+    for (const auto &update : updates)
+    {
+        applyHostVlanMembers(update.first, update.second);
+        for (const auto &entry : update.second.entries)
+        {
+            publishVlanMember(entry.first, update.first, entry.second);
+        }
+        if (!update.second.removed.empty())
+        {
+            detached.insert(update.first);
+        }
+    }
+    detachHostVlanMembers(detached);
+    m_stateVlanMemberTable.flush();
+
     if (!replayDone && m_vlanMemberReplay.empty() &&
         WarmStart::isWarmStart())
     {
@@ -2,8 +2,10 @@
 #define __VLANMGR__
 
 #include "dbconnector.h"
+#include "redispipeline.h"
 #include "producerstatetable.h"
 #include "orch.h"
+#include "kernelcfg.h"
 
 #include <set>
 #include <map>
@@ -18,6 +20,8 @@ public:
     using Orch::doTask;
 
 private:
+    /* Buffers the STATE_DB VLAN member updates of a doVlanMemberTask() run */
+    RedisPipeline m_statePipeline;
     ProducerStateTable m_appVlanTableProducer, m_appVlanMemberTableProducer;
     Table m_cfgVlanTable, m_cfgVlanMemberTable;
     Table m_statePortTable, m_stateLagTable;
@@ -26,7 +30,19 @@ private:
     std::set<std::string> m_vlanReplay;
     std::set<std::string> m_vlanMemberReplay;
     bool replayDone;
-    
+    KernelCfg m_kernelCfg;
+
+    /* Host VLAN member changes of a port, programmed in one go */
+    struct HostVlanMemberUpdate
+    {
+        std::set<uint16_t> removed;
+        std::set<uint16_t> tagged;
+        /* In the order they were set, the last one is the pvid */
+        std::vector<uint16_t> untagged;
+        /* CONFIG_DB VLAN member entries and their VLAN, to publish once programmed */
+        std::vector<std::pair<uint16_t, KeyOpFieldsValuesTuple>> entries;
+    };
+
     void doTask(Consumer &consumer);
     void doVlanTask(Consumer &consumer);
     void doVlanMemberTask(Consumer &consumer);
@@ -37,8 +53,9 @@ private:
     bool setHostVlanAdminState(int vlan_id, const std::string &admin_status);
     bool setHostVlanMtu(int vlan_id, uint32_t mtu);
     bool setHostVlanMac(int vlan_id, const std::string &mac);
-    bool addHostVlanMember(int vlan_id, const std::string &port_alias, const std::string& tagging_mode);
-    bool removeHostVlanMember(int vlan_id, const std::string &port_alias);
+    void applyHostVlanMembers(const std::string &port_alias, const HostVlanMemberUpdate &update);
+    void detachHostVlanMembers(const std::set<std::string> &port_aliases);
+    void publishVlanMember(uint16_t vlan_id, const std::string &port_alias, const KeyOpFieldsValuesTuple &entry);
     bool isMemberStateOk(const std::string &alias);
     bool isVlanStateOk(const std::string &alias);
     bool isVlanMacOk();
@@ -152,6 +152,9 @@ bool VrfMgr::delLink(const string& vrfName)
         return true;
     }
 
+    /* Settings still queued for the VRF must reach it before it goes */
+    m_kernelCfg.flush();
+
     cmd << IP_CMD << " link del " << shellquote(vrfName);
     EXEC_WITH_ERROR_THROW(cmd.str(), res);
 
@@ -193,10 +196,8 @@ bool VrfMgr::setLink(const string& vrfName)
 
     m_vrfTableMap.emplace(vrfName, table);
 
-    cmd.str("");
-    cmd.clear();
-    cmd << IP_CMD << " link set " << shellquote(vrfName) << " up";
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    // ip link set <vrf_name> up, sent at the end of the task
+    m_kernelCfg.setLinkAdminState(vrfName, true);
 
     return true;
 }
@@ -368,6 +369,9 @@ void VrfMgr::doTask(Consumer &consumer)
 
         it = consumer.m_toSync.erase(it);
     }
+
+    /* Bring up all the VRFs of the task in one go */
+    m_kernelCfg.flush();
 }
 
 bool VrfMgr::doVrfEvpnNvoAddTask(const KeyOpFieldsValuesTuple & t)
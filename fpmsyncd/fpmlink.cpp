@@ -1,5 +1,8 @@
 #include <string.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <chrono>
 #include <system_error>
 #include "logger.h"
 #include "netmsg.h"
@@ -9,6 +12,12 @@
 using namespace swss;
 using namespace std;
 
+/*
+ * Max time spent draining the FPM socket in one readData() call, so that
+ * the pipeline is flushed and timers are served during a large burst.
+ */
+#define FPM_DRAIN_BUDGET_MS 100
+
 void netlink_parse_rtattr(struct rtattr **tb, int max, struct rtattr *rta,
         int len)
 {
@@ -112,10 +121,12 @@ bool FpmLink::isRawProcessing(struct nlmsghdr *h)
 }
 
 FpmLink::FpmLink(RouteSync *rsync, unsigned short port) :
-    MSG_BATCH_SIZE(256),
+    MSG_BATCH_SIZE(1024),
     m_bufSize(FPM_MAX_MSG_LEN * MSG_BATCH_SIZE),
     m_messageBuffer(NULL),
-    m_pos(0),
+    m_wrapBuffer(NULL),
+    m_start(0),
+    m_used(0),
     m_connected(false),
     m_server_up(false),
     m_routesync(rsync)
@@ -160,11 +171,13 @@ FpmLink::FpmLink(RouteSync *rsync, unsigned short port) :
 
     m_server_up = true;
     m_messageBuffer = new char[m_bufSize];
+    m_wrapBuffer = new char[FPM_MAX_MSG_LEN];
 }
 
 FpmLink::~FpmLink()
 {
     delete[] m_messageBuffer;
+    delete[] m_wrapBuffer;
     if (m_connected)
         close(m_connection_socket);
     if (m_server_up)
@@ -184,6 +197,14 @@ void FpmLink::accept()
     if (m_connection_socket < 0)
         throw system_error(errno, system_category());
 
+    /* readData() drains the socket until it would block */
+    int flags = fcntl(m_connection_socket, F_GETFL, 0);
+    if (flags < 0 || fcntl(m_connection_socket, F_SETFL, flags | O_NONBLOCK) < 0)
+    {
+        close(m_connection_socket);
+        throw system_error(errno, system_category());
+    }
+
     SWSS_LOG_INFO("New connection accepted from: %s\n", inet_ntoa(client_addr.sin_addr));
 }
 
@@ -192,72 +213,129 @@ int FpmLink::getFd()
     return m_connection_socket;
 }
 
-uint64_t FpmLink::readData()
+/*
+ * Dispatch one complete FPM message to the route syncer
+ */
+void FpmLink::processFpmMessage(RouteSync *rsync, fpm_msg_hdr_t *hdr)
 {
-    fpm_msg_hdr_t *hdr;
-    size_t msg_len;
-    size_t start = 0, left;
-    ssize_t read;
-
-    read = ::read(m_connection_socket, m_messageBuffer + m_pos, m_bufSize - m_pos);
-    if (read == 0)
-        throw FpmConnectionClosedException();
-    if (read < 0)
-        throw system_error(errno, system_category());
-    m_pos+= (uint32_t)read;
+    if (hdr->msg_type != FPM_MSG_TYPE_NETLINK)
+    {
+        return;
+    }
 
-    /* Check for complete messages */
-    while (true)
+    nlmsghdr *nl_hdr = (nlmsghdr *)fpm_msg_data(hdr);
+
+    /*
+     * EVPN Type5 Add Routes need to be process in Raw mode as they contain
+     * RMAC, VLAN and L3VNI information.
+     * Where as all other route will be using rtnl api to extract information
+     * from the netlink msg.
+     */
+    if (isRawProcessing(nl_hdr))
     {
-        hdr = reinterpret_cast<fpm_msg_hdr_t *>(static_cast<void *>(m_messageBuffer + start));
-        left = m_pos - start;
-        if (left < FPM_MSG_HDR_LEN)
-            break;
-        /* fpm_msg_len includes header size */
-        msg_len = fpm_msg_len(hdr);
-        if (left < msg_len)
-            break;
+        /* EVPN Type5 Add route processing */
+        rsync->onMsgRaw(nl_hdr);
+        return;
+    }
 
-        if (!fpm_msg_ok(hdr, left))
+    /* Plain IPv4/IPv6 routes are decoded in place, without a libnl object */
+    if (rsync->onRouteMsgFast(nl_hdr))
+    {
+        return;
+    }
+
+    nl_msg *msg = nlmsg_convert(nl_hdr);
+    if (msg == NULL)
+    {
+        throw system_error(make_error_code(errc::bad_message), "Unable to convert nlmsg");
+    }
+
+    nlmsg_set_proto(msg, NETLINK_ROUTE);
+    NetDispatcher::getInstance().onNetlinkMessage(msg);
+    nlmsg_free(msg);
+}
+
+void FpmLink::processRing()
+{
+    while (m_used >= FPM_MSG_HDR_LEN)
+    {
+        /*
+         * Messages are 4 byte aligned and so is the ring size, hence a header
+         * never wraps.
+         */
+        fpm_msg_hdr_t *hdr = reinterpret_cast<fpm_msg_hdr_t *>(static_cast<void *>(m_messageBuffer + m_start));
+        if (!fpm_msg_hdr_ok(hdr))
             throw system_error(make_error_code(errc::bad_message), "Malformed FPM message received");
 
-        if (hdr->msg_type == FPM_MSG_TYPE_NETLINK)
+        /* fpm_msg_len includes header size */
+        unsigned int msg_len = (unsigned int)fpm_msg_len(hdr);
+        if (m_used < msg_len)
+            break;
+
+        if (m_start + msg_len > m_bufSize)
         {
-            bool isRaw = false;
+            unsigned int head = m_bufSize - m_start;
+            memcpy(m_wrapBuffer, m_messageBuffer + m_start, head);
+            memcpy(m_wrapBuffer + head, m_messageBuffer, msg_len - head);
+            hdr = reinterpret_cast<fpm_msg_hdr_t *>(static_cast<void *>(m_wrapBuffer));
+        }
 
-            nlmsghdr *nl_hdr = (nlmsghdr *)fpm_msg_data(hdr);
+        processFpmMessage(m_routesync, hdr);
 
-            /*
-             * EVPN Type5 Add Routes need to be process in Raw mode as they contain 
-             * RMAC, VLAN and L3VNI information.
-             * Where as all other route will be using rtnl api to extract information 
-             * from the netlink msg.
-           * */
-            isRaw = isRawProcessing(nl_hdr);
+        m_start = (m_start + msg_len) % m_bufSize;
+        m_used -= msg_len;
+    }
 
-            nl_msg *msg = nlmsg_convert(nl_hdr);
-            if (msg == NULL)
-            {
-                throw system_error(make_error_code(errc::bad_message), "Unable to convert nlmsg");
-            }
+    /* Keep the next read contiguous when nothing is pending */
+    if (m_used == 0)
+        m_start = 0;
+}
 
-            nlmsg_set_proto(msg, NETLINK_ROUTE);
+uint64_t FpmLink::readData()
+{
+    auto begin = chrono::steady_clock::now();
 
-            if (isRaw)
-            {
-                /* EVPN Type5 Add route processing */
-                processRawMsg(nl_hdr);
-            }
-            else
+    while (true)
+    {
+        /* Read into the free part of the ring, which may wrap */
+        unsigned int end = (m_start + m_used) % m_bufSize;
+        struct iovec iov[2];
+        int iovcnt = 1;
+
+        iov[0].iov_base = m_messageBuffer + end;
+        if (end >= m_start)
+        {
+            iov[0].iov_len = m_bufSize - end;
+            if (m_start > 0)
             {
-                NetDispatcher::getInstance().onNetlinkMessage(msg);
+                iov[1].iov_base = m_messageBuffer;
+                iov[1].iov_len = m_start;
+                iovcnt = 2;
             }
-            nlmsg_free(msg);
         }
-        start += msg_len;
+        else
+        {
+            iov[0].iov_len = m_start - end;
+        }
+
+        ssize_t read = ::readv(m_connection_socket, iov, iovcnt);
+        if (read == 0)
+            throw FpmConnectionClosedException();
+        if (read < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            throw system_error(errno, system_category());
+        }
+        m_used += (unsigned int)read;
+
+        processRing();
+
+        if (chrono::steady_clock::now() - begin >= chrono::milliseconds(FPM_DRAIN_BUDGET_MS))
+            break;
     }
 
-    memmove(m_messageBuffer, m_messageBuffer + start, m_pos - start);
-    m_pos = m_pos - (uint32_t)start;
     return 0;
 }
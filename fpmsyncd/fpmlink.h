@@ -33,17 +33,26 @@ public:
     {
     };
 
-    bool isRawProcessing(struct nlmsghdr *h);
-    void processRawMsg(struct nlmsghdr *h)
-    {
-        m_routesync->onMsgRaw(h);
-    };
+    static bool isRawProcessing(struct nlmsghdr *h);
+
+    /* Hand one complete FPM message to rsync, also used by fpmreplay */
+    static void processFpmMessage(RouteSync *rsync, fpm_msg_hdr_t *hdr);
 
 private:
+    /* Process all complete messages in the receive ring */
+    void processRing();
+
     RouteSync *m_routesync;
     unsigned int m_bufSize;
+    /*
+     * Receive ring: the unprocessed data is the m_used bytes from m_start,
+     * wrapping at m_bufSize. A message that wraps is reassembled in
+     * m_wrapBuffer, all others are processed in place.
+     */
     char *m_messageBuffer;
-    unsigned int m_pos;
+    char *m_wrapBuffer;
+    unsigned int m_start;
+    unsigned int m_used;
 
     bool m_connected;
     bool m_server_up;
@@ -0,0 +1,265 @@
+#include <getopt.h>
+#include <netinet/in.h>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "logger.h"
+#include "select.h"
+#include "netdispatcher.h"
+#include "fpmsyncd/fpmlink.h"
+#include "fpmsyncd/routesync.h"
+
+using namespace std;
+using namespace swss;
+
+/*
+ * Replay an FPM stream (the raw bytes zebra writes to the FPM socket) through
+ * RouteSync and report the route rate. Routes are written to a scratch
+ * database of the APPL_DB redis instance, never to APPL_DB itself where
+ * orchagent would program them, and the scratch database is flushed after
+ * the replay. The stream is either a
+ * capture file or generated (-g). By default messages are handed to RouteSync
+ * directly, which measures decoding (-s: libnl path for comparison). With -t
+ * a thread stands in for zebra and sends the stream over loopback TCP to an
+ * FpmLink, which measures the whole fpmsyncd ingest path.
+ */
+
+/* Same as the fpmsyncd defaults */
+const size_t ROUTE_BATCH_SIZE = 10000;
+const size_t ROUTE_PIPELINE_SIZE = 10000;
+
+/* Not used by any SONiC database */
+const int DEFAULT_REPLAY_DB_ID = 15;
+
+void usage()
+{
+    cout << "usage: fpmreplay [-s] [-t port] [-d db_id] <-g routes | capture_file>" << endl;
+    cout << "    -s: decode every route through libnl (disable the fast path)" << endl;
+    cout << "    -t port: send the stream over loopback TCP to an FpmLink on port" << endl;
+    cout << "    -g routes: generate IPv4 /24 routes instead of reading a capture" << endl;
+    cout << "    -d db_id: scratch database on the APPL_DB instance, flushed after the replay (default " << DEFAULT_REPLAY_DB_ID << ")" << endl;
+}
+
+/* Append one RTM_NEWROUTE for the index-th /24 from 16.0.0.0 via 10.0.0.1 dev lo, FPM framed */
+static void appendRoute(vector<char> &buf, uint32_t index)
+{
+    char msg[FPM_MAX_MSG_LEN] = {0};
+    fpm_msg_hdr_t *hdr = reinterpret_cast<fpm_msg_hdr_t *>(static_cast<void *>(msg));
+    struct nlmsghdr *h = (struct nlmsghdr *)fpm_msg_data(hdr);
+
+    h->nlmsg_type = RTM_NEWROUTE;
+    h->nlmsg_len = NLMSG_LENGTH(sizeof(struct rtmsg));
+
+    struct rtmsg *rtm = (struct rtmsg *)NLMSG_DATA(h);
+    rtm->rtm_family = AF_INET;
+    rtm->rtm_dst_len = 24;
+    rtm->rtm_type = RTN_UNICAST;
+    rtm->rtm_protocol = RTPROT_BGP;
+
+    uint32_t dst = htonl(((16u + (index >> 16)) << 24) | ((index & 0xffff) << 8));
+    uint32_t gw = htonl((10u << 24) | 1);
+    int oif = 1;
+    const struct { unsigned short type; const void *data; size_t len; } attrs[] = {
+        { RTA_DST, &dst, sizeof(dst) },
+        { RTA_GATEWAY, &gw, sizeof(gw) },
+        { RTA_OIF, &oif, sizeof(oif) },
+    };
+    for (const auto &attr : attrs)
+    {
+        struct rtattr *rta = (struct rtattr *)((char *)h + NLMSG_ALIGN(h->nlmsg_len));
+        rta->rta_type = attr.type;
+        rta->rta_len = (unsigned short)RTA_LENGTH(attr.len);
+        memcpy(RTA_DATA(rta), attr.data, attr.len);
+        h->nlmsg_len = NLMSG_ALIGN(h->nlmsg_len) + RTA_ALIGN(rta->rta_len);
+    }
+
+    size_t len = fpm_msg_align(FPM_MSG_HDR_LEN + h->nlmsg_len);
+    hdr->version = FPM_PROTO_VERSION;
+    hdr->msg_type = FPM_MSG_TYPE_NETLINK;
+    hdr->msg_len = htons((uint16_t)len);
+    buf.insert(buf.end(), msg, msg + len);
+}
+
+/* Stand in for zebra: connect to the FPM port and write the whole stream */
+static void sendStream(const vector<char> &buf, unsigned short port)
+{
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (sock < 0 || connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        cerr << "Failed to connect to FPM port " << port << endl;
+        exit(EXIT_FAILURE);
+    }
+
+    size_t sent = 0;
+    while (sent < buf.size())
+    {
+        ssize_t n = write(sock, buf.data() + sent, buf.size() - sent);
+        if (n < 0)
+        {
+            cerr << "Failed to write to FPM port " << port << endl;
+            exit(EXIT_FAILURE);
+        }
+        sent += (size_t)n;
+    }
+    close(sock);
+}
+
+/* Run the fpmsyncd main loop until the stand-in closes the connection */
+static void receiveStream(RouteSync &sync, RedisPipeline &pipeline, FpmLink &fpm)
+{
+    Select s;
+    s.addSelectable(&fpm);
+
+    try
+    {
+        while (true)
+        {
+            Selectable *temps = NULL;
+            s.select(&temps, sync.getRouteFlushTimeout());
+            if (sync.isRouteFlushDue())
+            {
+                sync.flushRoutes();
+            }
+            pipeline.flush();
+        }
+    }
+    catch (FpmLink::FpmConnectionClosedException &e)
+    {
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bool slowPath = false;
+    unsigned short port = 0;
+    uint32_t routes = 0;
+    int dbId = DEFAULT_REPLAY_DB_ID;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "st:g:d:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 's':
+            slowPath = true;
+            break;
+        case 't':
+            port = (unsigned short)atoi(optarg);
+            break;
+        case 'g':
+            routes = (uint32_t)atoi(optarg);
+            break;
+        case 'd':
+            dbId = atoi(optarg);
+            break;
+        case 'h':
+            usage();
+            return EXIT_SUCCESS;
+        default:
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    vector<char> buf;
+    if (routes)
+    {
+        if (optind != argc)
+        {
+            usage();
+            return EXIT_FAILURE;
+        }
+        for (uint32_t i = 0; i < routes; i++)
+        {
+            appendRoute(buf, i);
+        }
+    }
+    else
+    {
+        if (optind + 1 != argc)
+        {
+            usage();
+            return EXIT_FAILURE;
+        }
+
+        ifstream capture(argv[optind], ios::binary);
+        if (!capture)
+        {
+            cerr << "Failed to open " << argv[optind] << endl;
+            return EXIT_FAILURE;
+        }
+        buf.assign(istreambuf_iterator<char>(capture), istreambuf_iterator<char>());
+    }
+
+    if (dbId < 0 || dbId == SonicDBConfig::getDbId("APPL_DB"))
+    {
+        cerr << "Invalid scratch database " << dbId << endl;
+        return EXIT_FAILURE;
+    }
+
+    DBConnector db(dbId, SonicDBConfig::getDbSock("APPL_DB"), 0);
+    RedisPipeline pipeline(&db, ROUTE_PIPELINE_SIZE);
+    RouteSync sync(&pipeline);
+    sync.setFastRouteDecode(!slowPath);
+    sync.setRouteCoalescing(ROUTE_BATCH_SIZE, 0);
+
+    NetDispatcher::getInstance().registerMessageHandler(RTM_NEWROUTE, &sync);
+    NetDispatcher::getInstance().registerMessageHandler(RTM_DELROUTE, &sync);
+
+    /* Validate the stream, a truncated tail is dropped */
+    uint64_t count = 0;
+    size_t end = 0;
+    while (buf.size() - end >= FPM_MSG_HDR_LEN)
+    {
+        fpm_msg_hdr_t *hdr = reinterpret_cast<fpm_msg_hdr_t *>(static_cast<void *>(buf.data() + end));
+        if (!fpm_msg_ok(hdr, buf.size() - end))
+        {
+            cerr << "Malformed FPM message at offset " << end << endl;
+            break;
+        }
+        end += fpm_msg_len(hdr);
+        count++;
+    }
+    buf.resize(end);
+
+    auto begin = chrono::steady_clock::now();
+
+    if (port)
+    {
+        FpmLink fpm(&sync, port);
+        thread sender(sendStream, cref(buf), port);
+        fpm.accept();
+        receiveStream(sync, pipeline, fpm);
+        sender.join();
+    }
+    else
+    {
+        for (size_t start = 0; start < buf.size(); )
+        {
+            fpm_msg_hdr_t *hdr = reinterpret_cast<fpm_msg_hdr_t *>(static_cast<void *>(buf.data() + start));
+            FpmLink::processFpmMessage(&sync, hdr);
+            start += fpm_msg_len(hdr);
+        }
+    }
+    sync.flushRoutes();
+    pipeline.flush();
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - begin;
+
+    /* Remove the replayed routes */
+    db.flushdb();
+    cout << count << " messages in " << elapsed.count() << " s ("
+         << (elapsed.count() > 0 ? (double)count / elapsed.count() : 0) << " routes/s, "
+         << (slowPath ? "libnl" : "fast") << " decode" << (port ? ", tcp" : "") << "), "
+         << sync.getSuppressedRouteCount() << " route updates suppressed" << endl;
+
+    return EXIT_SUCCESS;
+}
@@ -1,3 +1,4 @@
+#include <getopt.h>
 #include <iostream>
 #include <inttypes.h>
 #include "logger.h"
@@ -23,6 +24,30 @@ const uint32_t DEFAULT_ROUTING_RESTART_INTERVAL = 120;
 // TODO: support eoiu hold interval config
 const uint32_t DEFAULT_EOIU_HOLD_INTERVAL = 3;
 
+/*
+ * Route updates are coalesced per prefix before being written to APPL_DB.
+ * With the default window of 0 ms, updates received in one read from the FPM
+ * socket are coalesced and published right after it.
+ */
+const size_t DEFAULT_ROUTE_BATCH_SIZE = 10000;
+const uint32_t DEFAULT_ROUTE_WINDOW_MS = 0;
+
+/*
+ * FpmLink drains the socket on every wakeup and the pipeline is flushed once
+ * per wakeup, so let it hold a whole batch rather than flushing every 128
+ * commands.
+ */
+const size_t ROUTE_PIPELINE_SIZE = 10000;
+
+void usage()
+{
+    cout << "usage: fpmsyncd [-b batch_size] [-w window_ms]" << endl;
+    cout << "    -b batch_size: max prefixes coalesced before writing to APPL_DB (default "
+         << DEFAULT_ROUTE_BATCH_SIZE << ")" << endl;
+    cout << "    -w window_ms: time to coalesce route updates before writing to APPL_DB (default "
+         << DEFAULT_ROUTE_WINDOW_MS << ")" << endl;
+}
+
 // Check if eoiu state reached by both ipv4 and ipv6
 static bool eoiuFlagsSet(Table &bgpStateTable)
 {
@@ -46,10 +71,34 @@ static bool eoiuFlagsSet(Table &bgpStateTable)
 
 int main(int argc, char **argv)
 {
+    size_t batchSize = DEFAULT_ROUTE_BATCH_SIZE;
+    uint32_t windowMs = DEFAULT_ROUTE_WINDOW_MS;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:w:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'b':
+            batchSize = (size_t)atoi(optarg);
+            break;
+        case 'w':
+            windowMs = (uint32_t)atoi(optarg);
+            break;
+        case 'h':
+            usage();
+            return 0;
+        default:
+            usage();
+            return 1;
+        }
+    }
+
     swss::Logger::linkToDbNative("fpmsyncd");
     DBConnector db("APPL_DB", 0);
-    RedisPipeline pipeline(&db);
+    RedisPipeline pipeline(&db, ROUTE_PIPELINE_SIZE);
     RouteSync sync(&pipeline);
+    sync.setRouteCoalescing(batchSize, windowMs);
 
     DBConnector stateDb("STATE_DB", 0);
     Table bgpStateTable(&stateDb, STATE_BGP_TABLE_NAME);
@@ -117,10 +166,18 @@ int main(int argc, char **argv)
 
             while (true)
             {
-                Selectable *temps;
+                Selectable *temps = NULL;
 
-                /* Reading FPM messages forever (and calling "readMe" to read them) */
-                s.select(&temps);
+                /*
+                 * Reading FPM messages forever (and calling "readMe" to read them),
+                 * waking up when coalesced route updates are due.
+                 */
+                s.select(&temps, sync.getRouteFlushTimeout());
+
+                if (sync.isRouteFlushDue())
+                {
+                    sync.flushRoutes();
+                }
 
                 /*
                  * Upon expiration of the warm-restart timer or eoiu Hold Timer, proceed to run the
@@ -192,6 +249,9 @@ int main(int argc, char **argv)
         catch (FpmLink::FpmConnectionClosedException &e)
         {
             cout << "Connection lost, reconnecting..." << endl;
+            /* Don't hold coalesced updates back until zebra reconnects */
+            sync.flushRoutes();
+            pipeline.flush();
         }
         catch (const exception& e)
         {
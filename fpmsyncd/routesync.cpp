@@ -50,7 +50,8 @@ RouteSync::RouteSync(RedisPipeline *pipeline) :
     m_vnet_routeTable(pipeline, APP_VNET_RT_TABLE_NAME, true),
     m_vnet_tunnelTable(pipeline, APP_VNET_RT_TUNNEL_TABLE_NAME, true),
     m_warmStartHelper(pipeline, &m_routeTable, APP_ROUTE_TABLE_NAME, "bgp", "bgp"),
-    m_nl_sock(NULL), m_link_cache(NULL)
+    m_nl_sock(NULL), m_link_cache(NULL), m_fastRouteDecode(true),
+    m_maxPendingRoutes(0), m_routeWindowMs(0), m_suppressedRoutes(0)
 {
     m_nl_sock = nl_socket_alloc();
     nl_connect(m_nl_sock, NETLINK_ROUTE);
@@ -447,23 +448,8 @@ void RouteSync::onEvpnRouteMsg(struct nlmsghdr *h, int len)
 
     if (nlmsg_type == RTM_DELROUTE)
     {
-        if (!warmRestartInProgress)
-        {
-            m_routeTable.del(destipprefix);
-            return;
-        }
-        else
-        {
-            SWSS_LOG_INFO("Warm-Restart mode: Receiving delete msg: %s",
-                          destipprefix);
-
-            vector<FieldValueTuple> fvVector;
-            const KeyOpFieldsValuesTuple kfv = std::make_tuple(destipprefix,
-                                                               DEL_COMMAND,
-                                                               fvVector);
-            m_warmStartHelper.insertRefreshMap(kfv);
-            return;
-        }
+        delRoute(destipprefix);
+        return;
     }
     else if (nlmsg_type != RTM_NEWROUTE)
     {
@@ -526,7 +512,7 @@ void RouteSync::onEvpnRouteMsg(struct nlmsghdr *h, int len)
 
     if (!warmRestartInProgress)
     {
-        m_routeTable.set(destipprefix, fvVector);
+        queueRoute(destipprefix, false, fvVector);
         SWSS_LOG_DEBUG("RouteTable set msg: %s vtep:%s vni:%s mac:%s intf:%s",
                        destipprefix, nexthops.c_str(), vni_list.c_str(), mac_list.c_str(), intf_list.c_str());
     }
@@ -658,27 +644,10 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
      * Upon arrival of a delete msg we could either push the change right away,
      * or we could opt to defer it if we are going through a warm-reboot cycle.
      */
-    bool warmRestartInProgress = m_warmStartHelper.inProgress();
-
     if (nlmsg_type == RTM_DELROUTE)
     {
-        if (!warmRestartInProgress)
-        {
-            m_routeTable.del(destipprefix);
-            return;
-        }
-        else
-        {
-            SWSS_LOG_INFO("Warm-Restart mode: Receiving delete msg: %s",
-                          destipprefix);
-
-            vector<FieldValueTuple> fvVector;
-            const KeyOpFieldsValuesTuple kfv = std::make_tuple(destipprefix,
-                                                               DEL_COMMAND,
-                                                               fvVector);
-            m_warmStartHelper.insertRefreshMap(kfv);
-            return;
-        }
+        delRoute(destipprefix);
+        return;
     }
     else if (nlmsg_type != RTM_NEWROUTE)
     {
@@ -689,13 +658,9 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
     switch (rtnl_route_get_type(route_obj))
     {
         case RTN_BLACKHOLE:
-        {
-            vector<FieldValueTuple> fvVector;
-            FieldValueTuple fv("blackhole", "true");
-            fvVector.push_back(fv);
-            m_routeTable.set(destipprefix, fvVector);
+            setBlackholeRoute(destipprefix);
             return;
-        }
+
         case RTN_UNICAST:
             break;
 
@@ -723,21 +688,73 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
     getNextHopList(route_obj, gw_list, mpls_list, intf_list);
     string weights = getNextHopWt(route_obj);
 
-    vector<string> alsv = tokenize(intf_list, NHG_DELIMITER);
-    for (auto alias : alsv)
+    setRoute(destipprefix, gw_list, intf_list, mpls_list, weights);
+}
+
+/*
+ * Check if any of the comma separated interfaces is eth0 or docker0
+ */
+static bool hasMgmtNextHopIntf(const string &intf_list)
+{
+    size_t start = 0;
+    while (start < intf_list.size())
     {
-        /*
-         * An FRR behavior change from 7.2 to 7.5 makes FRR update default route to eth0 in interface
-         * up/down events. Skipping routes to eth0 or docker0 to avoid such behavior
-         */
-        if (alias == "eth0" || alias == "docker0")
+        size_t end = intf_list.find(NHG_DELIMITER, start);
+        if (end == string::npos)
         {
-            SWSS_LOG_DEBUG("Skip routes to eth0 or docker0: %s %s %s",
-                    destipprefix, gw_list.c_str(), intf_list.c_str());
-            return;
+            end = intf_list.size();
         }
+
+        size_t n = end - start;
+        if ((n == 4 && !intf_list.compare(start, n, "eth0")) ||
+            (n == 7 && !intf_list.compare(start, n, "docker0")))
+        {
+            return true;
+        }
+        start = end + 1;
+    }
+    return false;
+}
+
+void RouteSync::delRoute(const char *destipprefix)
+{
+    /*
+     * Upon arrival of a delete msg we could either push the change right away,
+     * or we could opt to defer it if we are going through a warm-reboot cycle.
+     */
+    if (!m_warmStartHelper.inProgress())
+    {
+        vector<FieldValueTuple> fvVector;
+        queueRoute(destipprefix, true, fvVector);
+        return;
+    }
+
+    SWSS_LOG_INFO("Warm-Restart mode: Receiving delete msg: %s",
+                  destipprefix);
+
+    vector<FieldValueTuple> fvVector;
+    const KeyOpFieldsValuesTuple kfv = std::make_tuple(destipprefix,
+                                                       DEL_COMMAND,
+                                                       fvVector);
+    m_warmStartHelper.insertRefreshMap(kfv);
+}
+
+void RouteSync::setRoute(const char *destipprefix, const string &gw_list, const string &intf_list,
+                         const string &mpls_list, const string &weights)
+{
+    /*
+     * An FRR behavior change from 7.2 to 7.5 makes FRR update default route to eth0 in interface
+     * up/down events. Skipping routes to eth0 or docker0 to avoid such behavior
+     */
+    if (hasMgmtNextHopIntf(intf_list))
+    {
+        SWSS_LOG_DEBUG("Skip routes to eth0 or docker0: %s %s %s",
+                destipprefix, gw_list.c_str(), intf_list.c_str());
+        return;
     }
 
+    bool warmRestartInProgress = m_warmStartHelper.inProgress();
+
     vector<FieldValueTuple> fvVector;
     FieldValueTuple gw("nexthop", gw_list);
     FieldValueTuple intf("ifname", intf_list);
@@ -757,7 +774,7 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
 
     if (!warmRestartInProgress)
     {
-        m_routeTable.set(destipprefix, fvVector);
+        queueRoute(destipprefix, false, fvVector);
         SWSS_LOG_DEBUG("RouteTable set msg: %s %s %s %s", destipprefix,
                        gw_list.c_str(), intf_list.c_str(), mpls_list.c_str());
     }
@@ -778,6 +795,371 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
     }
 }
 
+void RouteSync::setBlackholeRoute(const char *destipprefix)
+{
+    vector<FieldValueTuple> fvVector;
+    FieldValueTuple fv("blackhole", "true");
+    fvVector.push_back(fv);
+
+    /*
+     * Held by warm-reboot logic like any other route update, as reconciliation
+     * removes the AppDB entries it was not refreshed with.
+     */
+    if (m_warmStartHelper.inProgress())
+    {
+        const KeyOpFieldsValuesTuple kfv = std::make_tuple(destipprefix,
+                                                           SET_COMMAND,
+                                                           fvVector);
+        m_warmStartHelper.insertRefreshMap(kfv);
+        return;
+    }
+
+    queueRoute(destipprefix, false, fvVector);
+}
+
+void RouteSync::queueRoute(const string &key, bool del, vector<FieldValueTuple> &fvVector)
+{
+    auto it = m_pendingRoutes.find(key);
+    if (it != m_pendingRoutes.end())
+    {
+        /* The update still queued for this prefix is superseded */
+        m_suppressedRoutes++;
+        it->second.del = del;
+        it->second.fvVector.swap(fvVector);
+    }
+    else
+    {
+        if (m_pendingRoutes.empty())
+        {
+            m_pendingSince = chrono::steady_clock::now();
+        }
+        m_pendingRoutes.emplace(key, PendingRoute{del, std::move(fvVector)});
+    }
+
+    if (m_maxPendingRoutes && m_pendingRoutes.size() >= m_maxPendingRoutes)
+    {
+        flushRoutes();
+    }
+}
+
+int RouteSync::getRouteFlushTimeout() const
+{
+    if (m_pendingRoutes.empty())
+    {
+        return -1;
+    }
+
+    int64_t elapsed = chrono::duration_cast<chrono::milliseconds>(
+            chrono::steady_clock::now() - m_pendingSince).count();
+    int64_t window = m_routeWindowMs;
+    if (elapsed >= window)
+    {
+        return 0;
+    }
+    return (int)(window - elapsed);
+}
+
+/* 64-bit FNV-1a over the field/value pairs, in order */
+static uint64_t hashFields(const vector<FieldValueTuple> &fvVector)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const string &s)
+    {
+        /* Include the terminator so that "ab","c" and "a","bc" differ */
+        for (size_t i = 0; i <= s.size(); i++)
+        {
+            hash ^= (unsigned char)s.c_str()[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    for (const auto &fv : fvVector)
+    {
+        mix(fvField(fv));
+        mix(fvValue(fv));
+    }
+    return hash;
+}
+
+void RouteSync::flushRoutes()
+{
+    size_t published = 0;
+    uint64_t suppressed = m_suppressedRoutes;
+
+    for (auto &it : m_pendingRoutes)
+    {
+        const string &key = it.first;
+        PendingRoute &route = it.second;
+
+        if (route.del)
+        {
+            /* The prefix may be in APPL_DB from before we started, always delete */
+            m_publishedRoutes.erase(key);
+            m_routeTable.del(key);
+            published++;
+            continue;
+        }
+
+        uint64_t fields = hashFields(route.fvVector);
+        auto pub = m_publishedRoutes.find(key);
+        if (pub != m_publishedRoutes.end() && pub->second == fields)
+        {
+            m_suppressedRoutes++;
+            continue;
+        }
+
+        m_routeTable.set(key, route.fvVector);
+        m_publishedRoutes[key] = fields;
+        published++;
+    }
+    m_pendingRoutes.clear();
+
+    SWSS_LOG_INFO("Flushed %zu routes, %" PRIu64 " updates suppressed (%" PRIu64 " total)",
+                  published, m_suppressedRoutes - suppressed, m_suppressedRoutes);
+}
+
+/*
+ * Append one next hop to m_gwList and m_intfList
+ * @arg family        Route address family
+ * @arg gw            RTA_GATEWAY attribute, or NULL for a directly connected next hop
+ * @arg if_index      Next hop interface index
+ *
+ * Return false if the gateway cannot be decoded.
+ */
+bool RouteSync::appendNextHop(unsigned char family, struct rtattr *gw, int if_index)
+{
+    if (!m_intfList.empty())
+    {
+        m_gwList += NHG_DELIMITER;
+        m_intfList += NHG_DELIMITER;
+    }
+
+    if (gw)
+    {
+        char gwaddr[INET6_ADDRSTRLEN];
+        size_t addr_len = (family == AF_INET) ? IPV4_MAX_BYTE : IPV6_MAX_BYTE;
+        if (RTA_PAYLOAD(gw) != addr_len ||
+            !inet_ntop(family, RTA_DATA(gw), gwaddr, sizeof(gwaddr)))
+        {
+            return false;
+        }
+        m_gwList += gwaddr;
+    }
+    else
+    {
+        m_gwList += (family == AF_INET6) ? "::" : "0.0.0.0";
+    }
+
+    char if_name[IFNAMSIZ];
+    if (getIfName(if_index, if_name, IFNAMSIZ))
+    {
+        m_intfList += if_name;
+    }
+    /* If we cannot get the interface name */
+    else
+    {
+        m_intfList += "unknown";
+    }
+
+    return true;
+}
+
+/*
+ * Handle regular route (include VRF route) straight from the netlink message.
+ * Produces the same APPL_DB entry as onMsg/onRouteMsg without building a libnl
+ * route object. Messages this decoder does not cover (MPLS, VNET, encap,
+ * RTA_VIA, ...) are left to the libnl path.
+ * @arg h               Netlink message header
+ *
+ * Return true if the message was handled.
+ */
+bool RouteSync::onRouteMsgFast(struct nlmsghdr *h)
+{
+    if (!m_fastRouteDecode)
+    {
+        return false;
+    }
+
+    if ((h->nlmsg_type != RTM_NEWROUTE)
+        && (h->nlmsg_type != RTM_DELROUTE))
+    {
+        return false;
+    }
+
+    int len = (int)(h->nlmsg_len - NLMSG_LENGTH(sizeof(struct rtmsg)));
+    if (len < 0)
+    {
+        return false;
+    }
+
+    struct rtmsg *rtm = (struct rtmsg *)NLMSG_DATA(h);
+    size_t addr_len;
+    if (rtm->rtm_family == AF_INET)
+    {
+        addr_len = IPV4_MAX_BYTE;
+    }
+    else if (rtm->rtm_family == AF_INET6)
+    {
+        addr_len = IPV6_MAX_BYTE;
+    }
+    else
+    {
+        return false;
+    }
+
+    struct rtattr *tb[RTA_MAX + 1];
+    memset(tb, 0, sizeof(tb));
+    netlink_parse_rtattr(tb, RTA_MAX, RTM_RTA(rtm), len);
+
+    if (!tb[RTA_DST] || RTA_PAYLOAD(tb[RTA_DST]) != addr_len ||
+        rtm->rtm_dst_len > addr_len * 8)
+    {
+        return false;
+    }
+    if (tb[RTA_VIA] || tb[RTA_NEWDST] || tb[RTA_ENCAP] || tb[RTA_ENCAP_TYPE])
+    {
+        return false;
+    }
+
+    char destipprefix[IFNAMSIZ + MAX_ADDR_SIZE + 2] = {0};
+    size_t pos = 0;
+
+    /* Table corresponding to route, if set the route is for a VRF */
+    unsigned int vrf_index = rtm->rtm_table;
+    if (tb[RTA_TABLE])
+    {
+        if (RTA_PAYLOAD(tb[RTA_TABLE]) < sizeof(uint32_t))
+        {
+            return false;
+        }
+        vrf_index = *(uint32_t *)RTA_DATA(tb[RTA_TABLE]);
+    }
+    if (vrf_index)
+    {
+        /* VNET, mgmt and invalid VRF names are handled by onMsg */
+        if (!getIfName(vrf_index, destipprefix, IFNAMSIZ) ||
+            memcmp(destipprefix, VRF_PREFIX, strlen(VRF_PREFIX)))
+        {
+            return false;
+        }
+        pos = strlen(destipprefix);
+        destipprefix[pos++] = ':';
+    }
+
+    if (!inet_ntop(rtm->rtm_family, RTA_DATA(tb[RTA_DST]), destipprefix + pos,
+                   (socklen_t)(sizeof(destipprefix) - pos)))
+    {
+        return false;
+    }
+    /* Same format as nl_addr2str, the prefix length is omitted for host routes */
+    if (rtm->rtm_dst_len != addr_len * 8)
+    {
+        pos = strlen(destipprefix);
+        snprintf(destipprefix + pos, sizeof(destipprefix) - pos, "/%u", rtm->rtm_dst_len);
+    }
+
+    if (h->nlmsg_type == RTM_DELROUTE)
+    {
+        delRoute(destipprefix);
+        return true;
+    }
+
+    switch (rtm->rtm_type)
+    {
+        case RTN_BLACKHOLE:
+            setBlackholeRoute(destipprefix);
+            return true;
+
+        case RTN_UNICAST:
+            break;
+
+        case RTN_MULTICAST:
+        case RTN_BROADCAST:
+        case RTN_LOCAL:
+            SWSS_LOG_INFO("BUM routes aren't supported yet (%s)", destipprefix);
+            return true;
+
+        default:
+            return true;
+    }
+
+    m_gwList.clear();
+    m_intfList.clear();
+    m_weights.clear();
+
+    if (tb[RTA_MULTIPATH])
+    {
+        if (tb[RTA_GATEWAY] || tb[RTA_OIF])
+        {
+            return false;
+        }
+
+        struct rtnexthop *rtnh = (struct rtnexthop *)RTA_DATA(tb[RTA_MULTIPATH]);
+        int mp_len = (int)RTA_PAYLOAD(tb[RTA_MULTIPATH]);
+        bool weighted = true;
+
+        while (mp_len >= (int)sizeof(*rtnh) && rtnh->rtnh_len >= sizeof(*rtnh) &&
+               (int)rtnh->rtnh_len <= mp_len)
+        {
+            struct rtattr *subtb[RTA_MAX + 1];
+            memset(subtb, 0, sizeof(subtb));
+            netlink_parse_rtattr(subtb, RTA_MAX, RTNH_DATA(rtnh),
+                                 (int)(rtnh->rtnh_len - sizeof(*rtnh)));
+
+            if (subtb[RTA_VIA] || subtb[RTA_NEWDST] || subtb[RTA_ENCAP] || subtb[RTA_ENCAP_TYPE])
+            {
+                return false;
+            }
+            if (!appendNextHop(rtm->rtm_family, subtb[RTA_GATEWAY], rtnh->rtnh_ifindex))
+            {
+                return false;
+            }
+
+            /* Weights are only published if every next hop has one */
+            if (weighted && rtnh->rtnh_hops)
+            {
+                if (!m_weights.empty())
+                {
+                    m_weights += NHG_DELIMITER;
+                }
+                m_weights += to_string(rtnh->rtnh_hops + 1);
+            }
+            else
+            {
+                weighted = false;
+                m_weights.clear();
+            }
+
+            mp_len -= (int)NLMSG_ALIGN(rtnh->rtnh_len);
+            rtnh = RTNH_NEXT(rtnh);
+        }
+
+        if (m_intfList.empty())
+        {
+            return false;
+        }
+    }
+    else if (tb[RTA_GATEWAY] || tb[RTA_OIF])
+    {
+        if (tb[RTA_OIF] && RTA_PAYLOAD(tb[RTA_OIF]) < sizeof(int))
+        {
+            return false;
+        }
+        int if_index = tb[RTA_OIF] ? *(int *)RTA_DATA(tb[RTA_OIF]) : 0;
+        if (!appendNextHop(rtm->rtm_family, tb[RTA_GATEWAY], if_index))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    setRoute(destipprefix, m_gwList, m_intfList, "", m_weights);
+    return true;
+}
+
 /* 
  * Handle label route
  * @arg nlmsg_type      Netlink message type
@@ -26,6 +26,47 @@ public:
     virtual void onMsg(int nlmsg_type, struct nl_object *obj);
 
     virtual void onMsgRaw(struct nlmsghdr *obj);
+
+    /*
+     * Decode a regular IPv4/IPv6 route in place, without a libnl object.
+     * Returns false if the message needs the libnl path (onMsg).
+     */
+    bool onRouteMsgFast(struct nlmsghdr *h);
+
+    void setFastRouteDecode(bool enable)
+    {
+        m_fastRouteDecode = enable;
+    }
+
+    /*
+     * Regular route updates are coalesced per prefix: only the latest state of
+     * a prefix is kept until flushRoutes() publishes the batch to APPL_DB. The
+     * batch is due once maxPending prefixes are queued or windowMs after the
+     * first queued update (0: as soon as the caller checks).
+     */
+    void setRouteCoalescing(size_t maxPending, uint32_t windowMs)
+    {
+        m_maxPendingRoutes = maxPending;
+        m_routeWindowMs = windowMs;
+    }
+
+    /* Milliseconds until the pending routes are due, -1 if there are none */
+    int getRouteFlushTimeout() const;
+
+    bool isRouteFlushDue() const
+    {
+        return getRouteFlushTimeout() == 0;
+    }
+
+    /* Publish the pending routes, skipping those equal to the published state */
+    void flushRoutes();
+
+    /* Route updates never written to APPL_DB, either superseded or unchanged */
+    uint64_t getSuppressedRouteCount() const
+    {
+        return m_suppressedRoutes;
+    }
+
     WarmStartHelper  m_warmStartHelper;
 
 private:
@@ -40,9 +81,41 @@ private:
     struct nl_cache    *m_link_cache;
     struct nl_sock     *m_nl_sock;
 
+    bool                m_fastRouteDecode;
+    /* Next hop lists reused across messages by onRouteMsgFast */
+    string              m_gwList;
+    string              m_intfList;
+    string              m_weights;
+
     /* Handle regular route (include VRF route) */
     void onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf);
 
+    struct PendingRoute
+    {
+        bool                    del;
+        vector<FieldValueTuple> fvVector;
+    };
+
+    /* Latest state of each prefix not yet flushed */
+    unordered_map<string, PendingRoute> m_pendingRoutes;
+    /* Hash of the fields last published per prefix */
+    unordered_map<string, uint64_t> m_publishedRoutes;
+    chrono::steady_clock::time_point m_pendingSince;
+    size_t              m_maxPendingRoutes;
+    uint32_t            m_routeWindowMs;
+    uint64_t            m_suppressedRoutes;
+
+    void queueRoute(const string &key, bool del, vector<FieldValueTuple> &fvVector);
+
+    /* Publish a regular route delete or update, shared by both decode paths */
+    void delRoute(const char *destipprefix);
+    void setRoute(const char *destipprefix, const string &gw_list, const string &intf_list,
+                  const string &mpls_list, const string &weights);
+    void setBlackholeRoute(const char *destipprefix);
+
+    /* Append one next hop to m_gwList and m_intfList */
+    bool appendNextHop(unsigned char family, struct rtattr *gw, int if_index);
+
     /* Handle label route */
     void onLabelRouteMsg(int nlmsg_type, struct nl_object *obj);
 
@@ -0,0 +1,476 @@
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <net/if.h>
+#include <net/ethernet.h>
+#include <sys/socket.h>
+#include <linux/if_bridge.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <netlink/netlink.h>
+#include <netlink/msg.h>
+#include <netlink/attr.h>
+#include <netlink/socket.h>
+
+#include "logger.h"
+#include "kernelcfg.h"
+
+#ifndef SOL_NETLINK
+#define SOL_NETLINK 270
+#endif
+
+#define BRIDGE_VLAN_ID_MAX 4094
+
+#ifndef NETLINK_CAP_ACK
+#define NETLINK_CAP_ACK 10
+#endif
+
+using namespace std;
+using namespace swss;
+
+KernelCfg::KernelCfg() :
+    m_seq(1)
+{
+    m_sock = nl_socket_alloc();
+    if (!m_sock)
+    {
+        throw runtime_error("Unable to allocate netlink socket");
+    }
+
+    int err = nl_connect(m_sock, NETLINK_ROUTE);
+    if (err < 0)
+    {
+        nl_socket_free(m_sock);
+        throw runtime_error(string("Unable to connect netlink socket: ") + nl_geterror(err));
+    }
+
+    /* Only the header of a failed request is needed back in its error */
+    int one = 1;
+    setsockopt(nl_socket_get_fd(m_sock), SOL_NETLINK, NETLINK_CAP_ACK, &one, sizeof(one));
+}
+
+KernelCfg::~KernelCfg()
+{
+    for (auto &request : m_requests)
+    {
+        nlmsg_free(request.msg);
+    }
+    nl_socket_free(m_sock);
+}
+
+struct nl_msg *KernelCfg::newLinkMsg(const string &ifname, int type, int family, uint32_t index)
+{
+    struct ifinfomsg ifi;
+    memset(&ifi, 0, sizeof(ifi));
+    ifi.ifi_family = (unsigned char)family;
+    ifi.ifi_index = (int)index;
+
+    struct nl_msg *msg = nlmsg_alloc_simple(type, 0);
+    if (!msg || nlmsg_append(msg, &ifi, sizeof(ifi), NLMSG_ALIGNTO) < 0)
+    {
+        throw bad_alloc();
+    }
+
+    /* Without an index the kernel looks the link up by name */
+    if (!index)
+    {
+        nla_put_string(msg, IFLA_IFNAME, ifname.c_str());
+    }
+    return msg;
+}
+
+void KernelCfg::queue(struct nl_msg *msg, string &&desc)
+{
+    m_requests.push_back(Request{msg, 0, std::move(desc)});
+}
+
+void KernelCfg::queueError(int err, string &&desc)
+{
+    m_requests.push_back(Request{NULL, err, std::move(desc)});
+}
+
+void KernelCfg::setLinkAdminState(const string &ifname, bool up)
+{
+    struct nl_msg *msg = newLinkMsg(ifname, RTM_NEWLINK, AF_UNSPEC, 0);
+    struct ifinfomsg *ifi = (struct ifinfomsg *)nlmsg_data(nlmsg_hdr(msg));
+
+    ifi->ifi_flags = up ? IFF_UP : 0;
+    ifi->ifi_change = IFF_UP;
+    queue(msg, "ip link set " + ifname + (up ? " up" : " down"));
+}
+
+void KernelCfg::setLinkAdminState(const string &ifname, const string &admin_status)
+{
+    if (admin_status != "up" && admin_status != "down")
+    {
+        queueError(-EINVAL, "ip link set " + ifname + " " + admin_status);
+        return;
+    }
+    setLinkAdminState(ifname, admin_status == "up");
+}
+
+void KernelCfg::setLinkMtu(const string &ifname, uint32_t mtu)
+{
+    struct nl_msg *msg = newLinkMsg(ifname, RTM_NEWLINK, AF_UNSPEC, 0);
+
+    nla_put_u32(msg, IFLA_MTU, mtu);
+    queue(msg, "ip link set " + ifname + " mtu " + to_string(mtu));
+}
+
+void KernelCfg::setLinkMtu(const string &ifname, const string &mtu)
+{
+    size_t end = 0;
+    unsigned long value = 0;
+
+    try
+    {
+        value = stoul(mtu, &end);
+    }
+    catch (const logic_error &)
+    {
+    }
+
+    if (mtu.empty() || end != mtu.size() || !value || value > UINT32_MAX)
+    {
+        queueError(-EINVAL, "ip link set " + ifname + " mtu " + mtu);
+        return;
+    }
+    setLinkMtu(ifname, (uint32_t)value);
+}
+
+void KernelCfg::setLinkMac(const string &ifname, const MacAddress &mac)
+{
+    struct nl_msg *msg = newLinkMsg(ifname, RTM_NEWLINK, AF_UNSPEC, 0);
+
+    nla_put(msg, IFLA_ADDRESS, ETHER_ADDR_LEN, mac.getMac());
+    queue(msg, "ip link set " + ifname + " address " + mac.to_string());
+}
+
+void KernelCfg::setLinkMaster(const string &ifname, const string &master)
+{
+    string desc = "ip link set " + ifname + (master.empty() ? " nomaster" : " master " + master);
+    uint32_t masterIndex = 0;
+
+    if (!master.empty())
+    {
+        masterIndex = if_nametoindex(master.c_str());
+        if (!masterIndex)
+        {
+            queueError(-ENODEV, std::move(desc));
+            return;
+        }
+    }
+
+    struct nl_msg *msg = newLinkMsg(ifname, RTM_NEWLINK, AF_UNSPEC, 0);
+    nla_put_u32(msg, IFLA_MASTER, masterIndex);
+    queue(msg, std::move(desc));
+}
+
+void KernelCfg::addAddress(const string &ifname, const IpPrefix &prefix, bool broadcast, uint32_t metric)
+{
+    string desc = "ip address add " + prefix.to_string() + " dev " + ifname;
+    uint32_t index = if_nametoindex(ifname.c_str());
+
+    if (!index)
+    {
+        queueError(-ENODEV, std::move(desc));
+        return;
+    }
+
+    struct ifaddrmsg ifa;
+    memset(&ifa, 0, sizeof(ifa));
+    ifa.ifa_family = prefix.isV4() ? AF_INET : AF_INET6;
+    ifa.ifa_prefixlen = (unsigned char)prefix.getMaskLength();
+    ifa.ifa_index = index;
+
+    struct nl_msg *msg = nlmsg_alloc_simple(RTM_NEWADDR, NLM_F_CREATE | NLM_F_EXCL);
+    if (!msg || nlmsg_append(msg, &ifa, sizeof(ifa), NLMSG_ALIGNTO) < 0)
+    {
+        throw bad_alloc();
+    }
+
+    ip_addr_t addr = prefix.getIp().getIp();
+    int len = prefix.isV4() ? 4 : 16;
+    nla_put(msg, IFA_LOCAL, len, &addr.ip_addr);
+    nla_put(msg, IFA_ADDRESS, len, &addr.ip_addr);
+
+    if (broadcast && prefix.isV4())
+    {
+        ip_addr_t brd = prefix.getBroadcastIp().getIp();
+        nla_put(msg, IFA_BROADCAST, len, &brd.ip_addr);
+    }
+    if (metric)
+    {
+        nla_put_u32(msg, IFA_RT_PRIORITY, metric);
+    }
+    queue(msg, std::move(desc));
+}
+
+void KernelCfg::delAddress(const string &ifname, const IpPrefix &prefix)
+{
+    string desc = "ip address del " + prefix.to_string() + " dev " + ifname;
+    uint32_t index = if_nametoindex(ifname.c_str());
+
+    if (!index)
+    {
+        queueError(-ENODEV, std::move(desc));
+        return;
+    }
+
+    struct ifaddrmsg ifa;
+    memset(&ifa, 0, sizeof(ifa));
+    ifa.ifa_family = prefix.isV4() ? AF_INET : AF_INET6;
+    ifa.ifa_prefixlen = (unsigned char)prefix.getMaskLength();
+    ifa.ifa_index = index;
+
+    struct nl_msg *msg = nlmsg_alloc_simple(RTM_DELADDR, 0);
+    if (!msg || nlmsg_append(msg, &ifa, sizeof(ifa), NLMSG_ALIGNTO) < 0)
+    {
+        throw bad_alloc();
+    }
+
+    ip_addr_t addr = prefix.getIp().getIp();
+    nla_put(msg, IFA_LOCAL, prefix.isV4() ? 4 : 16, &addr.ip_addr);
+    queue(msg, std::move(desc));
+}
+
+void KernelCfg::queueBridgeVlan(int type, const string &ifname, uint16_t begin, uint16_t end,
+                                uint16_t flags, bool self, string &&desc)
+{
+    uint32_t index = if_nametoindex(ifname.c_str());
+
+    if (!index)
+    {
+        queueError(-ENODEV, std::move(desc));
+        return;
+    }
+    if (!begin || begin > end || end > BRIDGE_VLAN_ID_MAX)
+    {
+        queueError(-EINVAL, std::move(desc));
+        return;
+    }
+
+    struct bridge_vlan_info vinfo;
+    memset(&vinfo, 0, sizeof(vinfo));
+
+    struct nl_msg *msg = newLinkMsg(ifname, type, AF_BRIDGE, index);
+    struct nlattr *afspec = nla_nest_start(msg, IFLA_AF_SPEC);
+    if (self)
+    {
+        nla_put_u16(msg, IFLA_BRIDGE_FLAGS, BRIDGE_FLAGS_SELF);
+    }
+    if (begin == end)
+    {
+        vinfo.vid = begin;
+        vinfo.flags = flags;
+        nla_put(msg, IFLA_BRIDGE_VLAN_INFO, sizeof(vinfo), &vinfo);
+    }
+    else
+    {
+        vinfo.vid = begin;
+        vinfo.flags = (uint16_t)(flags | BRIDGE_VLAN_INFO_RANGE_BEGIN);
+        nla_put(msg, IFLA_BRIDGE_VLAN_INFO, sizeof(vinfo), &vinfo);
+        vinfo.vid = end;
+        vinfo.flags = (uint16_t)(flags | BRIDGE_VLAN_INFO_RANGE_END);
+        nla_put(msg, IFLA_BRIDGE_VLAN_INFO, sizeof(vinfo), &vinfo);
+    }
+    nla_nest_end(msg, afspec);
+    queue(msg, std::move(desc));
+}
+
+void KernelCfg::addBridgeVlan(const string &ifname, uint16_t vid, bool pvid, bool untagged, bool self)
+{
+    uint16_t flags = (uint16_t)((pvid ? BRIDGE_VLAN_INFO_PVID : 0) | (untagged ? BRIDGE_VLAN_INFO_UNTAGGED : 0));
+
+    queueBridgeVlan(RTM_SETLINK, ifname, vid, vid, flags, self,
+                    "bridge vlan add vid " + to_string(vid) + " dev " + ifname +
+                    (pvid ? " pvid" : "") + (untagged ? " untagged" : "") + (self ? " self" : ""));
+}
+
+void KernelCfg::delBridgeVlan(const string &ifname, uint16_t vid, bool self)
+{
+    queueBridgeVlan(RTM_DELLINK, ifname, vid, vid, 0, self,
+                    "bridge vlan del vid " + to_string(vid) + " dev " + ifname + (self ? " self" : ""));
+}
+
+void KernelCfg::addBridgeVlanRange(const string &ifname, uint16_t begin, uint16_t end, bool untagged, bool self)
+{
+    /* The kernel does not take the pvid flag on a range */
+    queueBridgeVlan(RTM_SETLINK, ifname, begin, end, untagged ? BRIDGE_VLAN_INFO_UNTAGGED : 0, self,
+                    "bridge vlan add vid " + to_string(begin) + "-" + to_string(end) + " dev " + ifname +
+                    (untagged ? " untagged" : "") + (self ? " self" : ""));
+}
+
+void KernelCfg::delBridgeVlanRange(const string &ifname, uint16_t begin, uint16_t end, bool self)
+{
+    queueBridgeVlan(RTM_DELLINK, ifname, begin, end, 0, self,
+                    "bridge vlan del vid " + to_string(begin) + "-" + to_string(end) + " dev " + ifname +
+                    (self ? " self" : ""));
+}
+
+static int addBridgeVlanPort(struct nl_msg *msg, void *arg)
+{
+    auto *ports = static_cast<set<string> *>(arg);
+    struct nlattr *tb[IFLA_MAX + 1];
+
+    if (nlmsg_parse(nlmsg_hdr(msg), sizeof(struct ifinfomsg), tb, IFLA_MAX, NULL) < 0 ||
+        !tb[IFLA_IFNAME] || !tb[IFLA_AF_SPEC])
+    {
+        return NL_OK;
+    }
+
+    struct nlattr *attr;
+    int rem;
+    nla_for_each_nested(attr, tb[IFLA_AF_SPEC], rem)
+    {
+        if (nla_type(attr) == IFLA_BRIDGE_VLAN_INFO)
+        {
+            ports->insert(nla_get_string(tb[IFLA_IFNAME]));
+            break;
+        }
+    }
+    return NL_OK;
+}
+
+void KernelCfg::getBridgeVlanPorts(set<string> &ports)
+{
+    struct ifinfomsg ifi;
+    memset(&ifi, 0, sizeof(ifi));
+    ifi.ifi_family = AF_BRIDGE;
+
+    struct nl_msg *msg = nlmsg_alloc_simple(RTM_GETLINK, NLM_F_DUMP);
+    if (!msg || nlmsg_append(msg, &ifi, sizeof(ifi), NLMSG_ALIGNTO) < 0)
+    {
+        throw bad_alloc();
+    }
+    nla_put_u32(msg, IFLA_EXT_MASK, RTEXT_FILTER_BRVLAN_COMPRESSED);
+
+    /* A port with many VLANs may not fit in a page */
+    nl_socket_enable_msg_peek(m_sock);
+
+    int err = nl_send_auto(m_sock, msg);
+    nlmsg_free(msg);
+    if (err >= 0)
+    {
+        struct nl_cb *cb = nl_cb_alloc(NL_CB_DEFAULT);
+        if (!cb)
+        {
+            throw bad_alloc();
+        }
+        nl_cb_set(cb, NL_CB_VALID, NL_CB_CUSTOM, addBridgeVlanPort, &ports);
+        err = nl_recvmsgs(m_sock, cb);
+        nl_cb_put(cb);
+    }
+
+    if (err < 0)
+    {
+        throw runtime_error(string("bridge vlan show : ") + nl_geterror(err));
+    }
+}
+
+void KernelCfg::send(size_t begin, size_t end)
+{
+    vector<char> buf;
+    size_t expected = 0;
+    uint32_t firstSeq = m_seq;
+
+    for (size_t i = begin; i < end; i++)
+    {
+        if (!m_requests[i].msg)
+        {
+            m_seq++;
+            continue;
+        }
+
+        struct nlmsghdr *hdr = nlmsg_hdr(m_requests[i].msg);
+        hdr->nlmsg_flags |= NLM_F_REQUEST | NLM_F_ACK;
+        hdr->nlmsg_seq = m_seq++;
+        hdr->nlmsg_pid = 0;
+
+        const char *data = (const char *)hdr;
+        buf.insert(buf.end(), data, data + NLMSG_ALIGN(hdr->nlmsg_len));
+        expected++;
+    }
+
+    if (!expected)
+    {
+        return;
+    }
+
+    int fd = nl_socket_get_fd(m_sock);
+    if (::send(fd, buf.data(), buf.size(), 0) < 0)
+    {
+        int err = -errno;
+        for (size_t i = begin; i < end; i++)
+        {
+            m_requests[i].err = m_requests[i].err ? m_requests[i].err : err;
+        }
+        return;
+    }
+
+    /* The kernel acknowledges each request, in order, before send() returns */
+    char reply[65536];
+    while (expected)
+    {
+        ssize_t len = recv(fd, reply, sizeof(reply), 0);
+        if (len < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw runtime_error(string("Failed to read netlink acknowledgements: ") + strerror(errno));
+        }
+
+        int remaining = (int)len;
+        for (struct nlmsghdr *hdr = (struct nlmsghdr *)reply; NLMSG_OK(hdr, remaining);
+             hdr = NLMSG_NEXT(hdr, remaining))
+        {
+            if (hdr->nlmsg_type != NLMSG_ERROR || hdr->nlmsg_seq - firstSeq >= end - begin)
+            {
+                continue;
+            }
+
+            struct nlmsgerr *nlerr = (struct nlmsgerr *)NLMSG_DATA(hdr);
+            m_requests[begin + hdr->nlmsg_seq - firstSeq].err = nlerr->error;
+            expected--;
+        }
+    }
+}
+
+bool KernelCfg::flush(string &error)
+{
+    SWSS_LOG_ENTER();
+
+    error.clear();
+
+    for (size_t begin = 0; begin < m_requests.size(); begin += MAX_BATCH)
+    {
+        send(begin, min(begin + MAX_BATCH, m_requests.size()));
+    }
+
+    bool ok = true;
+    for (auto &request : m_requests)
+    {
+        if (request.err && ok)
+        {
+            error = request.desc + " : " + strerror(-request.err);
+            ok = false;
+        }
+        SWSS_LOG_DEBUG("%s : %d", request.desc.c_str(), request.err);
+        nlmsg_free(request.msg);
+    }
+    m_requests.clear();
+
+    return ok;
+}
+
+void KernelCfg::flush()
+{
+    string error;
+
+    if (!flush(error))
+    {
+        throw runtime_error(error);
+    }
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <stdint.h>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ipprefix.h"
+#include "macaddress.h"
+
+struct nl_sock;
+struct nl_msg;
+
+namespace swss {
+
+/*
+ * Programs links, addresses and bridge VLANs through rtnetlink, in place of
+ * forking /sbin/ip and /sbin/bridge for every operation.
+ *
+ * Requests are queued, and flush() sends them to the kernel in as few
+ * sendmsg() calls as possible before collecting all the acknowledgements.
+ * The kernel applies the requests in order, a failed one does not stop the
+ * ones after it. Operations the class does not cover (creating bridges, VLAN,
+ * team or VXLAN devices...) are still done with the shell commands.
+ */
+class KernelCfg
+{
+public:
+    KernelCfg();
+    ~KernelCfg();
+
+    KernelCfg(const KernelCfg&) = delete;
+    KernelCfg& operator=(const KernelCfg&) = delete;
+
+    /* ip link set <ifname> up|down */
+    void setLinkAdminState(const std::string &ifname, bool up);
+    /* Same, with "up" or "down" as in CONFIG_DB */
+    void setLinkAdminState(const std::string &ifname, const std::string &admin_status);
+    void setLinkAdminState(const std::string &ifname, const char *admin_status)
+    {
+        setLinkAdminState(ifname, std::string(admin_status));
+    }
+    /* ip link set <ifname> mtu <mtu> */
+    void setLinkMtu(const std::string &ifname, uint32_t mtu);
+    /* Same, with the MTU as in CONFIG_DB */
+    void setLinkMtu(const std::string &ifname, const std::string &mtu);
+    /* ip link set <ifname> address <mac> */
+    void setLinkMac(const std::string &ifname, const MacAddress &mac);
+    /* ip link set <ifname> master <master>, or nomaster if master is empty */
+    void setLinkMaster(const std::string &ifname, const std::string &master);
+
+    /*
+     * ip address add <prefix> [broadcast <addr>] dev <ifname> [metric <metric>]
+     * The broadcast address of an IPv4 prefix is set as ip would be told to.
+     */
+    void addAddress(const std::string &ifname, const IpPrefix &prefix, bool broadcast, uint32_t metric = 0);
+    /* ip address del <prefix> dev <ifname> */
+    void delAddress(const std::string &ifname, const IpPrefix &prefix);
+
+    /* bridge vlan add vid <vid> dev <ifname> [pvid] [untagged] [self] */
+    void addBridgeVlan(const std::string &ifname, uint16_t vid, bool pvid, bool untagged, bool self = false);
+    /* bridge vlan del vid <vid> dev <ifname> [self] */
+    void delBridgeVlan(const std::string &ifname, uint16_t vid, bool self = false);
+    /* bridge vlan add vid <begin>-<end> dev <ifname> [untagged] [self], as one request */
+    void addBridgeVlanRange(const std::string &ifname, uint16_t begin, uint16_t end, bool untagged, bool self = false);
+    /* bridge vlan del vid <begin>-<end> dev <ifname> [self], as one request */
+    void delBridgeVlanRange(const std::string &ifname, uint16_t begin, uint16_t end, bool self = false);
+
+    /*
+     * Get the names of the bridge ports member of at least one VLAN, as in
+     * bridge vlan show. Requests not flushed yet are not accounted for.
+     * Throws std::runtime_error if the kernel can't be queried.
+     */
+    void getBridgeVlanPorts(std::set<std::string> &ports);
+
+    /* Number of requests queued since the last flush */
+    size_t pending() const
+    {
+        return m_requests.size();
+    }
+
+    /*
+     * Send the queued requests and wait for them to be applied. Returns false
+     * with the failed request and its error if any failed.
+     */
+    bool flush(std::string &error);
+
+    /* Same, throws std::runtime_error instead of returning false */
+    void flush();
+
+private:
+    /* Requests sent per sendmsg(), their acknowledgements must fit the receive buffer */
+    static const size_t MAX_BATCH = 64;
+
+    struct Request
+    {
+        struct nl_msg *msg;  // NULL if the request failed before it was sent
+        int            err;  // negative errno of the failed request
+        std::string    desc; // equivalent shell command, for errors
+    };
+
+    struct nl_sock       *m_sock;
+    uint32_t              m_seq;
+    std::vector<Request>  m_requests;
+
+    struct nl_msg *newLinkMsg(const std::string &ifname, int type, int family, uint32_t index);
+    void queueBridgeVlan(int type, const std::string &ifname, uint16_t begin, uint16_t end,
+                         uint16_t flags, bool self, std::string &&desc);
+    void queue(struct nl_msg *msg, std::string &&desc);
+    void queueError(int err, std::string &&desc);
+
+    /* Send the requests [begin, end) in one go, then read their acknowledgements */
+    void send(size_t begin, size_t end);
+};
+
+}
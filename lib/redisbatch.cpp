@@ -0,0 +1,103 @@
+#include <stdexcept>
+
+#include "redisbatch.h"
+#include "rediscommand.h"
+#include "redisreply.h"
+
+using namespace std;
+using namespace swss;
+
+RedisBatchReader::RedisBatchReader(RedisPipeline *pipeline) :
+    m_pipeline(pipeline)
+{
+}
+
+void RedisBatchReader::hgetall(const string &key)
+{
+    m_commands.push_back({ "HGETALL", key });
+}
+
+void RedisBatchReader::hmget(const string &key, const vector<string> &fields)
+{
+    vector<string> args = { "HMGET", key };
+    args.insert(args.end(), fields.begin(), fields.end());
+    m_commands.push_back(move(args));
+}
+
+void RedisBatchReader::exec(vector<Reply> &replies)
+{
+    replies.clear();
+    if (m_commands.empty())
+    {
+        return;
+    }
+
+    /* The batch is consumed even if it fails */
+    vector<vector<string>> commands;
+    commands.swap(m_commands);
+
+    /* Only the replies of the batch may be pending on the connection */
+    m_pipeline->flush();
+    redisContext *context = m_pipeline->getDBConnector()->getContext();
+
+    for (const auto &args : commands)
+    {
+        RedisCommand command;
+        command.format(args);
+        if (redisAppendFormattedCommand(context, command.c_str(), command.length()) != REDIS_OK)
+        {
+            throw runtime_error("Failed to queue " + args[0] + " " + args[1]);
+        }
+    }
+
+    string error;
+    replies.resize(commands.size());
+    for (size_t i = 0; i < commands.size(); i++)
+    {
+        redisReply *reply = nullptr;
+        if (redisGetReply(context, (void **)&reply) != REDIS_OK || reply == nullptr)
+        {
+            /* The connection is broken, there is nothing left to drain */
+            replies.clear();
+            throw runtime_error("Failed to read the reply of " + commands[i][0] + " " + commands[i][1] +
+                                ": " + string(context->errstr));
+        }
+
+        /* Releases the reply */
+        RedisReply r(reply);
+
+        if (reply->type != REDIS_REPLY_ARRAY)
+        {
+            /* Keep reading the replies of the batch, the first error is thrown after */
+            if (error.empty())
+            {
+                error = commands[i][0] + " " + commands[i][1] + " failed";
+                if (reply->type == REDIS_REPLY_ERROR)
+                {
+                    error += ": " + string(reply->str, reply->len);
+                }
+            }
+            continue;
+        }
+
+        replies[i].reserve(reply->elements);
+        for (size_t j = 0; j < reply->elements; j++)
+        {
+            redisReply *elem = reply->element[j];
+            if (elem->type == REDIS_REPLY_STRING)
+            {
+                replies[i].push_back(make_shared<string>(elem->str, elem->len));
+            }
+            else
+            {
+                replies[i].push_back(nullptr);
+            }
+        }
+    }
+
+    if (!error.empty())
+    {
+        replies.clear();
+        throw runtime_error(error);
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "redispipeline.h"
+
+namespace swss {
+
+/*
+ * Reads many keys in a single round trip.
+ *
+ * The queued commands are pipelined on the connection of a RedisPipeline,
+ * which is flushed first, and their replies are read back in order. Each
+ * command is run on its own by redis, so a batch doesn't block the server
+ * for longer than its slowest command. If a command fails, the replies of
+ * the rest of the batch are still read before the error is thrown, so the
+ * connection stays in step with the commands sent.
+ *
+ * Only read commands taking one key should be queued, HGETALL and HMGET.
+ */
+class RedisBatchReader
+{
+public:
+    /* Reply of one command, a missing element is nullptr */
+    typedef std::vector<std::shared_ptr<std::string>> Reply;
+
+    RedisBatchReader(RedisPipeline *pipeline);
+
+    /* HGETALL <key>, the reply is field, value, field, value... */
+    void hgetall(const std::string &key);
+    /* HMGET <key> <field>..., the reply has one element per field */
+    void hmget(const std::string &key, const std::vector<std::string> &fields);
+
+    size_t size() const
+    {
+        return m_commands.size();
+    }
+
+    /* Run the queued commands, replies are in the order the commands were queued */
+    void exec(std::vector<Reply> &replies);
+
+private:
+    RedisPipeline                          *m_pipeline;
+    /* Per command: name, key, arguments */
+    std::vector<std::vector<std::string>>   m_commands;
+};
+
+}
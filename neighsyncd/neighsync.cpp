@@ -14,22 +14,29 @@
 #include "neighsync.h"
 #include "warm_restart.h"
 #include <algorithm>
+#include <deque>
 
 using namespace std;
 using namespace swss;
 
 NeighSync::NeighSync(RedisPipeline *pipelineAppDB, DBConnector *stateDb, DBConnector *cfgDb) :
-    m_neighTable(pipelineAppDB, APP_NEIGH_TABLE_NAME),
+    m_neighTable(pipelineAppDB, APP_NEIGH_TABLE_NAME, true),
     m_stateNeighRestoreTable(stateDb, STATE_NEIGH_RESTORE_TABLE_NAME),
     m_cfgInterfaceTable(cfgDb, CFG_INTF_TABLE_NAME),
     m_cfgLagInterfaceTable(cfgDb, CFG_LAG_INTF_TABLE_NAME),
-    m_cfgVlanInterfaceTable(cfgDb, CFG_VLAN_INTF_TABLE_NAME)
+    m_cfgVlanInterfaceTable(cfgDb, CFG_VLAN_INTF_TABLE_NAME),
+    m_suppressedNeighs(0)
 {
     m_AppRestartAssist = new AppRestartAssist(pipelineAppDB, "neighsyncd", "swss", DEFAULT_NEIGHSYNC_WARMSTART_TIMER);
     if (m_AppRestartAssist)
     {
-        m_AppRestartAssist->registerAppTable(APP_NEIGH_TABLE_NAME, &m_neighTable);
+        m_AppRestartAssist->registerAppTable(APP_NEIGH_TABLE_NAME, &m_neighTable, true);
     }
+
+    /* Load the current config, the subscriptions push the changes from then on */
+    updateLinkLocalConfig(m_cfgInterfaceTable);
+    updateLinkLocalConfig(m_cfgLagInterfaceTable);
+    updateLinkLocalConfig(m_cfgVlanInterfaceTable);
 }
 
 NeighSync::~NeighSync()
@@ -62,6 +69,8 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
     string key;
     string family;
     string intfName;
+    NeighKey neighKey;
+    NeighMac neighMac;
 
     if ((nlmsg_type != RTM_NEWNEIGH) && (nlmsg_type != RTM_GETNEIGH) &&
         (nlmsg_type != RTM_DELNEIGH))
@@ -74,6 +83,25 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
     else
         return;
 
+    /*
+     * Drop the kernel refreshes of a published neighbor that leave its MAC
+     * unchanged, before resolving or formatting anything. The warm start
+     * cache needs every update, so nothing is tracked until it is reconciled.
+     */
+    bool tracked = !m_AppRestartAssist->isWarmStartInProgress() && getNeighKey(neigh, neighKey);
+    int state = rtnl_neigh_get_state(neigh);
+
+    if (tracked && (nlmsg_type != RTM_DELNEIGH) && (state != NUD_NOARP) &&
+        (state != NUD_INCOMPLETE) && (state != NUD_FAILED))
+    {
+        auto it = m_neighs.find(neighKey);
+        if (it != m_neighs.end() && getNeighMac(neigh, neighMac) && it->second == neighMac)
+        {
+            m_suppressedNeighs++;
+            return;
+        }
+    }
+
     key+= LinkCache::getInstance().ifindexToName(rtnl_neigh_get_ifindex(neigh));
     intfName = key;
     key+= ":";
@@ -92,7 +120,6 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
         return;
     key+= ipStr;
 
-    int state = rtnl_neigh_get_state(neigh);
     if (state == NUD_NOARP)
     {
         return;
@@ -130,57 +157,134 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
         if (delete_key == true)
         {
             m_neighTable.del(key);
+            if (tracked)
+            {
+                m_neighs.erase(neighKey);
+            }
             return;
         }
         m_neighTable.set(key, fvVector);
+        if (tracked)
+        {
+            if (getNeighMac(neigh, neighMac))
+            {
+                m_neighs[neighKey] = neighMac;
+            }
+            else
+            {
+                m_neighs.erase(neighKey);
+            }
+        }
     }
 }
 
-/* To check the ipv6 link local is enabled on a given port */
-bool NeighSync::isLinkLocalEnabled(const string &port)
+size_t NeighSync::NeighKeyHash::operator()(const NeighKey &k) const
 {
-    vector<FieldValueTuple> values;
+    size_t hash = std::hash<int>()(k.ifindex) ^ (std::hash<int>()(k.family) << 1);
 
-    if (!port.compare(0, strlen("Vlan"), "Vlan"))
+    for (auto byte : k.addr)
     {
-        if (!m_cfgVlanInterfaceTable.get(port, values))
-        {
-            SWSS_LOG_INFO("IPv6 Link local is not enabled on %s", port.c_str());
-            return false;
-        }
+        hash = hash * 31 + byte;
     }
-    else if (!port.compare(0, strlen("PortChannel"), "PortChannel"))
+    return hash;
+}
+
+/* Get the ifindex and IP address of the neighbor, false if they do not fit */
+bool NeighSync::getNeighKey(struct rtnl_neigh *neigh, NeighKey &key)
+{
+    struct nl_addr *dst = rtnl_neigh_get_dst(neigh);
+
+    if (!dst || nl_addr_get_len(dst) > key.addr.size())
     {
-        if (!m_cfgLagInterfaceTable.get(port, values))
-        {
-            SWSS_LOG_INFO("IPv6 Link local is not enabled on %s", port.c_str());
-            return false;
-        }
+        return false;
     }
-    else if (!port.compare(0, strlen("Ethernet"), "Ethernet"))
+
+    key.ifindex = rtnl_neigh_get_ifindex(neigh);
+    key.family = rtnl_neigh_get_family(neigh);
+    key.addr.fill(0);
+    memcpy(key.addr.data(), nl_addr_get_binary_addr(dst), nl_addr_get_len(dst));
+    return true;
+}
+
+/* Get the Ethernet MAC of the neighbor, false if it has none */
+bool NeighSync::getNeighMac(struct rtnl_neigh *neigh, NeighMac &mac)
+{
+    struct nl_addr *lladdr = rtnl_neigh_get_lladdr(neigh);
+
+    if (!lladdr || nl_addr_get_len(lladdr) != mac.size())
     {
-        if (!m_cfgInterfaceTable.get(port, values))
+        return false;
+    }
+
+    memcpy(mac.data(), nl_addr_get_binary_addr(lladdr), mac.size());
+    return true;
+}
+
+void NeighSync::addConfigSelectables(Select &s)
+{
+    s.addSelectable(&m_cfgInterfaceTable);
+    s.addSelectable(&m_cfgLagInterfaceTable);
+    s.addSelectable(&m_cfgVlanInterfaceTable);
+}
+
+bool NeighSync::processConfigChange(Selectable *temps)
+{
+    if (temps == &m_cfgInterfaceTable || temps == &m_cfgLagInterfaceTable ||
+        temps == &m_cfgVlanInterfaceTable)
+    {
+        updateLinkLocalConfig(*static_cast<SubscriberStateTable *>(temps));
+        return true;
+    }
+    return false;
+}
+
+/* Track the ipv6_use_link_local_only setting of the interfaces in table */
+void NeighSync::updateLinkLocalConfig(SubscriberStateTable &table)
+{
+    std::deque<KeyOpFieldsValuesTuple> entries;
+
+    table.pops(entries);
+    for (const auto &entry : entries)
+    {
+        const string &port = kfvKey(entry);
+
+        /* Skip the IP address entries of the interface */
+        if (port.find(table.getTableNameSeparator()) != string::npos)
+        {
+            continue;
+        }
+
+        const auto &values = kfvFieldsValues(entry);
+        auto it = std::find_if(values.begin(), values.end(), [](const FieldValueTuple& t){ return t.first == "ipv6_use_link_local_only";});
+
+        if (kfvOp(entry) == SET_COMMAND && it != values.end() && it->second == "enable")
+        {
+            SWSS_LOG_INFO("IPv6 Link local is enabled on %s", port.c_str());
+            m_linkLocalEnabled.insert(port);
+        }
+        else if (m_linkLocalEnabled.erase(port))
         {
-            SWSS_LOG_INFO("IPv6 Link local is not enabled on %s", port.c_str());
-            return false;
+            SWSS_LOG_INFO("IPv6 Link local is disabled on %s", port.c_str());
         }
     }
-    else
+}
+
+/* To check the ipv6 link local is enabled on a given port */
+bool NeighSync::isLinkLocalEnabled(const string &port)
+{
+    if (port.compare(0, strlen("Vlan"), "Vlan") &&
+        port.compare(0, strlen("PortChannel"), "PortChannel") &&
+        port.compare(0, strlen("Ethernet"), "Ethernet"))
     {
         SWSS_LOG_INFO("IPv6 Link local is not supported for %s ", port.c_str());
         return false;
     }
 
-    auto it = std::find_if(values.begin(), values.end(), [](const FieldValueTuple& t){ return t.first == "ipv6_use_link_local_only";});
-    if (it != values.end())
+    if (m_linkLocalEnabled.find(port) == m_linkLocalEnabled.end())
     {
-        if (it->second == "enable")
-        {
-            SWSS_LOG_INFO("IPv6 Link local is enabled on %s", port.c_str());
-            return true;
-        }
+        SWSS_LOG_INFO("IPv6 Link local is not enabled on %s", port.c_str());
+        return false;
     }
 
-    SWSS_LOG_INFO("IPv6 Link local is not enabled on %s", port.c_str());
-    return false;
+    return true;
 }
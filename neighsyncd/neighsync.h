@@ -1,8 +1,15 @@
 #ifndef __NEIGHSYNC__
 #define __NEIGHSYNC__
 
+#include <array>
+#include <unordered_map>
+#include <unordered_set>
+#include <netlink/route/neighbour.h>
+
 #include "dbconnector.h"
 #include "producerstatetable.h"
+#include "subscriberstatetable.h"
+#include "select.h"
 #include "netmsg.h"
 #include "warmRestartAssist.h"
 
@@ -16,6 +23,9 @@
  */
 #define RESTORE_NEIGH_WAIT_TIME_OUT 120
 
+// Neighbor updates buffered in the APPL_DB pipeline before it is flushed
+#define NEIGHSYNC_PIPELINE_SIZE 1024
+
 namespace swss {
 
 class NeighSync : public NetMsg
@@ -30,17 +40,60 @@ public:
 
     bool isNeighRestoreDone();
 
+    /* Add the subscriptions to the interface config to the select loop */
+    void addConfigSelectables(Select &s);
+
+    /* Apply the config changes pushed to temps, false if it is not a subscription */
+    bool processConfigChange(Selectable *temps);
+
     AppRestartAssist *getRestartAssist()
     {
         return m_AppRestartAssist;
     }
 
+    /* Kernel neighbor updates dropped as they do not change the published state */
+    uint64_t getSuppressedNeighCount() const
+    {
+        return m_suppressedNeighs;
+    }
+
 private:
+    /* Binary identity of a neighbor, checked before the update is formatted */
+    struct NeighKey
+    {
+        int ifindex;
+        int family;
+        std::array<uint8_t, 16> addr;
+
+        bool operator==(const NeighKey &o) const
+        {
+            return ifindex == o.ifindex && family == o.family && addr == o.addr;
+        }
+    };
+
+    struct NeighKeyHash
+    {
+        size_t operator()(const NeighKey &k) const;
+    };
+
+    typedef std::array<uint8_t, 6> NeighMac;
+
+    /* MAC of each neighbor published to APPL_DB */
+    std::unordered_map<NeighKey, NeighMac, NeighKeyHash> m_neighs;
+    uint64_t m_suppressedNeighs;
+
+    bool getNeighKey(struct rtnl_neigh *neigh, NeighKey &key);
+    bool getNeighMac(struct rtnl_neigh *neigh, NeighMac &mac);
+
     Table m_stateNeighRestoreTable;
     ProducerStateTable m_neighTable;
     AppRestartAssist  *m_AppRestartAssist;
-    Table m_cfgVlanInterfaceTable, m_cfgLagInterfaceTable, m_cfgInterfaceTable;
+    SubscriberStateTable m_cfgVlanInterfaceTable, m_cfgLagInterfaceTable, m_cfgInterfaceTable;
+
+    /* Interfaces with ipv6_use_link_local_only enabled, kept in sync with CONFIG_DB */
+    std::unordered_set<std::string> m_linkLocalEnabled;
 
+    void updateLinkLocalConfig(SubscriberStateTable &table);
     bool isLinkLocalEnabled(const std::string &port);
 };
 
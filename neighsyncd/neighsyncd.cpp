@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <chrono>
+#include <inttypes.h>
 #include "logger.h"
 #include "select.h"
 #include "netdispatcher.h"
@@ -16,7 +17,7 @@ int main(int argc, char **argv)
     Logger::linkToDbNative("neighsyncd");
 
     DBConnector appDb("APPL_DB", 0);
-    RedisPipeline pipelineAppDB(&appDb);
+    RedisPipeline pipelineAppDB(&appDb, NEIGHSYNC_PIPELINE_SIZE);
     DBConnector stateDb("STATE_DB", 0);
     DBConnector cfgDb("CONFIG_DB", 0);
 
@@ -67,10 +68,36 @@ int main(int argc, char **argv)
             netlink.dumpRequest(RTM_GETNEIGH);
 
             s.addSelectable(&netlink);
+            sync.addConfigSelectables(s);
+
+            /* Set while the burst processed so far is not published yet */
+            bool pending = false;
+            uint64_t suppressed = sync.getSuppressedNeighCount();
             while (true)
             {
                 Selectable *temps;
-                s.select(&temps);
+
+                /*
+                 * The neighbor table is buffered: keep processing while messages
+                 * are pending, and publish the whole burst once all are handled.
+                 */
+                if (s.select(&temps, pending ? 0 : -1) == Select::TIMEOUT)
+                {
+                    pipelineAppDB.flush();
+                    pending = false;
+
+                    uint64_t total = sync.getSuppressedNeighCount();
+                    if (total != suppressed)
+                    {
+                        SWSS_LOG_INFO("Published neighbor updates, %" PRIu64 " suppressed (%" PRIu64 " total)",
+                                      total - suppressed, total);
+                        suppressed = total;
+                    }
+                    continue;
+                }
+                pending = true;
+
+                sync.processConfigChange(temps);
                 /*
                  * If warmstart is in progress, we check the reconcile timer,
                  * if timer expired, we stop the timer and start the reconcile process
@@ -3218,6 +3218,9 @@ void AclOrch::doTask(Consumer &consumer)
 
     string table_name = consumer.getTableName();
 
+    /* Rule counters added by this batch are written to FLEX_COUNTER_DB at once */
+    FlexCounterBulk bulk(m_flex_counter_manager);
+
     if (table_name == CFG_ACL_TABLE_TABLE_NAME || table_name == APP_ACL_TABLE_TABLE_NAME)
     {
         doAclTableTask(consumer);
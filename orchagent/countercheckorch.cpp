@@ -6,6 +6,8 @@
 #include <inttypes.h>
 
 #define COUNTER_CHECK_POLL_TIMEOUT_SEC   (5 * 60)
+#define COUNTER_CHECK_STATS_TABLE        "COUNTER_CHECK_STATS"
+#define COUNTER_CHECK_BATCH_PORTS        64
 
 extern sai_port_api_t *sai_port_api;
 
@@ -24,7 +26,10 @@ CounterCheckOrch& CounterCheckOrch::getInstance(DBConnector *db)
 CounterCheckOrch::CounterCheckOrch(DBConnector *db, vector<string> &tableNames):
     Orch(db, tableNames),
     m_countersDb(new DBConnector("COUNTERS_DB", 0)),
-    m_countersTable(new Table(m_countersDb.get(), COUNTERS_TABLE))
+    m_countersTable(new Table(m_countersDb.get(), COUNTERS_TABLE)),
+    m_checkStatsTable(new Table(m_countersDb.get(), COUNTER_CHECK_STATS_TABLE)),
+    m_countersPipeline(new RedisPipeline(m_countersDb.get())),
+    m_countersReader(new RedisBatchReader(m_countersPipeline.get()))
 {
     SWSS_LOG_ENTER();
 
@@ -44,11 +49,40 @@ void CounterCheckOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
-    mcCounterCheck();
-    pfcFrameCounterCheck();
+    auto begin = chrono::steady_clock::now();
+
+    vector<Port> ports;
+    for (const auto& i : m_mcCountersMap)
+    {
+        Port port;
+        if (gPortsOrch->getPort(i.first, port))
+        {
+            ports.push_back(port);
+        }
+    }
+
+    map<sai_object_id_t, QueueMcCounters> mcCountersMap;
+    map<sai_object_id_t, PfcFrameCounters> pfcFrameCountersMap;
+    getCounters(ports, mcCountersMap, pfcFrameCountersMap);
+
+    mcCounterCheck(mcCountersMap);
+    pfcFrameCounterCheck(pfcFrameCountersMap);
+
+    /* Export how long the check held the main loop */
+    auto duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - begin);
+    m_maxCheckDuration = max(m_maxCheckDuration, duration);
+
+    vector<FieldValueTuple> fieldValues;
+    fieldValues.emplace_back("ports", to_string(ports.size()));
+    fieldValues.emplace_back("last_duration_us", to_string(duration.count()));
+    fieldValues.emplace_back("max_duration_us", to_string(m_maxCheckDuration.count()));
+    m_checkStatsTable->set("", fieldValues);
+
+    SWSS_LOG_INFO("Checked counters of %zu ports in %" PRId64 " us",
+            ports.size(), static_cast<int64_t>(duration.count()));
 }
 
-void CounterCheckOrch::mcCounterCheck()
+void CounterCheckOrch::mcCounterCheck(const map<sai_object_id_t, QueueMcCounters>& newMcCountersMap)
 {
     SWSS_LOG_ENTER();
 
@@ -65,7 +99,12 @@ void CounterCheckOrch::mcCounterCheck()
             continue;
         }
 
-        auto newMcCounters = getQueueMcCounters(port);
+        auto it = newMcCountersMap.find(oid);
+        if (it == newMcCountersMap.end())
+        {
+            continue;
+        }
+        const auto& newMcCounters = it->second;
 
         if (!gPortsOrch->getPortPfc(port.m_port_id, &pfcMask))
         {
@@ -73,7 +112,7 @@ void CounterCheckOrch::mcCounterCheck()
             continue;
         }
 
-        for (size_t prio = 0; prio != mcCounters.size(); prio++)
+        for (size_t prio = 0; prio != mcCounters.size() && prio != newMcCounters.size(); prio++)
         {
             bool isLossy = ((1 << prio) & pfcMask) == 0;
             if (newMcCounters[prio] == numeric_limits<uint64_t>::max())
@@ -91,11 +130,11 @@ void CounterCheckOrch::mcCounterCheck()
             }
         }
 
-        i.second= newMcCounters;
+        i.second = newMcCounters;
     }
 }
 
-void CounterCheckOrch::pfcFrameCounterCheck()
+void CounterCheckOrch::pfcFrameCounterCheck(const map<sai_object_id_t, PfcFrameCounters>& newCountersMap)
 {
     SWSS_LOG_ENTER();
 
@@ -103,7 +142,6 @@ void CounterCheckOrch::pfcFrameCounterCheck()
     {
         auto oid = i.first;
         auto counters = i.second;
-        auto newCounters = getPfcFrameCounters(oid);
         uint8_t pfcMask = 0;
 
         Port port;
@@ -113,6 +151,13 @@ void CounterCheckOrch::pfcFrameCounterCheck()
             continue;
         }
 
+        auto it = newCountersMap.find(oid);
+        if (it == newCountersMap.end())
+        {
+            continue;
+        }
+        const auto& newCounters = it->second;
+
         if (!gPortsOrch->getPortPfc(port.m_port_id, &pfcMask))
         {
             SWSS_LOG_ERROR("Failed to get PFC mask on port %s", port.m_alias.c_str());
@@ -141,16 +186,66 @@ void CounterCheckOrch::pfcFrameCounterCheck()
     }
 }
 
+void CounterCheckOrch::loadQueueTypes()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_queueTypesLoaded)
+    {
+        return;
+    }
 
-PfcFrameCounters CounterCheckOrch::getPfcFrameCounters(sai_object_id_t portId)
+    vector<FieldValueTuple> values;
+    Table queueTypeTable(m_countersDb.get(), COUNTERS_QUEUE_TYPE_MAP);
+    queueTypeTable.get("", values);
+
+    m_mcQueueIds.clear();
+    for (const auto& fv : values)
+    {
+        if (fvValue(fv) == "SAI_QUEUE_TYPE_MULTICAST")
+        {
+            sai_object_id_t queueId;
+            sai_deserialize_object_id(fvField(fv), queueId);
+            m_mcQueueIds.insert(queueId);
+        }
+    }
+
+    m_queueTypesLoaded = true;
+}
+
+void CounterCheckOrch::addQueueTypes(const vector<FieldValueTuple>& queueTypes)
 {
     SWSS_LOG_ENTER();
 
-    vector<FieldValueTuple> fieldValues;
-    PfcFrameCounters counters;
-    counters.fill(numeric_limits<uint64_t>::max());
+    /* Otherwise the whole map is read on first use */
+    if (!m_queueTypesLoaded)
+    {
+        return;
+    }
 
-    static const array<string, PFC_WD_TC_MAX> counterNames =
+    for (const auto& fv : queueTypes)
+    {
+        if (fvValue(fv) == "SAI_QUEUE_TYPE_MULTICAST")
+        {
+            sai_object_id_t queueId;
+            sai_deserialize_object_id(fvField(fv), queueId);
+            m_mcQueueIds.insert(queueId);
+        }
+    }
+}
+
+void CounterCheckOrch::getCounters(const vector<Port>& ports,
+        map<sai_object_id_t, QueueMcCounters>& mcCounters,
+        map<sai_object_id_t, PfcFrameCounters>& pfcFrameCounters)
+{
+    SWSS_LOG_ENTER();
+
+    static const vector<string> queueCounterNames =
+    {
+        "SAI_QUEUE_STAT_PACKETS"
+    };
+
+    static const vector<string> portCounterNames =
     {
         "SAI_PORT_STAT_PFC_0_RX_PKTS",
         "SAI_PORT_STAT_PFC_1_RX_PKTS",
@@ -162,69 +257,94 @@ PfcFrameCounters CounterCheckOrch::getPfcFrameCounters(sai_object_id_t portId)
         "SAI_PORT_STAT_PFC_7_RX_PKTS"
     };
 
-    if (!m_countersTable->get(sai_serialize_object_id(portId), fieldValues))
-    {
-        return counters;
-    }
+    loadQueueTypes();
 
-    for (const auto& fv : fieldValues)
+    /* HMGET only the counters checked, of the multicast queues then of each port */
+    auto addRead = [&](sai_object_id_t oid, const vector<string>& counterNames)
     {
-        const auto field = fvField(fv);
-        const auto value = fvValue(fv);
-
+        m_countersReader->hmget(m_countersTable->getKeyName(sai_serialize_object_id(oid)), counterNames);
+    };
 
-        for (size_t prio = 0; prio != counterNames.size(); prio++)
+    /* Returns false if none of the counters is in the database */
+    auto readReply = [](const RedisBatchReader::Reply& reply, uint64_t *values, size_t count)
+    {
+        bool found = false;
+        for (size_t i = 0; i < count; i++)
         {
-            if (field == counterNames[prio])
+            values[i] = numeric_limits<uint64_t>::max();
+            if (i >= reply.size() || !reply[i])
             {
-                counters[prio] = stoul(value);
+                continue;
             }
-        }
-    }
-
-    return counters;
-}
 
-QueueMcCounters CounterCheckOrch::getQueueMcCounters(
-        const Port& port)
-{
-    SWSS_LOG_ENTER();
-
-    vector<FieldValueTuple> fieldValues;
-    QueueMcCounters counters;
+            try
+            {
+                values[i] = stoull(*reply[i]);
+                found = true;
+            }
+            catch (const logic_error&)
+            {
+                SWSS_LOG_WARN("Invalid counter value %s", reply[i]->c_str());
+            }
+        }
+        return found;
+    };
 
-    for (uint8_t prio = 0; prio < port.m_queue_ids.size(); prio++)
+    vector<RedisBatchReader::Reply> replies;
+    for (size_t first = 0; first < ports.size(); first += COUNTER_CHECK_BATCH_PORTS)
     {
-        sai_object_id_t queueId = port.m_queue_ids[prio];
-        auto queueIdStr = sai_serialize_object_id(queueId);
-        auto queueType = m_countersDb->hget(COUNTERS_QUEUE_TYPE_MAP, queueIdStr);
+        size_t last = min(ports.size(), first + COUNTER_CHECK_BATCH_PORTS);
 
-        if (queueType.get() == nullptr || *queueType != "SAI_QUEUE_TYPE_MULTICAST" || !m_countersTable->get(queueIdStr, fieldValues))
+        for (size_t p = first; p < last; p++)
         {
-            continue;
+            for (auto queueId : ports[p].m_queue_ids)
+            {
+                if (m_mcQueueIds.find(queueId) != m_mcQueueIds.end())
+                {
+                    addRead(queueId, queueCounterNames);
+                }
+            }
+            addRead(ports[p].m_port_id, portCounterNames);
         }
 
-        uint64_t pkts = numeric_limits<uint64_t>::max();
-        for (const auto& fv : fieldValues)
+        /* The counters of the batch are missing if it can't be read */
+        size_t count = m_countersReader->size();
+        try
+        {
+            m_countersReader->exec(replies);
+        }
+        catch (const exception& e)
         {
-            const auto field = fvField(fv);
-            const auto value = fvValue(fv);
+            SWSS_LOG_ERROR("Failed to read counters from COUNTERS_DB: %s", e.what());
+            replies.clear();
+        }
+        replies.resize(count);
 
-            if (field == "SAI_QUEUE_STAT_PACKETS")
+        auto reply = replies.begin();
+        for (size_t p = first; p < last; p++)
+        {
+            auto& queueCounters = mcCounters[ports[p].m_port_id];
+            for (auto queueId : ports[p].m_queue_ids)
             {
-                pkts = stoul(value);
+                uint64_t pkts;
+                if (m_mcQueueIds.find(queueId) != m_mcQueueIds.end() && readReply(*reply++, &pkts, 1))
+                {
+                    queueCounters.push_back(pkts);
+                }
             }
+            readReply(*reply++, pfcFrameCounters[ports[p].m_port_id].data(), PFC_WD_TC_MAX);
         }
-        counters.push_back(pkts);
     }
-
-    return counters;
 }
 
 void CounterCheckOrch::addPort(const Port& port)
 {
-    m_mcCountersMap.emplace(port.m_port_id, getQueueMcCounters(port));
-    m_pfcFrameCountersMap.emplace(port.m_port_id, getPfcFrameCounters(port.m_port_id));
+    map<sai_object_id_t, QueueMcCounters> mcCountersMap;
+    map<sai_object_id_t, PfcFrameCounters> pfcFrameCountersMap;
+    getCounters({ port }, mcCountersMap, pfcFrameCountersMap);
+
+    m_mcCountersMap.emplace(port.m_port_id, mcCountersMap[port.m_port_id]);
+    m_pfcFrameCountersMap.emplace(port.m_port_id, pfcFrameCountersMap[port.m_port_id]);
 }
 
 void CounterCheckOrch::removePort(const Port& port)
@@ -4,7 +4,10 @@
 #include "orch.h"
 #include "port.h"
 #include "timer.h"
+#include "redisbatch.h"
 #include <array>
+#include <chrono>
+#include <set>
 
 #define PFC_WD_TC_MAX 8
 
@@ -23,20 +26,34 @@ public:
     virtual void doTask(Consumer &consumer) {}
     void addPort(const swss::Port& port);
     void removePort(const swss::Port& port);
+    /* Queue types just added to COUNTERS_QUEUE_TYPE_MAP, as queue oid and type */
+    void addQueueTypes(const std::vector<swss::FieldValueTuple>& queueTypes);
 
 private:
     CounterCheckOrch(swss::DBConnector *db, std::vector<std::string> &tableNames);
     virtual ~CounterCheckOrch(void);
-    QueueMcCounters getQueueMcCounters(const swss::Port& port);
-    PfcFrameCounters getPfcFrameCounters(sai_object_id_t portId);
-    void mcCounterCheck();
-    void pfcFrameCounterCheck();
+    /* Read the counters of the given ports, in batches of COUNTER_CHECK_BATCH_PORTS ports */
+    void getCounters(const std::vector<swss::Port>& ports,
+            std::map<sai_object_id_t, QueueMcCounters>& mcCounters,
+            std::map<sai_object_id_t, PfcFrameCounters>& pfcFrameCounters);
+    void loadQueueTypes();
+    void mcCounterCheck(const std::map<sai_object_id_t, QueueMcCounters>& newMcCountersMap);
+    void pfcFrameCounterCheck(const std::map<sai_object_id_t, PfcFrameCounters>& newCountersMap);
 
     std::map<sai_object_id_t, QueueMcCounters> m_mcCountersMap;
     std::map<sai_object_id_t, PfcFrameCounters> m_pfcFrameCountersMap;
 
+    /* Multicast queues in COUNTERS_QUEUE_TYPE_MAP, valid if m_queueTypesLoaded */
+    std::set<sai_object_id_t> m_mcQueueIds;
+    bool m_queueTypesLoaded = false;
+
+    std::chrono::microseconds m_maxCheckDuration{0};
+
     std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
     std::shared_ptr<swss::Table> m_countersTable = nullptr;
+    std::shared_ptr<swss::Table> m_checkStatsTable = nullptr;
+    std::unique_ptr<swss::RedisPipeline> m_countersPipeline;
+    std::unique_ptr<swss::RedisBatchReader> m_countersReader;
 };
 
 #endif
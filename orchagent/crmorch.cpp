@@ -1,11 +1,13 @@
 #include <sstream>
 #include <inttypes.h>
+#include <algorithm>
 
 #include "crmorch.h"
 #include "converter.h"
 #include "timer.h"
 
 #define CRM_POLLING_INTERVAL "polling_interval"
+#define CRM_EVENT_DRIVEN "event_driven"
 #define CRM_COUNTERS_TABLE_KEY "STATS"
 
 #define CRM_POLLING_INTERVAL_DEFAULT (5 * 60)
@@ -14,6 +16,9 @@
 #define CRM_THRESHOLD_HIGH_DEFAULT 85
 #define CRM_EXCEEDED_MSG_MAX 10
 #define CRM_ACL_RESOURCE_COUNT 256
+// In event driven mode, the availability of all the resources is still queried every
+// this many polls, to catch up with the resources sharing hardware tables
+#define CRM_EVENT_DRIVEN_FULL_QUERY_POLLS 12
 
 extern sai_object_id_t gSwitchId;
 extern sai_switch_api_t *sai_switch_api;
@@ -337,6 +342,17 @@ void CrmOrch::handleSetCommand(const string& key, const vector<FieldValueTuple>&
                 m_timer->setInterval(interv);
                 m_timer->reset();
             }
+            else if (field == CRM_EVENT_DRIVEN)
+            {
+                if (value != "true" && value != "false")
+                {
+                    throw invalid_argument("value must be true or false");
+                }
+
+                m_eventDriven = (value == "true");
+                // Start over from a full query of the availability
+                m_pollsSinceFullQuery = 0;
+            }
             else if (crmThreshTypeResMap.find(field) != crmThreshTypeResMap.end())
             {
                 auto resourceType = crmThreshTypeResMap.at(field);
@@ -382,7 +398,10 @@ void CrmOrch::incCrmResUsedCounter(CrmResourceType resource)
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter++;
+        auto &res = m_resourcesMap.at(resource);
+        auto &cnt = res.countersMap[CRM_COUNTERS_TABLE_KEY];
+        cnt.usedCounter++;
+        onUsedCounterChanged(res, cnt, true);
     }
     catch (...)
     {
@@ -397,7 +416,10 @@ void CrmOrch::decCrmResUsedCounter(CrmResourceType resource)
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter--;
+        auto &res = m_resourcesMap.at(resource);
+        auto &cnt = res.countersMap[CRM_COUNTERS_TABLE_KEY];
+        cnt.usedCounter--;
+        onUsedCounterChanged(res, cnt, false);
     }
     catch (...)
     {
@@ -412,7 +434,10 @@ void CrmOrch::incCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t sta
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmAclKey(stage, point)].usedCounter++;
+        auto &res = m_resourcesMap.at(resource);
+        auto &cnt = res.countersMap[getCrmAclKey(stage, point)];
+        cnt.usedCounter++;
+        onUsedCounterChanged(res, cnt, true);
     }
     catch (...)
     {
@@ -427,7 +452,10 @@ void CrmOrch::decCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t sta
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmAclKey(stage, point)].usedCounter--;
+        auto &res = m_resourcesMap.at(resource);
+        auto &cnt = res.countersMap[getCrmAclKey(stage, point)];
+        cnt.usedCounter--;
+        onUsedCounterChanged(res, cnt, false);
 
         // remove acl_entry and acl_counter in this acl table
         if (resource == CrmResourceType::CRM_ACL_TABLE)
@@ -466,8 +494,11 @@ void CrmOrch::incCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)].usedCounter++;
-        m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)].id = tableId;
+        auto &res = m_resourcesMap.at(resource);
+        auto &cnt = res.countersMap[getCrmAclTableKey(tableId)];
+        cnt.usedCounter++;
+        cnt.id = tableId;
+        onUsedCounterChanged(res, cnt, true);
     }
     catch (...)
     {
@@ -482,7 +513,10 @@ void CrmOrch::decCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)].usedCounter--;
+        auto &res = m_resourcesMap.at(resource);
+        auto &cnt = res.countersMap[getCrmAclTableKey(tableId)];
+        cnt.usedCounter--;
+        onUsedCounterChanged(res, cnt, false);
     }
     catch (...)
     {
@@ -495,11 +529,51 @@ void CrmOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
-    getResAvailableCounters();
+    bool fullQuery = true;
+    if (m_eventDriven)
+    {
+        fullQuery = (m_pollsSinceFullQuery == 0);
+        m_pollsSinceFullQuery = (m_pollsSinceFullQuery + 1) % CRM_EVENT_DRIVEN_FULL_QUERY_POLLS;
+    }
+
+    getResAvailableCounters(fullQuery);
     updateCrmCountersTable();
     checkCrmThresholds();
 }
 
+void CrmOrch::setAvailableCounter(CrmResourceCounter &cnt, uint32_t availableCounter)
+{
+    cnt.availableCounter = availableCounter;
+    cnt.hasAvailable = true;
+    cnt.usedChanged = false;
+}
+
+void CrmOrch::onUsedCounterChanged(CrmResourceEntry &res, CrmResourceCounter &cnt, bool increased)
+{
+    cnt.usedChanged = true;
+
+    if (!m_eventDriven || !cnt.hasAvailable)
+    {
+        return;
+    }
+
+    // Assume the object took or released one entry, until the availability is queried
+    // again at the next poll
+    if (increased)
+    {
+        if (cnt.availableCounter > 0)
+        {
+            cnt.availableCounter--;
+        }
+    }
+    else
+    {
+        cnt.availableCounter++;
+    }
+
+    checkCrmThreshold(res, cnt, true);
+}
+
 bool CrmOrch::getResAvailability(CrmResourceType type, CrmResourceEntry &res)
 {
     sai_attribute_t attr;
@@ -563,15 +637,23 @@ bool CrmOrch::getResAvailability(CrmResourceType type, CrmResourceEntry &res)
         availCount = attr.value.u32;
     }
 
-    res.countersMap[CRM_COUNTERS_TABLE_KEY].availableCounter = static_cast<uint32_t>(availCount);
+    setAvailableCounter(res.countersMap[CRM_COUNTERS_TABLE_KEY], static_cast<uint32_t>(availCount));
 
     return true;
 }
 
-void CrmOrch::getResAvailableCounters()
+void CrmOrch::getResAvailableCounters(bool fullQuery)
 {
     SWSS_LOG_ENTER();
 
+    // Unless fullQuery is set, only the counters whose usage changed since the last
+    // query are queried
+    auto usedChanged = [](const CrmResourceEntry &res, const string &key)
+    {
+        auto it = res.countersMap.find(key);
+        return it != res.countersMap.end() && it->second.usedChanged;
+    };
+
     for (auto &res : m_resourcesMap)
     {
         // ignore unsupported resources
@@ -600,6 +682,11 @@ void CrmOrch::getResAvailableCounters()
             case CrmResourceType::CRM_MPLS_NEXTHOP:
             case CrmResourceType::CRM_SRV6_NEXTHOP:
             {
+                if (!fullQuery && !usedChanged(res.second, CRM_COUNTERS_TABLE_KEY))
+                {
+                    break;
+                }
+
                 getResAvailability(res.first, res.second);
                 break;
             }
@@ -607,6 +694,13 @@ void CrmOrch::getResAvailableCounters()
             case CrmResourceType::CRM_ACL_TABLE:
             case CrmResourceType::CRM_ACL_GROUP:
             {
+                // All the stages and bind points are queried at once
+                if (!fullQuery && none_of(res.second.countersMap.begin(), res.second.countersMap.end(),
+                        [](const pair<const string, CrmResourceCounter> &cnt) { return cnt.second.usedChanged; }))
+                {
+                    break;
+                }
+
                 sai_attribute_t attr;
                 attr.id = crmResSaiAvailAttrMap.at(res.first);
 
@@ -635,7 +729,7 @@ void CrmOrch::getResAvailableCounters()
                 for (uint32_t i = 0; i < attr.value.aclresource.count; i++)
                 {
                     string key = getCrmAclKey(attr.value.aclresource.list[i].stage, attr.value.aclresource.list[i].bind_point);
-                    res.second.countersMap[key].availableCounter = attr.value.aclresource.list[i].avail_num;
+                    setAvailableCounter(res.second.countersMap[key], attr.value.aclresource.list[i].avail_num);
                 }
 
                 break;
@@ -649,6 +743,11 @@ void CrmOrch::getResAvailableCounters()
 
                 for (auto &cnt : res.second.countersMap)
                 {
+                    if (!fullQuery && !cnt.second.usedChanged)
+                    {
+                        continue;
+                    }
+
                     sai_status_t status = sai_acl_api->get_acl_table_attribute(cnt.second.id, 1, &attr);
                     if (status != SAI_STATUS_SUCCESS)
                     {
@@ -656,7 +755,7 @@ void CrmOrch::getResAvailableCounters()
                         break;
                     }
 
-                    cnt.second.availableCounter = attr.value.u32;
+                    setAvailableCounter(cnt.second, attr.value.u32);
                 }
 
                 break;
@@ -673,6 +772,10 @@ void CrmOrch::updateCrmCountersTable()
 {
     SWSS_LOG_ENTER();
 
+    // The fields of each key are written at once. In event driven mode, only the
+    // counters that changed since the last update are written.
+    map<string, vector<FieldValueTuple>> updates;
+
     // Update CRM used counters in COUNTERS_DB
     for (const auto &i : crmUsedCntsTableMap)
     {
@@ -680,9 +783,11 @@ void CrmOrch::updateCrmCountersTable()
         {
             for (const auto &cnt : m_resourcesMap.at(i.second).countersMap)
             {
-                FieldValueTuple attr(i.first, to_string(cnt.second.usedCounter));
-                vector<FieldValueTuple> attrs = { attr };
-                m_countersCrmTable->set(cnt.first, attrs);
+                if (m_eventDriven && cnt.second.published && cnt.second.usedCounter == cnt.second.publishedUsed)
+                {
+                    continue;
+                }
+                updates[cnt.first].emplace_back(i.first, to_string(cnt.second.usedCounter));
             }
         }
         catch(const out_of_range &e)
@@ -698,9 +803,11 @@ void CrmOrch::updateCrmCountersTable()
         {
             for (const auto &cnt : m_resourcesMap.at(i.second).countersMap)
             {
-                FieldValueTuple attr(i.first, to_string(cnt.second.availableCounter));
-                vector<FieldValueTuple> attrs = { attr };
-                m_countersCrmTable->set(cnt.first, attrs);
+                if (m_eventDriven && cnt.second.published && cnt.second.availableCounter == cnt.second.publishedAvailable)
+                {
+                    continue;
+                }
+                updates[cnt.first].emplace_back(i.first, to_string(cnt.second.availableCounter));
             }
         }
         catch(const out_of_range &e)
@@ -708,6 +815,21 @@ void CrmOrch::updateCrmCountersTable()
             // expected when a resource is unavailable
         }
     }
+
+    for (const auto &it : updates)
+    {
+        m_countersCrmTable->set(it.first, it.second);
+    }
+
+    for (auto &res : m_resourcesMap)
+    {
+        for (auto &cnt : res.second.countersMap)
+        {
+            cnt.second.published = true;
+            cnt.second.publishedUsed = cnt.second.usedCounter;
+            cnt.second.publishedAvailable = cnt.second.availableCounter;
+        }
+    }
 }
 
 void CrmOrch::checkCrmThresholds()
@@ -716,65 +838,70 @@ void CrmOrch::checkCrmThresholds()
 
     for (auto &i : m_resourcesMap)
     {
-        auto &res = i.second;
-
         for (const auto &j : i.second.countersMap)
         {
-            auto &cnt = j.second;
-            uint64_t utilization = 0;
-            uint32_t percentageUtil = 0;
-            string threshType = "";
+            checkCrmThreshold(i.second, j.second, false);
+        }
+    }
+}
 
-            if (cnt.usedCounter != 0)
-            {
-                uint32_t dvsr = cnt.usedCounter + cnt.availableCounter;
-                if (dvsr != 0)
-                {
-                    percentageUtil = (cnt.usedCounter * 100) / dvsr;
-                }
-                else
-                {
-                    SWSS_LOG_WARN("%s Exception occurred (div by Zero): Used count %u free count %u",
-                                  res.name.c_str(), cnt.usedCounter, cnt.availableCounter);
-                }
-            }
+void CrmOrch::checkCrmThreshold(CrmResourceEntry &res, const CrmResourceCounter &cnt, bool crossingOnly)
+{
+    // With crossingOnly, THRESHOLD_EXCEEDED is only logged when the high threshold is
+    // crossed, the periodic check repeats it up to CRM_EXCEEDED_MSG_MAX times
+    uint64_t utilization = 0;
+    uint32_t percentageUtil = 0;
+    string threshType = "";
 
-            switch (res.thresholdType)
-            {
-                case CrmThresholdType::CRM_PERCENTAGE:
-                    utilization = percentageUtil;
-                    threshType = "TH_PERCENTAGE";
-                    break;
-                case CrmThresholdType::CRM_USED:
-                    utilization = cnt.usedCounter;
-                    threshType = "TH_USED";
-                    break;
-                case CrmThresholdType::CRM_FREE:
-                    utilization = cnt.availableCounter;
-                    threshType = "TH_FREE";
-                    break;
-                default:
-                    throw runtime_error("Unknown threshold type for CRM resource");
-            }
+    if (cnt.usedCounter != 0)
+    {
+        uint32_t dvsr = cnt.usedCounter + cnt.availableCounter;
+        if (dvsr != 0)
+        {
+            percentageUtil = (cnt.usedCounter * 100) / dvsr;
+        }
+        else
+        {
+            SWSS_LOG_WARN("%s Exception occurred (div by Zero): Used count %u free count %u",
+                          res.name.c_str(), cnt.usedCounter, cnt.availableCounter);
+        }
+    }
 
-            if ((utilization >= res.highThreshold) && (res.exceededLogCounter < CRM_EXCEEDED_MSG_MAX))
-            {
-                SWSS_LOG_WARN("%s THRESHOLD_EXCEEDED for %s %u%% Used count %u free count %u",
-                              res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
+    switch (res.thresholdType)
+    {
+        case CrmThresholdType::CRM_PERCENTAGE:
+            utilization = percentageUtil;
+            threshType = "TH_PERCENTAGE";
+            break;
+        case CrmThresholdType::CRM_USED:
+            utilization = cnt.usedCounter;
+            threshType = "TH_USED";
+            break;
+        case CrmThresholdType::CRM_FREE:
+            utilization = cnt.availableCounter;
+            threshType = "TH_FREE";
+            break;
+        default:
+            throw runtime_error("Unknown threshold type for CRM resource");
+    }
 
-                res.exceededLogCounter++;
-            }
-            else if ((utilization <= res.lowThreshold) && (res.exceededLogCounter > 0))
-            {
-                SWSS_LOG_WARN("%s THRESHOLD_CLEAR for %s %u%% Used count %u free count %u",
-                              res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
+    uint32_t exceededMsgMax = crossingOnly ? 1 : CRM_EXCEEDED_MSG_MAX;
 
-                res.exceededLogCounter = 0;
-            }
-        } // end of counters loop
-    } // end of resources loop
-}
+    if ((utilization >= res.highThreshold) && (res.exceededLogCounter < exceededMsgMax))
+    {
+        SWSS_LOG_WARN("%s THRESHOLD_EXCEEDED for %s %u%% Used count %u free count %u",
+                      res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
 
+        res.exceededLogCounter++;
+    }
+    else if ((utilization <= res.lowThreshold) && (res.exceededLogCounter > 0))
+    {
+        SWSS_LOG_WARN("%s THRESHOLD_CLEAR for %s %u%% Used count %u free count %u",
+                      res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
+
+        res.exceededLogCounter = 0;
+    }
+}
 
 string CrmOrch::getCrmAclKey(sai_acl_stage_t stage, sai_acl_bind_point_type_t bindPoint)
 {
@@ -73,6 +73,16 @@ private:
         sai_object_id_t id = 0;
         uint32_t availableCounter = 0;
         uint32_t usedCounter = 0;
+
+        // Set once the availability was queried from SAI
+        bool hasAvailable = false;
+        // Set when usedCounter changed since the availability was last queried
+        bool usedChanged = true;
+
+        // Values last written to COUNTERS_DB
+        bool published = false;
+        uint32_t publishedAvailable = 0;
+        uint32_t publishedUsed = 0;
     };
 
     struct CrmResourceEntry
@@ -93,15 +103,23 @@ private:
 
     std::chrono::seconds m_pollingInterval;
 
+    // In event driven mode the thresholds are checked as the used counters change,
+    // and only the resources used since the last poll are queried from SAI
+    bool m_eventDriven = false;
+    uint32_t m_pollsSinceFullQuery = 0;
+
     std::map<CrmResourceType, CrmResourceEntry> m_resourcesMap;
 
     void doTask(Consumer &consumer);
     void handleSetCommand(const std::string& key, const std::vector<swss::FieldValueTuple>& data);
     void doTask(swss::SelectableTimer &timer);
     bool getResAvailability(CrmResourceType type, CrmResourceEntry &res);
-    void getResAvailableCounters();
+    void getResAvailableCounters(bool fullQuery = true);
+    void setAvailableCounter(CrmResourceCounter &cnt, uint32_t availableCounter);
+    void onUsedCounterChanged(CrmResourceEntry &res, CrmResourceCounter &cnt, bool increased);
     void updateCrmCountersTable();
     void checkCrmThresholds();
+    void checkCrmThreshold(CrmResourceEntry &res, const CrmResourceCounter &cnt, bool crossingOnly);
     std::string getCrmAclKey(sai_acl_stage_t stage, sai_acl_bind_point_type_t bindPoint);
     std::string getCrmAclTableKey(sai_object_id_t id);
 };
@@ -22,6 +22,7 @@ extern PortsOrch*       gPortsOrch;
 extern CrmOrch *        gCrmOrch;
 extern MlagOrch*        gMlagOrch;
 extern Directory<Orch*> gDirectory;
+extern size_t           gMaxBulkSize;
 
 const int FdbOrch::fdborch_pri = 20;
 
@@ -30,7 +31,8 @@ FdbOrch::FdbOrch(DBConnector* applDbConnector, vector<table_name_with_pri_t> app
     Orch(applDbConnector, appFdbTables),
     m_portsOrch(port),
     m_fdbStateTable(stateDbFdbConnector.first, stateDbFdbConnector.second),
-    m_mclagFdbStateTable(stateDbMclagFdbConnector.first, stateDbMclagFdbConnector.second)
+    m_mclagFdbStateTable(stateDbMclagFdbConnector.first, stateDbMclagFdbConnector.second),
+    gFdbBulker(sai_fdb_api, gMaxBulkSize)
 {
     for(auto it: appFdbTables)
     {
@@ -74,9 +76,9 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
     const Port& port = update.port;
     const MacAddress& mac = entry.mac;
     string portName = port.m_alias;
-    Port vlan;
 
-    if (!m_portsOrch->getPort(entry.bv_id, vlan))
+    const Port *vlan = m_portsOrch->findPort(entry.bv_id);
+    if (vlan == nullptr)
     {
         SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate \
                          vlan port from bv_id 0x%" PRIx64, entry.bv_id);
@@ -84,7 +86,7 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
     }
 
     // ref: https://github.com/Azure/sonic-swss/blob/master/doc/swss-schema.md#fdb_table
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + mac.to_string();
+    string key = "Vlan" + to_string(vlan->m_vlan_info.vlan_id) + ":" + mac.to_string();
 
     if (update.add)
     {
@@ -184,7 +186,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
     update.entry.mac = entry->mac_address;
     update.entry.bv_id = entry->bv_id;
     update.type = "dynamic";
-    Port vlan;
+    const Port *vlan = nullptr;
 
     SWSS_LOG_INFO("FDB event:%d, MAC: %s , BVID: 0x%" PRIx64 " , \
                    bridge port ID: 0x%" PRIx64 ".",
@@ -218,7 +220,8 @@ void FdbOrch::update(sai_fdb_event_t        type,
     {
         SWSS_LOG_INFO("Received LEARN event for bvid=0x%" PRIx64 "mac=%s port=0x%" PRIx64, entry->bv_id, update.entry.mac.to_string().c_str(), bridge_port_id);
 
-        if (!m_portsOrch->getPort(entry->bv_id, vlan))
+        vlan = m_portsOrch->findPort(entry->bv_id);
+        if (vlan == nullptr)
         {
             SWSS_LOG_ERROR("FdbOrch LEARN notification: Failed to locate vlan port from bv_id 0x%" PRIx64, entry->bv_id);
             return;
@@ -233,20 +236,18 @@ void FdbOrch::update(sai_fdb_event_t        type,
                 // If the bp is different MOVE the MAC entry.
                 if (existing_entry->second.bridge_port_id != bridge_port_id)
                 {
-                    Port port;
                     SWSS_LOG_NOTICE("FdbOrch LEARN notification: mac %s is already in bv_id 0x%" PRIx64 "with different existing-bp 0x%" PRIx64 " new-bp:0x%" PRIx64,
                             update.entry.mac.to_string().c_str(), entry->bv_id, existing_entry->second.bridge_port_id, bridge_port_id);
-                    if (!m_portsOrch->getPortByBridgePortId(existing_entry->second.bridge_port_id, port))
+                    const Port *port = m_portsOrch->findPortByBridgePortId(existing_entry->second.bridge_port_id);
+                    if (port == nullptr)
                     {
                         SWSS_LOG_NOTICE("FdbOrch LEARN notification: Failed to get port by bridge port ID 0x%" PRIx64, existing_entry->second.bridge_port_id);
                         return;
                     }
                     else
                     {
-                        port.m_fdb_count--;
-                        m_portsOrch->setPort(port.m_alias, port);
-                        vlan.m_fdb_count--;
-                        m_portsOrch->setPort(vlan.m_alias, vlan);
+                        m_portsOrch->updatePort(port->m_alias, [](Port &p) { p.m_fdb_count--; });
+                        m_portsOrch->updatePort(vlan->m_alias, [](Port &p) { p.m_fdb_count--; });
                     }
                     // Continue to add (update/move) the MAC
                 }
@@ -303,10 +304,8 @@ void FdbOrch::update(sai_fdb_event_t        type,
         update.add = true;
         update.entry.port_name = update.port.m_alias;
         update.type = "dynamic";
-        update.port.m_fdb_count++;
-        m_portsOrch->setPort(update.port.m_alias, update.port);
-        vlan.m_fdb_count++;
-        m_portsOrch->setPort(vlan.m_alias, vlan);
+        m_portsOrch->updatePort(update.port.m_alias, [&update](Port &p) { update.port.m_fdb_count = ++p.m_fdb_count; });
+        m_portsOrch->updatePort(vlan->m_alias, [](Port &p) { p.m_fdb_count++; });
 
         storeFdbEntryState(update);
         notify(SUBJECT_TYPE_FDB_CHANGE, &update);
@@ -318,7 +317,8 @@ void FdbOrch::update(sai_fdb_event_t        type,
         SWSS_LOG_INFO("Received AGE event for bvid=0x%" PRIx64 " mac=%s port=0x%" PRIx64,
                        entry->bv_id, update.entry.mac.to_string().c_str(), bridge_port_id);
 
-        if (!m_portsOrch->getPort(entry->bv_id, vlan))
+        vlan = m_portsOrch->findPort(entry->bv_id);
+        if (vlan == nullptr)
         {
             SWSS_LOG_NOTICE("FdbOrch AGE notification: Failed to locate vlan port from bv_id 0x%" PRIx64, entry->bv_id);
         }
@@ -349,7 +349,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
         {
             update.type = "static";
 
-            if (vlan.m_members.find(update.port.m_alias) == vlan.m_members.end())
+            if (vlan == nullptr || vlan->m_members.find(update.port.m_alias) == vlan->m_members.end())
             {
                 FdbData fdbData;
                 fdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
@@ -359,7 +359,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
                 fdbData.esi = existing_entry->second.esi;
                 fdbData.vni = existing_entry->second.vni;
                 saved_fdb_entries[update.port.m_alias].push_back(
-                        {existing_entry->first.mac, vlan.m_vlan_info.vlan_id, fdbData});
+                        {existing_entry->first.mac, vlan ? vlan->m_vlan_info.vlan_id : (sai_vlan_id_t)0, fdbData});
             }
             else
             {
@@ -417,7 +417,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
             SWSS_LOG_NOTICE("fdbEvent: MAC age event received, MAC is MCLAG origin, added back"
                 "to HW type %s FDB %s in %s on %s",
                 existing_entry->second.type.c_str(),
-                update.entry.mac.to_string().c_str(), vlan.m_alias.c_str(),
+                update.entry.mac.to_string().c_str(), vlan ? vlan->m_alias.c_str() : "",
                 update.port.m_alias.c_str());
 
             status = sai_fdb_api->create_fdb_entry(&fdb_entry, (uint32_t)attrs.size(), attrs.data());
@@ -425,7 +425,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
             {
                 SWSS_LOG_ERROR("Failed to create %s FDB %s in %s on %s, rv:%d",
                         existing_entry->second.type.c_str(), update.entry.mac.to_string().c_str(),
-                        vlan.m_alias.c_str(), update.port.m_alias.c_str(), status);
+                        vlan ? vlan->m_alias.c_str() : "", update.port.m_alias.c_str(), status);
             }
             return;
         }
@@ -433,13 +433,11 @@ void FdbOrch::update(sai_fdb_event_t        type,
         update.add = false;
         if (!update.port.m_alias.empty())
         {
-            update.port.m_fdb_count--;
-            m_portsOrch->setPort(update.port.m_alias, update.port);
+            m_portsOrch->updatePort(update.port.m_alias, [&update](Port &p) { update.port.m_fdb_count = --p.m_fdb_count; });
         }
-        if (!vlan.m_alias.empty())
+        if (vlan != nullptr)
         {
-            vlan.m_fdb_count--;
-            m_portsOrch->setPort(vlan.m_alias, vlan);
+            m_portsOrch->updatePort(vlan->m_alias, [](Port &p) { p.m_fdb_count--; });
         }
         storeFdbEntryState(update);
 
@@ -456,7 +454,8 @@ void FdbOrch::update(sai_fdb_event_t        type,
         SWSS_LOG_INFO("Received MOVE event for bvid=0x%" PRIx64 " mac=%s port=0x%" PRIx64,
                        entry->bv_id, update.entry.mac.to_string().c_str(), bridge_port_id);
 
-        if (!m_portsOrch->getPort(entry->bv_id, vlan))
+        vlan = m_portsOrch->findPort(entry->bv_id);
+        if (vlan == nullptr)
         {
             SWSS_LOG_ERROR("FdbOrch MOVE notification: Failed to locate vlan port from bv_id 0x%" PRIx64, entry->bv_id);
             return;
@@ -477,11 +476,9 @@ void FdbOrch::update(sai_fdb_event_t        type,
         update.add = true;
         if (!port_old.m_alias.empty())
         {
-            port_old.m_fdb_count--;
-            m_portsOrch->setPort(port_old.m_alias, port_old);
+            m_portsOrch->updatePort(port_old.m_alias, [&port_old](Port &p) { port_old.m_fdb_count = --p.m_fdb_count; });
         }
-        update.port.m_fdb_count++;
-        m_portsOrch->setPort(update.port.m_alias, update.port);
+        m_portsOrch->updatePort(update.port.m_alias, [&update](Port &p) { update.port.m_fdb_count = ++p.m_fdb_count; });
         storeFdbEntryState(update);
 
         notify(SUBJECT_TYPE_FDB_CHANGE, &update);
@@ -499,15 +496,14 @@ void FdbOrch::update(sai_fdb_event_t        type,
 
         string vlanName = "-";
         if (entry->bv_id) {
-            Port vlan;
-
-            if (!m_portsOrch->getPort(entry->bv_id, vlan))
+            vlan = m_portsOrch->findPort(entry->bv_id);
+            if (vlan == nullptr)
             {
                 SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate vlan\
                                 port from bv_id 0x%" PRIx64, entry->bv_id);
                 return;
             }
-            vlanName = "Vlan" + to_string(vlan.m_vlan_info.vlan_id);
+            vlanName = "Vlan" + to_string(vlan->m_vlan_info.vlan_id);
         }
 
 
@@ -608,7 +604,8 @@ bool FdbOrch::getPort(const MacAddress& mac, uint16_t vlan, Port& port)
 {
     SWSS_LOG_ENTER();
 
-    if (!m_portsOrch->getVlanByVlanId(vlan, port))
+    const Port *vlanPort = m_portsOrch->findVlanByVlanId(vlan);
+    if (vlanPort == nullptr)
     {
         SWSS_LOG_ERROR("Failed to get vlan by vlan ID %d", vlan);
         return false;
@@ -617,7 +614,7 @@ bool FdbOrch::getPort(const MacAddress& mac, uint16_t vlan, Port& port)
     sai_fdb_entry_t entry;
     entry.switch_id = gSwitchId;
     memcpy(entry.mac_address, mac.getMac(), sizeof(sai_mac_t));
-    entry.bv_id = port.m_vlan_info.vlan_oid;
+    entry.bv_id = vlanPort->m_vlan_info.vlan_oid;
 
     sai_attribute_t attr;
     attr.id = SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID;
@@ -668,186 +665,257 @@ void FdbOrch::doTask(Consumer& consumer)
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
-
-        /* format: <VLAN_name>:<MAC_address> */
-        vector<string> keys = tokenize(kfvKey(t), ':', 1);
-        string op = kfvOp(t);
-
-        Port vlan;
-        if (!m_portsOrch->getPort(keys[0], vlan))
+        // FDB bulk results will be stored in a map
+        std::map<
+                std::string,                    // Key
+                FdbBulkContext
+        >                                       toBulk;
+
+        // Add or remove FDB entries with the FDB bulker
+        while (it != consumer.m_toSync.end())
         {
-            SWSS_LOG_INFO("Failed to locate %s", keys[0].c_str());
-            if(op == DEL_COMMAND)
-            {
-                /* Delete if it is in saved_fdb_entry */
-                unsigned short vlan_id;
-                try {
-                    vlan_id = (unsigned short) stoi(keys[0].substr(4));
-                } catch(exception &e) {
-                    it = consumer.m_toSync.erase(it);
-                    continue;
-                }
-                deleteFdbEntryFromSavedFDB(MacAddress(keys[1]), vlan_id, origin);
+            KeyOpFieldsValuesTuple t = it->second;
 
-                it = consumer.m_toSync.erase(it);
-            }
-            else
+            /*
+             * DEL and SET of the same MAC must be applied in order,
+             * flush the current bulk before handling the same MAC again
+             */
+            if (toBulk.find(kfvKey(t)) != toBulk.end())
             {
-                it++;
+                break;
             }
-            continue;
-        }
 
-        FdbEntry entry;
-        entry.mac = MacAddress(keys[1]);
-        entry.bv_id = vlan.m_vlan_info.vlan_oid;
+            /* format: <VLAN_name>:<MAC_address> */
+            vector<string> keys = tokenize(kfvKey(t), ':', 1);
+            string op = kfvOp(t);
 
-        if (op == SET_COMMAND)
-        {
-            string port = "";
-            string type = "dynamic";
-            string remote_ip = "";
-            string esi = "";
-            unsigned int vni = 0;
-            string sticky = "";
-
-            for (auto i : kfvFieldsValues(t))
+            const Port *vlan = m_portsOrch->findPort(keys[0]);
+            if (vlan == nullptr)
             {
-                if (fvField(i) == "port")
+                SWSS_LOG_INFO("Failed to locate %s", keys[0].c_str());
+                if(op == DEL_COMMAND)
                 {
-                    port = fvValue(i);
-                }
+                    /* Delete if it is in saved_fdb_entry */
+                    unsigned short vlan_id;
+                    try {
+                        vlan_id = (unsigned short) stoi(keys[0].substr(4));
+                    } catch(exception &e) {
+                        it = consumer.m_toSync.erase(it);
+                        continue;
+                    }
+                    deleteFdbEntryFromSavedFDB(MacAddress(keys[1]), vlan_id, origin);
 
-                if (fvField(i) == "type")
+                    it = consumer.m_toSync.erase(it);
+                }
+                else
                 {
-                    type = fvValue(i);
+                    it++;
                 }
+                continue;
+            }
 
-                if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
+            FdbEntry entry;
+            entry.mac = MacAddress(keys[1]);
+            entry.bv_id = vlan->m_vlan_info.vlan_oid;
+
+            if (op == SET_COMMAND)
+            {
+                string port = "";
+                string type = "dynamic";
+                string remote_ip = "";
+                string esi = "";
+                unsigned int vni = 0;
+                string sticky = "";
+
+                for (auto i : kfvFieldsValues(t))
                 {
-                    if (fvField(i) == "remote_vtep")
+                    if (fvField(i) == "port")
                     {
-                        remote_ip = fvValue(i);
-                        // Creating an IpAddress object to validate if remote_ip is valid
-                        // if invalid it will throw the exception and we will ignore the
-                        // event
-                        try {
-                            IpAddress valid_ip = IpAddress(remote_ip);
-                            (void)valid_ip; // To avoid g++ warning
-                        } catch(exception &e) {
-                            SWSS_LOG_NOTICE("Invalid IP address in remote MAC %s", remote_ip.c_str());
-                            remote_ip = "";
-                            break;
-                        }
+                        port = fvValue(i);
                     }
 
-                    if (fvField(i) == "esi")
+                    if (fvField(i) == "type")
                     {
-                        esi = fvValue(i);
+                        type = fvValue(i);
                     }
 
-                    if (fvField(i) == "vni")
+                    if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
                     {
-                        try {
-                            vni = (unsigned int) stoi(fvValue(i));
-                        } catch(exception &e) {
-                            SWSS_LOG_INFO("Invalid VNI in remote MAC %s", fvValue(i).c_str());
-                            vni = 0;
-                            break;
+                        if (fvField(i) == "remote_vtep")
+                        {
+                            remote_ip = fvValue(i);
+                            // Creating an IpAddress object to validate if remote_ip is valid
+                            // if invalid it will throw the exception and we will ignore the
+                            // event
+                            try {
+                                IpAddress valid_ip = IpAddress(remote_ip);
+                                (void)valid_ip; // To avoid g++ warning
+                            } catch(exception &e) {
+                                SWSS_LOG_NOTICE("Invalid IP address in remote MAC %s", remote_ip.c_str());
+                                remote_ip = "";
+                                break;
+                            }
+                        }
+
+                        if (fvField(i) == "esi")
+                        {
+                            esi = fvValue(i);
+                        }
+
+                        if (fvField(i) == "vni")
+                        {
+                            try {
+                                vni = (unsigned int) stoi(fvValue(i));
+                            } catch(exception &e) {
+                                SWSS_LOG_INFO("Invalid VNI in remote MAC %s", fvValue(i).c_str());
+                                vni = 0;
+                                break;
+                            }
                         }
                     }
                 }
-            }
-
-            /* FDB type is either dynamic or static */
-            assert(type == "dynamic" || type == "dynamic_local" || type == "static" );
 
-            if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
-            {
-                VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
+                /* FDB type is either dynamic or static */
+                assert(type == "dynamic" || type == "dynamic_local" || type == "static" );
 
-                if (tunnel_orch->isDipTunnelsSupported())
+                if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
                 {
-                    if(!remote_ip.length())
+                    VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
+
+                    if (tunnel_orch->isDipTunnelsSupported())
                     {
-                        it = consumer.m_toSync.erase(it);
-                        continue;
+                        if(!remote_ip.length())
+                        {
+                            it = consumer.m_toSync.erase(it);
+                            continue;
+                        }
+                        port = tunnel_orch->getTunnelPortName(remote_ip);
                     }
-                    port = tunnel_orch->getTunnelPortName(remote_ip);
-                }
-                else
-                {
-                    EvpnNvoOrch* evpn_nvo_orch = gDirectory.get<EvpnNvoOrch*>();
-                    VxlanTunnel* sip_tunnel = evpn_nvo_orch->getEVPNVtep();
-                    if (sip_tunnel == NULL)
+                    else
                     {
-                        it = consumer.m_toSync.erase(it);
-                        continue;
+                        EvpnNvoOrch* evpn_nvo_orch = gDirectory.get<EvpnNvoOrch*>();
+                        VxlanTunnel* sip_tunnel = evpn_nvo_orch->getEVPNVtep();
+                        if (sip_tunnel == NULL)
+                        {
+                            it = consumer.m_toSync.erase(it);
+                            continue;
+                        }
+                        port = tunnel_orch->getTunnelPortName(sip_tunnel->getSrcIP().to_string(), true);
                     }
-                    port = tunnel_orch->getTunnelPortName(sip_tunnel->getSrcIP().to_string(), true);
                 }
-            }
 
 
-            FdbData fdbData;
-            fdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
-            fdbData.type = type;
-            fdbData.origin = origin;
-            fdbData.remote_ip = remote_ip;
-            fdbData.esi = esi;
-            fdbData.vni = vni;
-            if (addFdbEntry(entry, port, fdbData))
-            {
-                if (origin == FDB_ORIGIN_MCLAG_ADVERTIZED)
+                FdbData fdbData;
+                fdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
+                fdbData.type = type;
+                fdbData.origin = origin;
+                fdbData.remote_ip = remote_ip;
+                fdbData.esi = esi;
+                fdbData.vni = vni;
+
+                auto& ctx = toBulk.emplace(std::piecewise_construct,
+                        std::forward_as_tuple(kfvKey(t)),
+                        std::forward_as_tuple(entry, port, fdbData)).first->second;
+
+                if (!addFdbEntry(ctx))
                 {
-                    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
-                    if (type == "dynamic_local")
-                    {
-                        m_mclagFdbStateTable.del(key);
-                    }
+                    it++;
                 }
-
-                if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
+                else if (ctx.queued)
                 {
-                    VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
+                    /* Entry is completed after the bulk is flushed */
+                    it++;
+                }
+                else
+                {
+                    doFdbEntryDone(ctx);
+                    it = consumer.m_toSync.erase(it);
+                }
+            }
+            else if (op == DEL_COMMAND)
+            {
+                auto& ctx = toBulk.emplace(std::piecewise_construct,
+                        std::forward_as_tuple(kfvKey(t)),
+                        std::forward_as_tuple(entry, origin)).first->second;
 
-                    if(!remote_ip.length())
-                    {
-                        it = consumer.m_toSync.erase(it);
-                        continue;
-                    }
-                    port = tunnel_orch->getTunnelPortName(remote_ip);
+                if (!removeFdbEntry(ctx))
+                {
+                    it++;
+                }
+                else if (ctx.queued)
+                {
+                    /* Entry is completed after the bulk is flushed */
+                    it++;
+                }
+                else
+                {
+                    doFdbEntryDone(ctx);
+                    it = consumer.m_toSync.erase(it);
                 }
-                it = consumer.m_toSync.erase(it);
             }
             else
-                it++;
+            {
+                SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
+                it = consumer.m_toSync.erase(it);
+            }
         }
-        else if (op == DEL_COMMAND)
+
+        // Flush the bulker, so FDB entries will be written to syncd and ASIC
+        gFdbBulker.flush();
+
+        // Go through the bulker results
+        auto it_prev = consumer.m_toSync.begin();
+        while (it_prev != it)
         {
-            if (removeFdbEntry(entry, origin))
+            string key = kfvKey(it_prev->second);
+            string op = kfvOp(it_prev->second);
+
+            auto found = toBulk.find(key);
+            if (found == toBulk.end() || !found->second.queued ||
+                found->second.add != (op == SET_COMMAND))
             {
-                if (origin == FDB_ORIGIN_MCLAG_ADVERTIZED)
-                {
-                    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
-                    m_mclagFdbStateTable.del(key);
-                    SWSS_LOG_NOTICE("fdbEvent: do Task Delete MCLAG FDB from state mclag remote fdb table: "
-                            "Mac: %s Vlan: %d ",entry.mac.to_string().c_str(), vlan.m_vlan_info.vlan_id );
-                }
+                it_prev++;
+                continue;
+            }
 
-                it = consumer.m_toSync.erase(it);
+            auto& ctx = found->second;
+            if (ctx.add ? addFdbEntryPost(ctx) : removeFdbEntryPost(ctx))
+            {
+                doFdbEntryDone(ctx);
+                it_prev = consumer.m_toSync.erase(it_prev);
             }
             else
-                it++;
-
+            {
+                it_prev++;
+            }
         }
-        else
+    }
+}
+
+void FdbOrch::doFdbEntryDone(const FdbBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    if (ctx.origin != FDB_ORIGIN_MCLAG_ADVERTIZED)
+    {
+        return;
+    }
+
+    string key = "Vlan" + to_string(ctx.vlan_id) + ":" + ctx.entry.mac.to_string();
+
+    if (ctx.add)
+    {
+        if (ctx.fdbData.type == "dynamic_local")
         {
-            SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
-            it = consumer.m_toSync.erase(it);
+            m_mclagFdbStateTable.del(key);
         }
     }
+    else
+    {
+        m_mclagFdbStateTable.del(key);
+        SWSS_LOG_NOTICE("fdbEvent: do Task Delete MCLAG FDB from state mclag remote fdb table: "
+                "Mac: %s Vlan: %d ", ctx.entry.mac.to_string().c_str(), ctx.vlan_id);
+    }
 }
 
 void FdbOrch::doTask(NotificationConsumer& consumer)
@@ -1080,14 +1148,14 @@ void FdbOrch::updatePortOperState(const PortOperStateUpdate& update)
         m_portsOrch->getPortVlanMembers(p, vlan_members);
         for (const auto& vlan_member: vlan_members)
         {
-            swss::Port vlan;
             string vlan_alias = VLAN_PREFIX + to_string(vlan_member.first);
-            if (!m_portsOrch->getPort(vlan_alias, vlan))
+            const Port *vlan = m_portsOrch->findPort(vlan_alias);
+            if (vlan == nullptr)
             {
                 SWSS_LOG_INFO("Failed to locate VLAN %s", vlan_alias.c_str());
                 continue;
             }
-            notifyObserversFDBFlush(p, vlan.m_vlan_info.vlan_oid);
+            notifyObserversFDBFlush(p, vlan->m_vlan_info.vlan_oid);
         }
 
     }
@@ -1134,10 +1202,35 @@ void FdbOrch::updateVlanMember(const VlanMemberUpdate& update)
 bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         FdbData fdbData)
 {
-    Port vlan;
-    Port port;
+    SWSS_LOG_ENTER();
+
+    /* A single entry is programmed directly, without a bulk of one */
+    FdbBulkContext ctx(entry, port_name, fdbData);
+    ctx.bulk = false;
+
+    if (!addFdbEntry(ctx))
+    {
+        return false;
+    }
+
+    if (!ctx.queued)
+    {
+        return true;
+    }
+
+    return addFdbEntryPost(ctx);
+}
+
+bool FdbOrch::addFdbEntry(FdbBulkContext& ctx)
+{
+    const Port *vlan;
+    const Port *port;
     string end_point_ip = "";
 
+    const FdbEntry& entry = ctx.entry;
+    const string& port_name = ctx.port_name;
+    const FdbData& fdbData = ctx.fdbData;
+
     VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
 
     SWSS_LOG_ENTER();
@@ -1145,18 +1238,23 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
             entry.mac.to_string().c_str(), entry.bv_id, port_name.c_str(),
             fdbData.type.c_str(), fdbData.origin, fdbData.remote_ip.c_str());
 
-    if (!m_portsOrch->getPort(entry.bv_id, vlan))
+    vlan = m_portsOrch->findPort(entry.bv_id);
+    if (vlan == nullptr)
     {
         SWSS_LOG_NOTICE("addFdbEntry: Failed to locate vlan port from bv_id 0x%" PRIx64, entry.bv_id);
         return false;
     }
 
+    ctx.vlan_id = vlan->m_vlan_info.vlan_id;
+    ctx.vlan_name = vlan->m_alias;
+
     /* Retry until port is created */
-    if (!m_portsOrch->getPort(port_name, port) || (port.m_bridge_port_id == SAI_NULL_OBJECT_ID))
+    port = m_portsOrch->findPort(port_name);
+    if (port == nullptr || (port->m_bridge_port_id == SAI_NULL_OBJECT_ID))
     {
         SWSS_LOG_INFO("Saving a fdb entry until port %s becomes active", port_name.c_str());
         saved_fdb_entries[port_name].push_back({entry.mac,
-                vlan.m_vlan_info.vlan_id, fdbData});
+                vlan->m_vlan_info.vlan_id, fdbData});
         return true;
     }
 
@@ -1167,21 +1265,20 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         end_point_ip = fdbData.remote_ip;
     }
     /* Retry until port is member of vlan*/
-    if (!m_portsOrch->isVlanMember(vlan, port, end_point_ip))
+    if (!m_portsOrch->isVlanMember(*vlan, *port, end_point_ip))
     {
-        SWSS_LOG_INFO("Saving a fdb entry until port %s becomes vlan %s member", port_name.c_str(), vlan.m_alias.c_str());
+        SWSS_LOG_INFO("Saving a fdb entry until port %s becomes vlan %s member", port_name.c_str(), vlan->m_alias.c_str());
         saved_fdb_entries[port_name].push_back({entry.mac,
-                vlan.m_vlan_info.vlan_id, fdbData});
+                vlan->m_vlan_info.vlan_id, fdbData});
         return true;
     }
 
-    sai_status_t status;
-    sai_fdb_entry_t fdb_entry;
+    sai_fdb_entry_t &fdb_entry = ctx.fdb_entry;
     fdb_entry.switch_id = gSwitchId;
     memcpy(fdb_entry.mac_address, entry.mac.getMac(), sizeof(sai_mac_t));
     fdb_entry.bv_id = entry.bv_id;
 
-    Port oldPort;
+    const Port *oldPort = nullptr;
     string oldType;
     string oldRemoteIp;
     FdbOrigin oldOrigin = FDB_ORIGIN_INVALID ;
@@ -1195,18 +1292,19 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         oldOrigin = it->second.origin;
         oldRemoteIp = it->second.remote_ip;
 
-        if (!m_portsOrch->getPortByBridgePortId(it->second.bridge_port_id, oldPort))
+        oldPort = m_portsOrch->findPortByBridgePortId(it->second.bridge_port_id);
+        if (oldPort == nullptr)
         {
             SWSS_LOG_ERROR("Existing port 0x%" PRIx64 " details not found", it->second.bridge_port_id);
             return false;
         }
 
-        if ((oldOrigin == fdbData.origin) && (oldType == fdbData.type) && (port.m_bridge_port_id == it->second.bridge_port_id)
+        if ((oldOrigin == fdbData.origin) && (oldType == fdbData.type) && (port->m_bridge_port_id == it->second.bridge_port_id)
             && (oldRemoteIp == fdbData.remote_ip))
         {
             /* Duplicate Mac */
             SWSS_LOG_INFO("FdbOrch: mac=%s %s port=%s type=%s origin=%d  remote_ip=%s is duplicate", entry.mac.to_string().c_str(),
-                    vlan.m_alias.c_str(), port_name.c_str(),
+                    vlan->m_alias.c_str(), port_name.c_str(),
                     fdbData.type.c_str(), fdbData.origin, fdbData.remote_ip.c_str());
             return true;
         }
@@ -1219,7 +1317,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
                 SWSS_LOG_NOTICE("Already existing static MAC:%s in Vlan:%d. "
                         "Received same MAC from peer:%s; "
                         "Peer mac ignored",
-                        entry.mac.to_string().c_str(), vlan.m_vlan_info.vlan_id,
+                        entry.mac.to_string().c_str(), vlan->m_vlan_info.vlan_id,
                         fdbData.remote_ip.c_str());
 
                 return true;
@@ -1231,7 +1329,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
                 SWSS_LOG_INFO("Already existing static MAC:%s in Vlan:%d "
                         "from Peer:%s. Now same is provisioned as dynamic; "
                         "Provisioned dynamic mac is ignored",
-                        entry.mac.to_string().c_str(), vlan.m_vlan_info.vlan_id,
+                        entry.mac.to_string().c_str(), vlan->m_vlan_info.vlan_id,
                         it->second.remote_ip.c_str());
                 return true;
             }
@@ -1243,18 +1341,18 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
                             "in Vlan:%d from Peer:%s, "
                             "If it is a mistake, it will result in inconsistent Traffic Forwarding",
                             entry.mac.to_string().c_str(),
-                            vlan.m_vlan_info.vlan_id,
+                            vlan->m_vlan_info.vlan_id,
                             it->second.remote_ip.c_str());
                 }
             }
             else if ((oldOrigin == FDB_ORIGIN_LEARN) && (fdbData.origin == FDB_ORIGIN_MCLAG_ADVERTIZED))
             {
-                if ((port.m_bridge_port_id == it->second.bridge_port_id) && (oldType == "dynamic") && (fdbData.type == "dynamic_local"))
+                if ((port->m_bridge_port_id == it->second.bridge_port_id) && (oldType == "dynamic") && (fdbData.type == "dynamic_local"))
                 {
                     SWSS_LOG_INFO("FdbOrch: mac=%s %s port=%s type=%s origin=%d old_origin=%d"
                         " old_type=%s local mac exists,"
                         " received dynamic_local from iccpd, ignore update",
-                        entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str(),
+                        entry.mac.to_string().c_str(), vlan->m_alias.c_str(), port_name.c_str(),
                         fdbData.type.c_str(), fdbData.origin, oldOrigin, oldType.c_str());
 
                     return true;
@@ -1276,7 +1374,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     }
 
     sai_attribute_t attr;
-    vector<sai_attribute_t> attrs;
+    vector<sai_attribute_t> &attrs = ctx.fdb_attrs;
 
     attr.id = SAI_FDB_ENTRY_ATTR_TYPE;
     if (fdbData.origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
@@ -1303,7 +1401,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     }
 
     attr.id = SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID;
-    attr.value.oid = port.m_bridge_port_id;
+    attr.value.oid = port->m_bridge_port_id;
     attrs.push_back(attr);
 
     if (fdbData.origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
@@ -1353,16 +1451,24 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     if (macUpdate)
     {
         SWSS_LOG_INFO("MAC-Update FDB %s in %s on from-%s:to-%s from-%s:to-%s origin-%d-to-%d",
-                entry.mac.to_string().c_str(), vlan.m_alias.c_str(), oldPort.m_alias.c_str(),
+                entry.mac.to_string().c_str(), vlan->m_alias.c_str(), oldPort->m_alias.c_str(),
                 port_name.c_str(), oldType.c_str(), fdbData.type.c_str(),
                 oldOrigin, fdbData.origin);
+
+        ctx.mac_update = true;
+        ctx.old_bridge_port_id = oldPort->m_bridge_port_id;
+        ctx.old_type = oldType;
+        ctx.old_origin = oldOrigin;
+
+        /* Attributes are set one by one and the update stops at the first
+         * failing attribute, so MAC updates are not bulked */
         for (auto itr : attrs)
         {
-            status = sai_fdb_api->set_fdb_entry_attribute(&fdb_entry, &itr);
+            sai_status_t status = sai_fdb_api->set_fdb_entry_attribute(&fdb_entry, &itr);
             if (status != SAI_STATUS_SUCCESS)
             {
                 SWSS_LOG_ERROR("macUpdate-Failed for attr.id=0x%x for FDB %s in %s on %s, rv:%d",
-                            itr.id, entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str(), status);
+                            itr.id, entry.mac.to_string().c_str(), vlan->m_alias.c_str(), port_name.c_str(), status);
                 task_process_status handle_status = handleSaiSetStatus(SAI_API_FDB, status);
                 if (handle_status != task_success)
                 {
@@ -1370,34 +1476,69 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
                 }
             }
         }
-        if (oldPort.m_bridge_port_id != port.m_bridge_port_id)
+    }
+    else
+    {
+        SWSS_LOG_INFO("MAC-Create %s FDB %s in %s on %s", fdbData.type.c_str(), entry.mac.to_string().c_str(), vlan->m_alias.c_str(), port_name.c_str());
+
+        ctx.object_statuses.emplace_back();
+        if (ctx.bulk)
+        {
+            gFdbBulker.create_entry(&ctx.object_statuses.back(), &fdb_entry,
+                    (uint32_t)attrs.size(), attrs.data());
+        }
+        else
         {
-            oldPort.m_fdb_count--;
-            m_portsOrch->setPort(oldPort.m_alias, oldPort);
-            port.m_fdb_count++;
-            m_portsOrch->setPort(port.m_alias, port);
+            ctx.object_statuses.back() = sai_fdb_api->create_fdb_entry(&fdb_entry,
+                    (uint32_t)attrs.size(), attrs.data());
+        }
+    }
+
+    /* The port is kept for the post-processing once the entry is queued */
+    ctx.port = *port;
+    ctx.queued = true;
+
+    return true;
+}
+
+bool FdbOrch::addFdbEntryPost(FdbBulkContext& ctx)
+{
+    const FdbEntry& entry = ctx.entry;
+    const string& port_name = ctx.port_name;
+    const FdbData& fdbData = ctx.fdbData;
+    bool macUpdate = ctx.mac_update;
+    FdbOrigin oldOrigin = ctx.old_origin;
+    Port &port = ctx.port;
+
+    SWSS_LOG_ENTER();
+
+    /* The vlan and the port are resolved before the bulk is flushed, so an
+     * entry written to SAI is never retried because of a failed lookup */
+    if (macUpdate)
+    {
+        const Port *oldPort = m_portsOrch->findPortByBridgePortId(ctx.old_bridge_port_id);
+        if (ctx.old_bridge_port_id != port.m_bridge_port_id && oldPort != nullptr)
+        {
+            m_portsOrch->updatePort(oldPort->m_alias, [](Port &p) { p.m_fdb_count--; });
+            m_portsOrch->updatePort(port.m_alias, [&port](Port &p) { port.m_fdb_count = ++p.m_fdb_count; });
         }
     }
     else
     {
-        SWSS_LOG_INFO("MAC-Create %s FDB %s in %s on %s", fdbData.type.c_str(), entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str());
-
-        status = sai_fdb_api->create_fdb_entry(&fdb_entry, (uint32_t)attrs.size(), attrs.data());
+        sai_status_t status = ctx.object_statuses.front();
         if (status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to create %s FDB %s in %s on %s, rv:%d",
                     fdbData.type.c_str(), entry.mac.to_string().c_str(),
-                    vlan.m_alias.c_str(), port_name.c_str(), status);
+                    ctx.vlan_name.c_str(), port_name.c_str(), status);
             task_process_status handle_status = handleSaiCreateStatus(SAI_API_FDB, status); //FIXME: it should be based on status. Some could be retried, some not
             if (handle_status != task_success)
             {
                 return parseHandleSaiStatusFailure(handle_status);
             }
         }
-        port.m_fdb_count++;
-        m_portsOrch->setPort(port.m_alias, port);
-        vlan.m_fdb_count++;
-        m_portsOrch->setPort(vlan.m_alias, vlan);
+        m_portsOrch->updatePort(port.m_alias, [&port](Port &p) { port.m_fdb_count = ++p.m_fdb_count; });
+        m_portsOrch->updatePort(ctx.vlan_name, [](Port &p) { p.m_fdb_count++; });
     }
 
     FdbData storeFdbData = fdbData;
@@ -1413,7 +1554,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
 
     m_entries[entry] = storeFdbData;
 
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
+    string key = "Vlan" + to_string(ctx.vlan_id) + ":" + entry.mac.to_string();
 
     if ((fdbData.origin != FDB_ORIGIN_MCLAG_ADVERTIZED) &&
             (fdbData.origin != FDB_ORIGIN_VXLAN_ADVERTIZED))
@@ -1448,14 +1589,14 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
 
         SWSS_LOG_NOTICE("fdbEvent: AddFdbEntry: Add MCLAG MAC with state mclag remote fdb table "
               "Mac: %s Vlan: %d port:%s type:%s", entry.mac.to_string().c_str(),
-              vlan.m_vlan_info.vlan_id, port_name.c_str(), fdbData.type.c_str());
+              ctx.vlan_id, port_name.c_str(), fdbData.type.c_str());
     }
     else if (macUpdate && (oldOrigin == FDB_ORIGIN_MCLAG_ADVERTIZED) &&
             (fdbData.origin != FDB_ORIGIN_MCLAG_ADVERTIZED))
     {
         SWSS_LOG_NOTICE("fdbEvent: AddFdbEntry: del MCLAG MAC from state MCLAG remote fdb table "
                     "Mac: %s Vlan: %d port:%s type:%s", entry.mac.to_string().c_str(),
-                    vlan.m_vlan_info.vlan_id, port_name.c_str(), fdbData.type.c_str());
+                    ctx.vlan_id, port_name.c_str(), fdbData.type.c_str());
         m_mclagFdbStateTable.del(key);
     }
 
@@ -1477,31 +1618,61 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
 
 bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
 {
-    Port vlan;
-    Port port;
+    SWSS_LOG_ENTER();
+
+    /* A single entry is removed directly, without a bulk of one */
+    FdbBulkContext ctx(entry, origin);
+    ctx.bulk = false;
+
+    if (!removeFdbEntry(ctx))
+    {
+        return false;
+    }
+
+    if (!ctx.queued)
+    {
+        return true;
+    }
+
+    return removeFdbEntryPost(ctx);
+}
+
+bool FdbOrch::removeFdbEntry(FdbBulkContext& ctx)
+{
+    const Port *vlan;
+    const Port *port;
+
+    const FdbEntry& entry = ctx.entry;
+    FdbOrigin origin = ctx.origin;
 
     SWSS_LOG_ENTER();
 
     SWSS_LOG_INFO("FdbOrch RemoveFDBEntry: mac=%s bv_id=0x%" PRIx64 "origin %d", entry.mac.to_string().c_str(), entry.bv_id, origin);
 
-    if (!m_portsOrch->getPort(entry.bv_id, vlan))
+    vlan = m_portsOrch->findPort(entry.bv_id);
+    if (vlan == nullptr)
     {
         SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate vlan port from bv_id 0x%" PRIx64, entry.bv_id);
         return false;
     }
 
+    ctx.vlan_id = vlan->m_vlan_info.vlan_id;
+    ctx.vlan_name = vlan->m_alias;
+
     auto it= m_entries.find(entry);
     if (it == m_entries.end())
     {
         SWSS_LOG_INFO("FdbOrch RemoveFDBEntry: FDB entry isn't found. mac=%s bv_id=0x%" PRIx64, entry.mac.to_string().c_str(), entry.bv_id);
 
         /* check whether the entry is in the saved fdb, if so delete it from there. */
-        deleteFdbEntryFromSavedFDB(entry.mac, vlan.m_vlan_info.vlan_id, origin);
+        deleteFdbEntryFromSavedFDB(entry.mac, vlan->m_vlan_info.vlan_id, origin);
         return true;
     }
 
-    FdbData fdbData = it->second;
-    if (!m_portsOrch->getPortByBridgePortId(fdbData.bridge_port_id, port))
+    FdbData &fdbData = ctx.fdbData;
+    fdbData = it->second;
+    port = m_portsOrch->findPortByBridgePortId(fdbData.bridge_port_id);
+    if (port == nullptr)
     {
         SWSS_LOG_NOTICE("FdbOrch RemoveFDBEntry: Failed to locate port from bridge_port_id 0x%" PRIx64, fdbData.bridge_port_id);
         return false;
@@ -1510,12 +1681,12 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
     if (fdbData.origin != origin)
     {
         if ((origin == FDB_ORIGIN_MCLAG_ADVERTIZED) && (fdbData.origin == FDB_ORIGIN_LEARN) &&
-                        (port.m_oper_status == SAI_PORT_OPER_STATUS_DOWN) && (gMlagOrch->isMlagInterface(port.m_alias)))
+                        (port->m_oper_status == SAI_PORT_OPER_STATUS_DOWN) && (gMlagOrch->isMlagInterface(port->m_alias)))
         {
             //check if the local MCLAG port is down, if yes then continue delete the local MAC
             origin = FDB_ORIGIN_LEARN;
             SWSS_LOG_INFO("FdbOrch RemoveFDBEntry: mac=%s fdb del origin is MCLAG; delete local mac as port %s is down",
-                entry.mac.to_string().c_str(), port.m_alias.c_str());
+                entry.mac.to_string().c_str(), port->m_alias.c_str());
         }
         else
         {
@@ -1529,23 +1700,44 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
                     entry.mac.to_string().c_str(), fdbData.origin, origin);
 
             /* We may still have the mac in saved-fdb probably due to unavailability
-             * of bridge-port. check whether the entry is in the saved fdb,
+             * of bridge-port-> check whether the entry is in the saved fdb,
              * if so delete it from there. */
-            deleteFdbEntryFromSavedFDB(entry.mac, vlan.m_vlan_info.vlan_id, origin);
+            deleteFdbEntryFromSavedFDB(entry.mac, vlan->m_vlan_info.vlan_id, origin);
 
             return true;
         }
     }
 
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
-
-    sai_status_t status;
-    sai_fdb_entry_t fdb_entry;
+    sai_fdb_entry_t &fdb_entry = ctx.fdb_entry;
     fdb_entry.switch_id = gSwitchId;
     memcpy(fdb_entry.mac_address, entry.mac.getMac(), sizeof(sai_mac_t));
     fdb_entry.bv_id = entry.bv_id;
 
-    status = sai_fdb_api->remove_fdb_entry(&fdb_entry);
+    ctx.object_statuses.emplace_back();
+    if (ctx.bulk)
+    {
+        gFdbBulker.remove_entry(&ctx.object_statuses.back(), &fdb_entry);
+    }
+    else
+    {
+        ctx.object_statuses.back() = sai_fdb_api->remove_fdb_entry(&fdb_entry);
+    }
+
+    /* The port is kept for the post-processing once the entry is queued */
+    ctx.port = *port;
+    ctx.queued = true;
+
+    return true;
+}
+
+bool FdbOrch::removeFdbEntryPost(FdbBulkContext& ctx)
+{
+    const FdbEntry& entry = ctx.entry;
+    const FdbData& fdbData = ctx.fdbData;
+
+    SWSS_LOG_ENTER();
+
+    sai_status_t status = ctx.object_statuses.front();
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("FdbOrch RemoveFDBEntry: Failed to remove FDB entry. mac=%s, bv_id=0x%" PRIx64,
@@ -1557,13 +1749,16 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
         }
     }
 
+    /* The vlan and the bridge port are resolved before the bulk is flushed,
+     * the entry is gone from SAI and is not retried from here on */
+    Port &port = ctx.port;
+    string key = "Vlan" + to_string(ctx.vlan_id) + ":" + entry.mac.to_string();
+
     SWSS_LOG_INFO("Removed mac=%s bv_id=0x%" PRIx64 " port:%s",
             entry.mac.to_string().c_str(), entry.bv_id, port.m_alias.c_str());
 
-    port.m_fdb_count--;
-    m_portsOrch->setPort(port.m_alias, port);
-    vlan.m_fdb_count--;
-    m_portsOrch->setPort(vlan.m_alias, vlan);
+    m_portsOrch->updatePort(port.m_alias, [&port](Port &p) { port.m_fdb_count = --p.m_fdb_count; });
+    m_portsOrch->updatePort(ctx.vlan_name, [](Port &p) { p.m_fdb_count--; });
     (void)m_entries.erase(entry);
 
     // Remove in StateDb
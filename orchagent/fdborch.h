@@ -4,6 +4,7 @@
 #include "orch.h"
 #include "observer.h"
 #include "portsorch.h"
+#include "bulker.h"
 
 enum FdbOrigin
 {
@@ -77,6 +78,47 @@ struct SavedFdbEntry
 
 typedef unordered_map<string, vector<SavedFdbEntry>> fdb_entries_by_port_t;
 
+struct FdbBulkContext
+{
+    std::deque<sai_status_t>            object_statuses;    // Bulk statuses
+    FdbEntry                            entry;              // FDB entry to process
+    string                              port_name;          // Port the MAC is provisioned on
+    FdbData                             fdbData;            // Requested (SET) or existing (DEL) FDB data
+    FdbOrigin                           origin;             // Origin of the DEL request
+    bool                                add;                // Add (SET) or remove (DEL) FDB entry
+    bool                                bulk;               // SAI operation goes through the FDB bulker
+    bool                                queued;             // SAI operation is issued, post-processing is pending
+    bool                                mac_update;         // Existing FDB entry is updated
+    sai_object_id_t                     old_bridge_port_id; // Bridge port of the updated FDB entry
+    string                              old_type;           // Type of the updated FDB entry
+    FdbOrigin                           old_origin;         // Origin of the updated FDB entry
+    unsigned short                      vlan_id;            // VLAN ID of the FDB entry
+    string                              vlan_name;          // VLAN of the FDB entry, resolved before the bulk
+    Port                                port;               // Port of the FDB entry, resolved before the bulk
+    string                              vlan_name;          // VLAN of the FDB entry, resolved before the bulk
+    Port                                port;               // Port of the FDB entry, resolved before the bulk
+    sai_fdb_entry_t                     fdb_entry;          // SAI FDB entry
+    std::vector<sai_attribute_t>        fdb_attrs;          // SAI FDB attributes
+
+    FdbBulkContext(const FdbEntry &entry, const string &port_name, const FdbData &fdbData)
+        : entry(entry), port_name(port_name), fdbData(fdbData), origin(fdbData.origin),
+          add(true), bulk(true), queued(false), mac_update(false), old_bridge_port_id(SAI_NULL_OBJECT_ID),
+          old_origin(FDB_ORIGIN_INVALID), vlan_id(0)
+    {
+    }
+
+    FdbBulkContext(const FdbEntry &entry, FdbOrigin origin)
+        : entry(entry), origin(origin),
+          add(false), bulk(true), queued(false), mac_update(false), old_bridge_port_id(SAI_NULL_OBJECT_ID),
+          old_origin(FDB_ORIGIN_INVALID), vlan_id(0)
+    {
+    }
+
+    // Disable any copy constructors
+    FdbBulkContext(const FdbBulkContext&) = delete;
+    FdbBulkContext(FdbBulkContext&&) = delete;
+};
+
 class FdbOrch: public Orch, public Subject, public Observer
 {
 public:
@@ -110,6 +152,7 @@ private:
     Table m_mclagFdbStateTable;
     NotificationConsumer* m_flushNotificationsConsumer;
     NotificationConsumer* m_fdbNotificationConsumer;
+    EntityBulker<sai_fdb_api_t> gFdbBulker;
 
     void doTask(Consumer& consumer);
     void doTask(NotificationConsumer& consumer);
@@ -118,6 +161,11 @@ private:
     void updatePortOperState(const PortOperStateUpdate&);
 
     bool addFdbEntry(const FdbEntry&, const string&, FdbData fdbData);
+    bool addFdbEntry(FdbBulkContext& ctx);
+    bool addFdbEntryPost(FdbBulkContext& ctx);
+    bool removeFdbEntry(FdbBulkContext& ctx);
+    bool removeFdbEntryPost(FdbBulkContext& ctx);
+    void doFdbEntryDone(const FdbBulkContext& ctx);
     void deleteFdbEntryFromSavedFDB(const MacAddress &mac, const unsigned short &vlanId, FdbOrigin origin, const string portName="");
 
     bool storeFdbEntryState(const FdbUpdate& update);
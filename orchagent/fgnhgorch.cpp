@@ -1128,7 +1128,7 @@ bool FgNhgOrch::isRouteFineGrained(sai_object_id_t vrf_id, const IpPrefix &ipPre
     }
 
     FgNhgEntry *fgNhgEntry = 0;
-    set<NextHopKey> next_hop_set = nextHops.getNextHops();
+    const set<NextHopKey> &next_hop_set = nextHops.getNextHops();
     auto prefix_entry = m_fgNhgPrefixes.find(ipPrefix);
     if (prefix_entry == m_fgNhgPrefixes.end())
     {
@@ -1468,7 +1468,7 @@ vector<FieldValueTuple> FgNhgOrch::generateRouteTableFromNhgKey(NextHopGroupKey
 {
     SWSS_LOG_ENTER();
     vector<FieldValueTuple> fvVector;
-    std::set<NextHopKey> nhks = nhg.getNextHops();
+    const std::set<NextHopKey> &nhks = nhg.getNextHops();
     string nexthops = nhks.begin()->ip_address.to_string();
     string ifnames = nhks.begin()->alias;
 
@@ -17,6 +17,7 @@ using std::vector;
 using swss::DBConnector;
 using swss::FieldValueTuple;
 using swss::ProducerTable;
+using swss::RedisPipeline;
 
 const string FLEX_COUNTER_ENABLE("enable");
 const string FLEX_COUNTER_DISABLE("disable");
@@ -48,6 +49,19 @@ const unordered_map<CounterType, string> FlexCounterManager::counter_id_field_lo
 
 FlexManagerDirectory g_FlexManagerDirectory;
 
+// getFlexCounterPipeline returns the pipeline that all the managers write
+// FLEX_COUNTER_DB through, so that they share a single connection.
+static shared_ptr<RedisPipeline> getFlexCounterPipeline()
+{
+    static shared_ptr<RedisPipeline> pipeline;
+    if (!pipeline)
+    {
+        DBConnector db("FLEX_COUNTER_DB", 0);
+        pipeline = std::make_shared<RedisPipeline>(&db);
+    }
+    return pipeline;
+}
+
 FlexCounterManager *FlexManagerDirectory::createFlexCounterManager(const string& group_name,
                                                                    const StatsMode stats_mode,
                                                                    const uint polling_interval,
@@ -93,9 +107,9 @@ FlexCounterManager::FlexCounterManager(
     polling_interval(polling_interval),
     enabled(enabled),
     fv_plugin(fv_plugin),
-    flex_counter_db(new DBConnector("FLEX_COUNTER_DB", 0)),
-    flex_counter_group_table(new ProducerTable(flex_counter_db.get(), FLEX_COUNTER_GROUP_TABLE)),
-    flex_counter_table(new ProducerTable(flex_counter_db.get(), FLEX_COUNTER_TABLE))
+    flex_counter_pipeline(getFlexCounterPipeline()),
+    flex_counter_group_table(new ProducerTable(flex_counter_pipeline.get(), FLEX_COUNTER_GROUP_TABLE)),
+    flex_counter_table(new ProducerTable(flex_counter_pipeline.get(), FLEX_COUNTER_TABLE))
 {
     SWSS_LOG_ENTER();
 
@@ -108,9 +122,12 @@ FlexCounterManager::~FlexCounterManager()
 {
     SWSS_LOG_ENTER();
 
-    for (const auto& counter: installed_counters)
     {
-        flex_counter_table->del(getFlexCounterTableKey(group_name, counter));
+        FlexCounterBulk bulk(*this);
+        for (const auto& counter: installed_counters)
+        {
+            flex_counter_table->del(getFlexCounterTableKey(group_name, counter));
+        }
     }
 
     flex_counter_group_table->del(group_name);
@@ -225,6 +242,90 @@ void FlexCounterManager::setCounterIdList(
             group_name.c_str());
 }
 
+// beginBulk starts buffering the counter id list updates, until the matching
+// commitBulk.
+void FlexCounterManager::beginBulk()
+{
+    SWSS_LOG_ENTER();
+
+    if (bulk_depth++ == 0)
+    {
+        flex_counter_table->setBuffered(true);
+    }
+}
+
+// commitBulk writes the buffered counter id list updates once the outermost
+// bulk is committed.
+void FlexCounterManager::commitBulk()
+{
+    SWSS_LOG_ENTER();
+
+    if (bulk_depth == 0)
+    {
+        SWSS_LOG_WARN("No bulk to commit in group '%s'.", group_name.c_str());
+        return;
+    }
+
+    if (--bulk_depth == 0)
+    {
+        flex_counter_table->flush();
+        flex_counter_table->setBuffered(false);
+    }
+}
+
+FlexCounterBulk::FlexCounterBulk(FlexCounterManager& manager) :
+    manager(manager)
+{
+    manager.beginBulk();
+}
+
+FlexCounterBulk::~FlexCounterBulk()
+{
+    try
+    {
+        manager.commitBulk();
+    }
+    catch (const std::exception& e)
+    {
+        SWSS_LOG_ERROR("Failed to commit flex counter bulk of group '%s': %s",
+                manager.getGroupName().c_str(), e.what());
+    }
+}
+
+void FlexCounterManager::setCounterIdListBulk(
+        const vector<sai_object_id_t>& object_ids,
+        const CounterType counter_type,
+        const unordered_set<string>& counter_stats)
+{
+    SWSS_LOG_ENTER();
+
+    auto counter_type_it = counter_id_field_lookup.find(counter_type);
+    if (counter_type_it == counter_id_field_lookup.end())
+    {
+        SWSS_LOG_ERROR("Could not update flex counter id list for group '%s': counter type not found.",
+                group_name.c_str());
+        return;
+    }
+
+    std::vector<swss::FieldValueTuple> field_values =
+    {
+        FieldValueTuple(counter_type_it->second, serializeCounterStats(counter_stats))
+    };
+
+    {
+        FlexCounterBulk bulk(*this);
+        for (const auto& object_id : object_ids)
+        {
+            flex_counter_table->set(getFlexCounterTableKey(group_name, object_id), field_values);
+            installed_counters.insert(object_id);
+        }
+    }
+
+    SWSS_LOG_DEBUG("Updated flex counter id list for %zu objects in group '%s'.",
+            object_ids.size(),
+            group_name.c_str());
+}
+
 // clearCounterIdList clears all stats that are currently being polled from
 // the given object.
 void FlexCounterManager::clearCounterIdList(const sai_object_id_t object_id)
@@ -243,6 +344,12 @@ void FlexCounterManager::clearCounterIdList(const sai_object_id_t object_id)
     flex_counter_table->del(getFlexCounterTableKey(group_name, object_id));
     installed_counters.erase(counter_it);
 
+    // syncd must stop polling the object before the caller removes it
+    if (bulk_depth > 0)
+    {
+        flex_counter_table->flush();
+    }
+
     SWSS_LOG_DEBUG("Cleared flex counter id list for object '%" PRIu64 "' in group '%s'.",
             object_id,
             group_name.c_str());
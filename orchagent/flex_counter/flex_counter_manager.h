@@ -5,7 +5,9 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 #include "dbconnector.h"
+#include "redispipeline.h"
 #include "producertable.h"
 #include "table.h"
 #include <inttypes.h>
@@ -65,6 +67,23 @@ class FlexCounterManager
                 const std::unordered_set<std::string>& counter_stats);
         void clearCounterIdList(const sai_object_id_t object_id);
 
+        // Counter id lists set between beginBulk() and commitBulk() are
+        // written to FLEX_COUNTER_DB in pipelined batches rather than one
+        // round trip each. Bulks may be nested, the writes are committed by
+        // the outermost commitBulk(). Prefer FlexCounterBulk to calling these.
+        //
+        // Clearing a counter id list is written right away, along with the
+        // updates buffered before it, as the caller removes the object next.
+        void beginBulk();
+        void commitBulk();
+
+        // setCounterIdListBulk configures the same stats on all the given
+        // objects, in one bulk.
+        void setCounterIdListBulk(
+                const std::vector<sai_object_id_t>& object_ids,
+                const CounterType counter_type,
+                const std::unordered_set<std::string>& counter_stats);
+
         const std::string& getGroupName() const
         {
             return group_name;
@@ -101,8 +120,10 @@ class FlexCounterManager
         bool enabled;
         swss::FieldValueTuple fv_plugin;
         std::unordered_set<sai_object_id_t> installed_counters;
+        uint32_t bulk_depth = 0;
 
-        std::shared_ptr<swss::DBConnector> flex_counter_db = nullptr;
+        // Shared by all the managers, see getFlexCounterPipeline()
+        std::shared_ptr<swss::RedisPipeline> flex_counter_pipeline = nullptr;
         std::shared_ptr<swss::ProducerTable> flex_counter_group_table = nullptr;
         std::shared_ptr<swss::ProducerTable> flex_counter_table = nullptr;
 
@@ -111,6 +132,21 @@ class FlexCounterManager
         static const std::unordered_map<CounterType, std::string> counter_id_field_lookup;
 };
 
+// FlexCounterBulk holds a bulk of the given manager for its lifetime, so
+// that it is committed even if an exception is thrown.
+class FlexCounterBulk
+{
+    public:
+        explicit FlexCounterBulk(FlexCounterManager& manager);
+        ~FlexCounterBulk();
+
+        FlexCounterBulk(const FlexCounterBulk&) = delete;
+        FlexCounterBulk& operator=(const FlexCounterBulk&) = delete;
+
+    private:
+        FlexCounterManager& manager;
+};
+
 class FlexManagerDirectory
 {
     public:
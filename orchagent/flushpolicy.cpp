@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <sstream>
+
+#include "flushpolicy.h"
+
+using namespace std;
+
+void FlushHistogram::add(uint64_t value)
+{
+    size_t idx = 0;
+    while (idx < BUCKETS - 1 && (1ULL << idx) < value)
+    {
+        idx++;
+    }
+
+    m_buckets[idx]++;
+    m_count++;
+}
+
+string FlushHistogram::toString() const
+{
+    ostringstream ss;
+    bool first = true;
+
+    for (size_t idx = 0; idx < BUCKETS; idx++)
+    {
+        if (m_buckets[idx] == 0)
+        {
+            continue;
+        }
+
+        if (!first)
+        {
+            ss << " ";
+        }
+        first = false;
+
+        if (idx == BUCKETS - 1)
+        {
+            ss << ">" << (1ULL << (idx - 1)) << ":" << m_buckets[idx];
+        }
+        else
+        {
+            ss << "<=" << (1ULL << idx) << ":" << m_buckets[idx];
+        }
+    }
+
+    return ss.str();
+}
+
+FlushPolicy::FlushPolicy(size_t maxPendingOps, uint32_t maxLatencyMs) :
+        m_maxPendingOps(maxPendingOps),
+        m_maxLatency(maxLatencyMs)
+{
+}
+
+void FlushPolicy::addPending(size_t ops, const time_point &now)
+{
+    if (!m_dirty)
+    {
+        m_dirty = true;
+        m_firstPending = now;
+    }
+
+    m_pendingOps += ops;
+}
+
+bool FlushPolicy::isFlushDue(const time_point &now) const
+{
+    if (!m_dirty)
+    {
+        return false;
+    }
+
+    return m_pendingOps >= m_maxPendingOps || now - m_firstPending >= m_maxLatency;
+}
+
+int FlushPolicy::getTimeout(const time_point &now) const
+{
+    if (!m_dirty)
+    {
+        return -1;
+    }
+
+    auto left = chrono::duration_cast<chrono::milliseconds>(m_firstPending + m_maxLatency - now).count();
+    return static_cast<int>(max<int64_t>(left, 0));
+}
+
+void FlushPolicy::onFlush(const time_point &now)
+{
+    if (!m_dirty)
+    {
+        return;
+    }
+
+    auto latency = chrono::duration_cast<chrono::milliseconds>(now - m_firstPending).count();
+
+    m_batchSize.add(m_pendingOps);
+    m_latencyMs.add(static_cast<uint64_t>(max<int64_t>(latency, 0)));
+
+    m_dirty = false;
+    m_pendingOps = 0;
+}
+
+void FlushPolicy::dump(vector<string> &ts) const
+{
+    ts.push_back("flushes:" + to_string(m_batchSize.getCount()));
+    ts.push_back("batch size " + m_batchSize.toString());
+    ts.push_back("latency ms " + m_latencyMs.toString());
+}
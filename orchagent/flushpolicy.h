@@ -0,0 +1,91 @@
+#ifndef SWSS_FLUSHPOLICY_H
+#define SWSS_FLUSHPOLICY_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * Histogram with power of two buckets: bucket i counts the values in
+ * (2^(i-1), 2^i], bucket 0 counts 0 and 1, the last bucket is open ended.
+ */
+class FlushHistogram
+{
+public:
+    static const size_t BUCKETS = 20;
+
+    void add(uint64_t value);
+
+    uint64_t getCount() const
+    {
+        return m_count;
+    }
+
+    uint64_t getBucket(size_t idx) const
+    {
+        return m_buckets.at(idx);
+    }
+
+    /* Non-empty buckets as "<=upper:count", the last one as ">lower:count" */
+    std::string toString() const;
+
+private:
+    std::array<uint64_t, BUCKETS> m_buckets{};
+    uint64_t m_count = 0;
+};
+
+/*
+ * Decides when OrchDaemon flushes the sairedis pipeline: as soon as
+ * maxPendingOps tasks were applied since the last flush, or maxLatencyMs
+ * after the first task that was not flushed yet, whichever comes first.
+ */
+class FlushPolicy
+{
+public:
+    typedef std::chrono::steady_clock::time_point time_point;
+
+    FlushPolicy(size_t maxPendingOps, uint32_t maxLatencyMs);
+
+    /* Account ops which queued SAI calls, the first one starts the latency clock */
+    void addPending(size_t ops, const time_point &now);
+
+    bool hasPending() const
+    {
+        return m_dirty;
+    }
+
+    bool isFlushDue(const time_point &now) const;
+
+    /* Milliseconds until the latency target expires, -1 if nothing is pending */
+    int getTimeout(const time_point &now) const;
+
+    /* Record the batch being flushed and start over */
+    void onFlush(const time_point &now);
+
+    const FlushHistogram &getBatchSizeHistogram() const
+    {
+        return m_batchSize;
+    }
+
+    const FlushHistogram &getLatencyHistogram() const
+    {
+        return m_latencyMs;
+    }
+
+    void dump(std::vector<std::string> &ts) const;
+
+private:
+    size_t m_maxPendingOps;
+    std::chrono::milliseconds m_maxLatency;
+
+    bool m_dirty = false;
+    size_t m_pendingOps = 0;
+    time_point m_firstPending;
+
+    FlushHistogram m_batchSize;
+    FlushHistogram m_latencyMs;
+};
+
+#endif /* SWSS_FLUSHPOLICY_H */
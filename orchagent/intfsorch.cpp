@@ -75,7 +75,8 @@ IntfsOrch::IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch, DBCon
     auto executorT = new ExecutableTimer(m_updateMapsTimer, this, "UPDATE_MAPS_TIMER");
     Orch::addExecutor(executorT);
     /* Initialize FLEX_COUNTER_DB tables */
-    m_flexCounterTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_TABLE));
+    m_flexCounterPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(m_flex_db.get()));
+    m_flexCounterTable = unique_ptr<ProducerTable>(new ProducerTable(m_flexCounterPipeline.get(), FLEX_COUNTER_TABLE));
     m_flexCounterGroupTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_GROUP_TABLE));
 
     vector<FieldValueTuple> fieldValues;
@@ -1454,6 +1455,10 @@ void IntfsOrch::doTask(SelectableTimer &timer)
 
     SWSS_LOG_DEBUG("Registering %" PRId64 " new intfs", m_rifsToAdd.size());
     string value;
+
+    /* Counters of the ready intfs are written to FLEX_COUNTER_DB in pipelined batches */
+    m_flexCounterTable->setBuffered(true);
+
     for (auto it = m_rifsToAdd.begin(); it != m_rifsToAdd.end(); )
     {
         const auto id = sai_serialize_object_id(it->m_rif_id);
@@ -1488,6 +1493,9 @@ void IntfsOrch::doTask(SelectableTimer &timer)
             ++it;
         }
     }
+
+    m_flexCounterTable->flush();
+    m_flexCounterTable->setBuffered(false);
 }
 
 bool IntfsOrch::isRemoteSystemPortIntf(string alias)
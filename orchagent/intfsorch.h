@@ -5,6 +5,7 @@
 #include "portsorch.h"
 #include "vrforch.h"
 #include "timer.h"
+#include "redispipeline.h"
 
 #include "ipaddresses.h"
 #include "ipprefix.h"
@@ -86,6 +87,7 @@ private:
     unique_ptr<Table> m_rifNameTable;
     unique_ptr<Table> m_rifTypeTable;
     unique_ptr<Table> m_vidToRidTable;
+    unique_ptr<RedisPipeline> m_flexCounterPipeline;
     unique_ptr<ProducerTable> m_flexCounterTable;
     unique_ptr<ProducerTable> m_flexCounterGroupTable;
 
@@ -50,6 +50,8 @@ MacAddress gMacAddress;
 MacAddress gVxlanMacAddress;
 
 extern size_t gMaxBulkSize;
+extern size_t gFlushBatchSize;
+extern uint32_t gFlushLatencyMs;
 
 #define DEFAULT_BATCH_SIZE  128
 int gBatchSize = DEFAULT_BATCH_SIZE;
@@ -84,7 +86,7 @@ string gMyAsicName = "";
 
 void usage()
 {
-    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-k bulk_size]" << endl;
+    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-k bulk_size] [-n flush_batch_size] [-l flush_latency_ms]" << endl;
     cout << "    -h: display this message" << endl;
     cout << "    -r record_type: record orchagent logs with type (default 3)" << endl;
     cout << "                    Bit 0: sairedis.rec, Bit 1: swss.rec, Bit 2: responsepublisher.rec. For example:" << endl;
@@ -102,6 +104,8 @@ void usage()
     cout << "    -f swss_rec_filename: swss record log filename(default 'swss.rec')" << endl;
     cout << "    -j sairedis_rec_filename: sairedis record log filename(default sairedis.rec)" << endl;
     cout << "    -k max bulk size in bulk mode (default 1000)" << endl;
+    cout << "    -n flush the sairedis pipeline after this many tasks (default 1000)" << endl;
+    cout << "    -l flush the sairedis pipeline at most this many ms after the first unflushed task (default 50)" << endl;
 }
 
 void sighup_handler(int signo)
@@ -337,7 +341,7 @@ int main(int argc, char **argv)
     string responsepublisher_rec_filename = "responsepublisher.rec";
     int record_type = 3; // Only swss and sairedis recordings enabled by default.
 
-    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hsz:k:")) != -1)
+    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hsz:k:n:l:")) != -1)
     {
         switch (opt)
         {
@@ -415,6 +419,34 @@ int main(int argc, char **argv)
                 }
             }
             break;
+        case 'n':
+            {
+                auto size = atoi(optarg);
+                if (size > 0)
+                {
+                    gFlushBatchSize = size;
+                    SWSS_LOG_NOTICE("Setting sairedis flush batch size as %zu", gFlushBatchSize);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for sairedis flush batch size: %d. Ignoring.", size);
+                }
+            }
+            break;
+        case 'l':
+            {
+                auto latency = atoi(optarg);
+                if (latency > 0)
+                {
+                    gFlushLatencyMs = latency;
+                    SWSS_LOG_NOTICE("Setting sairedis flush latency as %u ms", gFlushLatencyMs);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for sairedis flush latency: %d. Ignoring.", latency);
+                }
+            }
+            break;
         default: /* '?' */
             exit(EXIT_FAILURE);
         }
@@ -21,6 +21,7 @@ extern FgNhgOrch *gFgNhgOrch;
 extern Directory<Orch*> gDirectory;
 extern string gMySwitchType;
 extern int32_t gVoqMySwitchId;
+extern size_t gMaxBulkSize;
 
 const int neighorch_pri = 30;
 
@@ -29,7 +30,9 @@ NeighOrch::NeighOrch(DBConnector *appDb, string tableName, IntfsOrch *intfsOrch,
         m_intfsOrch(intfsOrch),
         m_fdbOrch(fdbOrch),
         m_portsOrch(portsOrch),
-        m_appNeighResolveProducer(appDb, APP_NEIGH_RESOLVE_TABLE_NAME)
+        m_appNeighResolveProducer(appDb, APP_NEIGH_RESOLVE_TABLE_NAME),
+        gNeighBulker(sai_neighbor_api, gMaxBulkSize),
+        gNextHopBulker(sai_next_hop_api, gSwitchId, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
 
@@ -113,22 +116,22 @@ void NeighOrch::processFDBFlushUpdate(const FdbFlushUpdate& update)
     for (auto entry : update.entries)
     {
         // Get Vlan object
-        Port vlan;
-        if (!m_portsOrch->getPort(entry.bv_id, vlan))
+        const Port *vlan = m_portsOrch->findPort(entry.bv_id);
+        if (vlan == nullptr)
         {
             SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate vlan port \
                              from bv_id 0x%" PRIx64 ".", entry.bv_id);
             continue;
         }
         SWSS_LOG_INFO("Flushing ARP for port: %s, VLAN: %s",
-                      vlan.m_alias.c_str(), update.port.m_alias.c_str());
+                      vlan->m_alias.c_str(), update.port.m_alias.c_str());
 
         // If the FDB entry MAC matches with neighbor/ARP entry MAC,
         // and ARP entry incoming interface matches with VLAN name,
         // flush neighbor/arp entry.
         for (const auto &neighborEntry : m_syncdNeighbors)
         {
-            if (neighborEntry.first.alias == vlan.m_alias &&
+            if (neighborEntry.first.alias == vlan->m_alias &&
                 neighborEntry.second.mac == entry.mac)
             {
                 resolveNeighborEntry(neighborEntry.first, neighborEntry.second.mac);
@@ -185,16 +188,17 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
 {
     SWSS_LOG_ENTER();
 
-    Port p;
-    if (!gPortsOrch->getPort(nh.alias, p))
+    const Port *p = gPortsOrch->findPort(nh.alias);
+    if (p == nullptr)
     {
         SWSS_LOG_ERROR("Neighbor %s seen on port %s which doesn't exist",
                         nh.ip_address.to_string().c_str(), nh.alias.c_str());
         return false;
     }
-    if (p.m_type == Port::SUBPORT)
+    if (p->m_type == Port::SUBPORT)
     {
-        if (!gPortsOrch->getPort(p.m_parent_port_id, p))
+        p = gPortsOrch->findPort(p->m_parent_port_id);
+        if (p == nullptr)
         {
             SWSS_LOG_ERROR("Neighbor %s seen on sub interface %s whose parent port doesn't exist",
                             nh.ip_address.to_string().c_str(), nh.alias.c_str());
@@ -264,6 +268,14 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
         }
     }
 
+    addNextHopPost(nexthop, next_hop_id, p->m_oper_status == SAI_PORT_OPER_STATUS_DOWN);
+    return true;
+}
+
+void NeighOrch::addNextHopPost(const NextHopKey &nexthop, sai_object_id_t next_hop_id, bool if_down)
+{
+    SWSS_LOG_ENTER();
+
     SWSS_LOG_NOTICE("Created next hop %s on %s",
                     nexthop.ip_address.to_string().c_str(), nexthop.alias.c_str());
     if (m_neighborToResolve.find(nexthop) != m_neighborToResolve.end())
@@ -303,7 +315,7 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
     // flag should be set on it.
     // This scenario may happen under race condition where buffered neighbor event
     // is processed after incoming port is down.
-    if (p.m_oper_status == SAI_PORT_OPER_STATUS_DOWN)
+    if (if_down)
     {
         if (setNextHopFlag(nexthop, NHFLAGS_IFDOWN) == false)
         {
@@ -311,7 +323,6 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
                 nexthop.ip_address.to_string().c_str(), nexthop.alias.c_str());
         }
     }
-    return true;
 }
 
 bool NeighOrch::setNextHopFlag(const NextHopKey &nexthop, const uint32_t nh_flag)
@@ -602,17 +613,39 @@ bool NeighOrch::getNeighborEntry(const NextHopKey &nexthop, NeighborEntry &neigh
         return false;
     }
 
-    for (const auto &entry : m_syncdNeighbors)
+    auto it = m_syncdNeighborIndex.find(NeighborIndexKey(nexthop.ip_address, nexthop.alias));
+    if (it == m_syncdNeighborIndex.end())
     {
-        if (entry.first.ip_address == nexthop.ip_address && entry.first.alias == nexthop.alias)
-        {
-            neighborEntry = entry.first;
-            macAddress = entry.second.mac;
-            return true;
-        }
+        return false;
     }
 
-    return false;
+    neighborEntry = it->second->first;
+    macAddress = it->second->second.mac;
+    return true;
+}
+
+NeighborTable::iterator NeighOrch::insertSyncdNeighbor(const NeighborEntry &neighborEntry)
+{
+    auto it = m_syncdNeighbors.emplace(neighborEntry, NeighborData()).first;
+    m_syncdNeighborIndex.emplace(NeighborIndexKey(neighborEntry.ip_address, neighborEntry.alias), it);
+    return it;
+}
+
+void NeighOrch::eraseSyncdNeighbor(const NeighborEntry &neighborEntry)
+{
+    auto it = m_syncdNeighbors.find(neighborEntry);
+    if (it == m_syncdNeighbors.end())
+    {
+        return;
+    }
+
+    auto index = m_syncdNeighborIndex.find(NeighborIndexKey(neighborEntry.ip_address, neighborEntry.alias));
+    if (index != m_syncdNeighborIndex.end() && index->second == it)
+    {
+        m_syncdNeighborIndex.erase(index);
+    }
+
+    m_syncdNeighbors.erase(it);
 }
 
 bool NeighOrch::getNeighborEntry(const IpAddress &ipAddress, NeighborEntry &neighborEntry, MacAddress &macAddress)
@@ -627,6 +660,21 @@ bool NeighOrch::getNeighborEntry(const IpAddress &ipAddress, NeighborEntry &neig
     return getNeighborEntry(nexthop, neighborEntry, macAddress);
 }
 
+/*
+ * Remove remaining DEL operation in m_toSync for the same neighbor.
+ * Since DEL operation is supposed to be executed before SET for the same neighbor
+ * A remaining DEL after the SET operation means the DEL operation failed previously and should not be executed anymore
+ */
+static void removePendingNeighborDel(Consumer &consumer, SyncMap::iterator it, const string &key)
+{
+    auto rit = make_reverse_iterator(it);
+    while (rit != consumer.m_toSync.rend() && rit->first == key && kfvOp(rit->second) == DEL_COMMAND)
+    {
+        consumer.m_toSync.erase(next(rit).base());
+        SWSS_LOG_NOTICE("Removed pending neighbor DEL operation for %s after SET operation", key.c_str());
+    }
+}
+
 void NeighOrch::doTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
@@ -646,132 +694,175 @@ void NeighOrch::doTask(Consumer &consumer)
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
-
-        string key = kfvKey(t);
-        string op = kfvOp(t);
+        // Neighbor bulk results will be stored in a map
+        std::map<
+                std::string,                    // Key
+                NeighborBulkContext
+        >                                       toBulk;
 
-        size_t found = key.find(':');
-        if (found == string::npos)
+        // Add or remove neighbors with the neighbor and next hop bulkers
+        while (it != consumer.m_toSync.end())
         {
-            SWSS_LOG_ERROR("Failed to parse key %s", key.c_str());
-            it = consumer.m_toSync.erase(it);
-            continue;
-        }
+            KeyOpFieldsValuesTuple t = it->second;
 
-        string alias = key.substr(0, found);
+            string key = kfvKey(t);
+            string op = kfvOp(t);
 
-        if (alias == "eth0" || alias == "lo" || alias == "docker0"
-            || ((op == SET_COMMAND) && m_intfsOrch->isInbandIntfInMgmtVrf(alias)))
-        {
-            it = consumer.m_toSync.erase(it);
-            continue;
-        }
+            /*
+             * DEL and SET of the same neighbor must be applied in order,
+             * flush the current bulk before handling the same neighbor again
+             */
+            if (toBulk.find(key) != toBulk.end())
+            {
+                break;
+            }
 
-        if(gPortsOrch->isInbandPort(alias))
-        {
-            Port ibport;
-            gPortsOrch->getInbandPort(ibport);
-            if(ibport.m_type != Port::VLAN)
+            size_t found = key.find(':');
+            if (found == string::npos)
             {
-                //For "port" type Inband, the neighbors are only remote neighbors.
-                //Hence, this is the neigh learned due to the kernel entry added on
-                //Inband interface for the remote system port neighbors. Skip
+                SWSS_LOG_ERROR("Failed to parse key %s", key.c_str());
                 it = consumer.m_toSync.erase(it);
                 continue;
             }
-            //For "vlan" type inband, may identify the remote neighbors and skip
-        }
 
-        IpAddress ip_address(key.substr(found+1));
+            string alias = key.substr(0, found);
 
-        NeighborEntry neighbor_entry = { ip_address, alias };
-
-        if (op == SET_COMMAND)
-        {
-            Port p;
-            if (!gPortsOrch->getPort(alias, p))
+            if (alias == "eth0" || alias == "lo" || alias == "docker0"
+                || ((op == SET_COMMAND) && m_intfsOrch->isInbandIntfInMgmtVrf(alias)))
             {
-                SWSS_LOG_INFO("Port %s doesn't exist", alias.c_str());
-                it++;
+                it = consumer.m_toSync.erase(it);
                 continue;
             }
 
-            if (!p.m_rif_id)
+            if(gPortsOrch->isInbandPort(alias))
             {
-                SWSS_LOG_INFO("Router interface doesn't exist on %s", alias.c_str());
-                it++;
-                continue;
+                Port ibport;
+                gPortsOrch->getInbandPort(ibport);
+                if(ibport.m_type != Port::VLAN)
+                {
+                    //For "port" type Inband, the neighbors are only remote neighbors.
+                    //Hence, this is the neigh learned due to the kernel entry added on
+                    //Inband interface for the remote system port neighbors. Skip
+                    it = consumer.m_toSync.erase(it);
+                    continue;
+                }
+                //For "vlan" type inband, may identify the remote neighbors and skip
             }
 
-            MacAddress mac_address;
-            for (auto i = kfvFieldsValues(t).begin();
-                 i  != kfvFieldsValues(t).end(); i++)
-            {
-                if (fvField(*i) == "neigh")
-                    mac_address = MacAddress(fvValue(*i));
-            }
+            IpAddress ip_address(key.substr(found+1));
 
-            if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end()
-                    || m_syncdNeighbors[neighbor_entry].mac != mac_address)
+            NeighborEntry neighbor_entry = { ip_address, alias };
+
+            if (op == SET_COMMAND)
             {
-                if (addNeighbor(neighbor_entry, mac_address))
+                const Port *p = gPortsOrch->findPort(alias);
+                if (p == nullptr)
                 {
-                    it = consumer.m_toSync.erase(it);
+                    SWSS_LOG_INFO("Port %s doesn't exist", alias.c_str());
+                    it++;
+                    continue;
                 }
-                else
+
+                if (!p->m_rif_id)
                 {
+                    SWSS_LOG_INFO("Router interface doesn't exist on %s", alias.c_str());
                     it++;
                     continue;
                 }
+
+                MacAddress mac_address;
+                for (auto i = kfvFieldsValues(t).begin();
+                     i  != kfvFieldsValues(t).end(); i++)
+                {
+                    if (fvField(*i) == "neigh")
+                        mac_address = MacAddress(fvValue(*i));
+                }
+
+                if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end()
+                        || m_syncdNeighbors[neighbor_entry].mac != mac_address)
+                {
+                    auto& ctx = toBulk.emplace(std::piecewise_construct,
+                            std::forward_as_tuple(key),
+                            std::forward_as_tuple(neighbor_entry, true)).first->second;
+                    ctx.mac = mac_address;
+
+                    addBulkNeighbor(ctx);
+                    it++;
+                }
+                else
+                {
+                    /* Duplicate entry */
+                    it = consumer.m_toSync.erase(it);
+                    removePendingNeighborDel(consumer, it, key);
+                }
+            }
+            else if (op == DEL_COMMAND)
+            {
+                if (m_syncdNeighbors.find(neighbor_entry) != m_syncdNeighbors.end())
+                {
+                    auto& ctx = toBulk.emplace(std::piecewise_construct,
+                            std::forward_as_tuple(key),
+                            std::forward_as_tuple(neighbor_entry, false)).first->second;
+
+                    removeBulkNeighbor(ctx);
+                    it++;
+                }
+                else
+                    /* Cannot locate the neighbor */
+                    it = consumer.m_toSync.erase(it);
             }
             else
             {
-                /* Duplicate entry */
+                SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
                 it = consumer.m_toSync.erase(it);
             }
+        }
 
-            /* Remove remaining DEL operation in m_toSync for the same neighbor.
-             * Since DEL operation is supposed to be executed before SET for the same neighbor
-             * A remaining DEL after the SET operation means the DEL operation failed previously and should not be executed anymore
-             */
-            auto rit = make_reverse_iterator(it);
-            while (rit != consumer.m_toSync.rend() && rit->first == key && kfvOp(rit->second) == DEL_COMMAND)
+        // Flush the bulkers, so neighbors and next hops will be written to syncd and ASIC
+        flushBulkNeighbors(toBulk);
+
+        // Go through the bulker results
+        auto it_prev = consumer.m_toSync.begin();
+        while (it_prev != it)
+        {
+            string key = kfvKey(it_prev->second);
+            string op = kfvOp(it_prev->second);
+
+            auto found = toBulk.find(key);
+            if (found == toBulk.end() || !found->second.queued ||
+                found->second.enable != (op == SET_COMMAND))
             {
-                consumer.m_toSync.erase(next(rit).base());
-                SWSS_LOG_NOTICE("Removed pending neighbor DEL operation for %s after SET operation", key.c_str());
+                it_prev++;
+                continue;
             }
-        }
-        else if (op == DEL_COMMAND)
-        {
-            if (m_syncdNeighbors.find(neighbor_entry) != m_syncdNeighbors.end())
+
+            auto& ctx = found->second;
+            if (ctx.enable)
             {
-                if (removeNeighbor(neighbor_entry))
+                if (addBulkNeighborPost(ctx))
                 {
-                    it = consumer.m_toSync.erase(it);
+                    it_prev = consumer.m_toSync.erase(it_prev);
+                    removePendingNeighborDel(consumer, it_prev, key);
                 }
                 else
                 {
-                    it++;
+                    it_prev++;
                 }
             }
             else
-                /* Cannot locate the neighbor */
-                it = consumer.m_toSync.erase(it);
-        }
-        else
-        {
-            SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
-            it = consumer.m_toSync.erase(it);
+            {
+                if (removeBulkNeighborPost(ctx))
+                    it_prev = consumer.m_toSync.erase(it_prev);
+                else
+                    it_prev++;
+            }
         }
     }
 }
 
-bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress &macAddress)
+bool NeighOrch::getNeighborAttrs(const NeighborEntry &neighborEntry, const MacAddress &macAddress,
+                                 sai_neighbor_entry_t &neighbor_entry, vector<sai_attribute_t> &neighbor_attrs)
 {
-    SWSS_LOG_ENTER();
-
-    sai_status_t status;
     IpAddress ip_address = neighborEntry.ip_address;
     string alias = neighborEntry.alias;
 
@@ -782,14 +873,13 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
         return false;
     }
 
-    sai_neighbor_entry_t neighbor_entry;
     neighbor_entry.rif_id = rif_id;
     neighbor_entry.switch_id = gSwitchId;
     copy(neighbor_entry.ip_address, ip_address);
 
-    vector<sai_attribute_t> neighbor_attrs;
     sai_attribute_t neighbor_attr;
 
+    /* DST_MAC_ADDRESS is always the first attribute, it is the one updated on MAC change */
     neighbor_attr.id = SAI_NEIGHBOR_ENTRY_ATTR_DST_MAC_ADDRESS;
     memcpy(neighbor_attr.value.mac, macAddress.getMac(), 6);
     neighbor_attrs.push_back(neighbor_attr);
@@ -806,16 +896,430 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
         }
     }
 
+    if (gMySwitchType == "voq")
+    {
+        if (!addVoqEncapIndex(alias, ip_address, neighbor_attrs))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Resolve the next hop key of a neighbor. For remote system ports kernel
+ * nexthops are always on inband.
+ */
+NextHopKey NeighOrch::getNeighborNextHopKey(const NeighborEntry &neighborEntry)
+{
+    NextHopKey nexthop = { neighborEntry.ip_address, neighborEntry.alias };
+    if (m_intfsOrch->isRemoteSystemPortIntf(neighborEntry.alias))
+    {
+        Port inbp;
+        gPortsOrch->getInbandPort(inbp);
+        assert(inbp.m_alias.length());
+
+        nexthop.alias = inbp.m_alias;
+    }
+
+    return nexthop;
+}
+
+bool NeighOrch::addBulkNeighbor(NeighborBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const NeighborEntry &neighborEntry = ctx.neighborEntry;
+    const MacAddress &macAddress = ctx.mac;
+    const IpAddress &ip_address = neighborEntry.ip_address;
+    const string &alias = neighborEntry.alias;
+
+    if (!getNeighborAttrs(neighborEntry, macAddress, ctx.neighbor_entry, ctx.neighbor_attrs))
+    {
+        return false;
+    }
+
     MuxOrch* mux_orch = gDirectory.get<MuxOrch*>();
     bool hw_config = isHwConfigured(neighborEntry);
 
-    if (gMySwitchType == "voq")
+    if (!hw_config && mux_orch->isNeighborActive(ip_address, macAddress, alias))
     {
-        if (!addVoqEncapIndex(alias, ip_address, neighbor_attrs))
+        /* The next hop is created once the neighbor entry is in place, check its port now */
+        const Port *p = gPortsOrch->findPort(alias);
+        if (p == nullptr)
         {
+            SWSS_LOG_ERROR("Neighbor %s seen on port %s which doesn't exist",
+                            ip_address.to_string().c_str(), alias.c_str());
             return false;
         }
+        if (p->m_type == Port::SUBPORT)
+        {
+            p = gPortsOrch->findPort(p->m_parent_port_id);
+            if (p == nullptr)
+            {
+                SWSS_LOG_ERROR("Neighbor %s seen on sub interface %s whose parent port doesn't exist",
+                                ip_address.to_string().c_str(), alias.c_str());
+                return false;
+            }
+        }
+        ctx.nh_if_down = (p->m_oper_status == SAI_PORT_OPER_STATUS_DOWN);
+
+        ctx.create_neighbor = true;
+        ctx.object_statuses.emplace_back();
+        gNeighBulker.create_entry(&ctx.object_statuses.back(), &ctx.neighbor_entry,
+                                  (uint32_t)ctx.neighbor_attrs.size(), ctx.neighbor_attrs.data());
     }
+    else if (hw_config)
+    {
+        ctx.set_neighbor = true;
+        ctx.object_statuses.emplace_back();
+        gNeighBulker.set_entry_attribute(&ctx.object_statuses.back(), &ctx.neighbor_entry,
+                                         &ctx.neighbor_attrs.front());
+    }
+
+    ctx.queued = true;
+    return true;
+}
+
+bool NeighOrch::addBulkNeighborPost(NeighborBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const NeighborEntry &neighborEntry = ctx.neighborEntry;
+    const MacAddress &macAddress = ctx.mac;
+    IpAddress ip_address = neighborEntry.ip_address;
+    string alias = neighborEntry.alias;
+    bool hw_config = isHwConfigured(neighborEntry);
+
+    if (ctx.create_neighbor)
+    {
+        sai_status_t status = ctx.object_statuses.front();
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            if (status == SAI_STATUS_ITEM_ALREADY_EXISTS)
+            {
+                SWSS_LOG_ERROR("Entry exists: neighbor %s on %s, rv:%d",
+                           macAddress.to_string().c_str(), alias.c_str(), status);
+                /* Returning True so as to skip retry */
+                return true;
+            }
+            else
+            {
+                SWSS_LOG_ERROR("Failed to create neighbor %s on %s, rv:%d",
+                           macAddress.to_string().c_str(), alias.c_str(), status);
+                task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEIGHBOR, status);
+                if (handle_status != task_success)
+                {
+                    return parseHandleSaiStatusFailure(handle_status);
+                }
+            }
+        }
+        SWSS_LOG_NOTICE("Created neighbor ip %s, %s on %s", ip_address.to_string().c_str(),
+                macAddress.to_string().c_str(), alias.c_str());
+        m_intfsOrch->increaseRouterIntfsRefCount(alias);
+
+        if (ctx.neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+        {
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
+        }
+        else
+        {
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+        }
+
+        NextHopKey nexthop = getNeighborNextHopKey(neighborEntry);
+        if (ctx.next_hop_id == SAI_NULL_OBJECT_ID)
+        {
+            SWSS_LOG_ERROR("Failed to create next hop %s on %s, rv:%d",
+                           nexthop.ip_address.to_string().c_str(), nexthop.alias.c_str(), ctx.next_hop_status);
+            handleSaiCreateStatus(SAI_API_NEXT_HOP, ctx.next_hop_status);
+
+            status = sai_neighbor_api->remove_neighbor_entry(&ctx.neighbor_entry);
+            if (status != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to remove neighbor %s on %s, rv:%d",
+                               macAddress.to_string().c_str(), alias.c_str(), status);
+                task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEIGHBOR, status);
+                if (handle_status != task_success)
+                {
+                    return parseHandleSaiStatusFailure(handle_status);
+                }
+            }
+            m_intfsOrch->decreaseRouterIntfsRefCount(alias);
+
+            if (ctx.neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+            {
+                gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
+            }
+            else
+            {
+                gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+            }
+
+            /* Keep the neighbor in m_toSync so it is retried like in addNeighbor */
+            return false;
+        }
+
+        addNextHopPost(nexthop, ctx.next_hop_id, ctx.nh_if_down);
+        hw_config = true;
+    }
+    else if (ctx.set_neighbor)
+    {
+        sai_status_t status = ctx.object_statuses.front();
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to update neighbor %s on %s, rv:%d",
+                           macAddress.to_string().c_str(), alias.c_str(), status);
+            task_process_status handle_status = handleSaiSetStatus(SAI_API_NEIGHBOR, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
+        }
+        SWSS_LOG_NOTICE("Updated neighbor %s on %s", macAddress.to_string().c_str(), alias.c_str());
+    }
+
+    insertSyncdNeighbor(neighborEntry)->second = { macAddress, hw_config };
+
+    NeighborUpdate update = { neighborEntry, macAddress, true };
+    notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
+
+    if(gMySwitchType == "voq")
+    {
+        //Sync the neighbor to add to the CHASSIS_APP_DB
+        voqSyncAddNeigh(alias, ip_address, macAddress, ctx.neighbor_entry);
+    }
+
+    return true;
+}
+
+bool NeighOrch::removeBulkNeighbor(NeighborBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const NeighborEntry &neighborEntry = ctx.neighborEntry;
+    const IpAddress &ip_address = neighborEntry.ip_address;
+    const string &alias = neighborEntry.alias;
+
+    NextHopKey nexthop = getNeighborNextHopKey(neighborEntry);
+
+    auto nh = m_syncdNextHops.find(nexthop);
+    if (nh != m_syncdNextHops.end() && nh->second.ref_count > 0)
+    {
+        SWSS_LOG_INFO("Failed to remove still referenced neighbor %s on %s",
+                      m_syncdNeighbors[neighborEntry].mac.to_string().c_str(), alias.c_str());
+        return false;
+    }
+
+    if (isHwConfigured(neighborEntry))
+    {
+        ctx.neighbor_entry.rif_id = m_intfsOrch->getRouterIntfsId(alias);
+        ctx.neighbor_entry.switch_id = gSwitchId;
+        copy(ctx.neighbor_entry.ip_address, ip_address);
+
+        /* The neighbor entry is removed once its next hop is gone */
+        ctx.remove_neighbor = true;
+        if (nh != m_syncdNextHops.end() && nh->second.next_hop_id != SAI_NULL_OBJECT_ID)
+        {
+            ctx.next_hop_id = nh->second.next_hop_id;
+            gNextHopBulker.remove_entry(&ctx.next_hop_status, ctx.next_hop_id);
+        }
+        else
+        {
+            ctx.next_hop_status = SAI_STATUS_ITEM_NOT_FOUND;
+        }
+    }
+
+    ctx.queued = true;
+    return true;
+}
+
+bool NeighOrch::removeBulkNeighborPost(NeighborBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const NeighborEntry &neighborEntry = ctx.neighborEntry;
+    IpAddress ip_address = neighborEntry.ip_address;
+    string alias = neighborEntry.alias;
+
+    if (m_syncdNeighbors.find(neighborEntry) == m_syncdNeighbors.end())
+    {
+        return true;
+    }
+
+    if (ctx.remove_neighbor)
+    {
+        sai_status_t status = ctx.next_hop_status;
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            /* When next hop is not found, we continue to remove neighbor entry. */
+            if (status == SAI_STATUS_ITEM_NOT_FOUND)
+            {
+                SWSS_LOG_ERROR("Failed to locate next hop %s on %s, rv:%d",
+                               ip_address.to_string().c_str(), alias.c_str(), status);
+            }
+            else
+            {
+                SWSS_LOG_ERROR("Failed to remove next hop %s on %s, rv:%d",
+                               ip_address.to_string().c_str(), alias.c_str(), status);
+                task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEXT_HOP, status);
+                if (handle_status != task_success)
+                {
+                    return parseHandleSaiStatusFailure(handle_status);
+                }
+            }
+        }
+
+        if (status != SAI_STATUS_ITEM_NOT_FOUND)
+        {
+            if (ctx.neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+            {
+                gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+            }
+            else
+            {
+                gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEXTHOP);
+            }
+        }
+
+        SWSS_LOG_NOTICE("Removed next hop %s on %s",
+                        ip_address.to_string().c_str(), alias.c_str());
+
+        /* Neighbor entry removal is not queued when the next hop removal failed */
+        if (ctx.object_statuses.empty())
+        {
+            return false;
+        }
+
+        status = ctx.object_statuses.front();
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            if (status == SAI_STATUS_ITEM_NOT_FOUND)
+            {
+                SWSS_LOG_ERROR("Failed to locate neighbor %s on %s, rv:%d",
+                        m_syncdNeighbors[neighborEntry].mac.to_string().c_str(), alias.c_str(), status);
+                return true;
+            }
+            else
+            {
+                SWSS_LOG_ERROR("Failed to remove neighbor %s on %s, rv:%d",
+                        m_syncdNeighbors[neighborEntry].mac.to_string().c_str(), alias.c_str(), status);
+                task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEIGHBOR, status);
+                if (handle_status != task_success)
+                {
+                    return parseHandleSaiStatusFailure(handle_status);
+                }
+            }
+        }
+
+        if (ctx.neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
+        }
+        else
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+        }
+
+        removeNextHop(ip_address, alias);
+        m_intfsOrch->decreaseRouterIntfsRefCount(alias);
+    }
+
+    SWSS_LOG_NOTICE("Removed neighbor %s on %s",
+            m_syncdNeighbors[neighborEntry].mac.to_string().c_str(), alias.c_str());
+
+    eraseSyncdNeighbor(neighborEntry);
+
+    NeighborUpdate update = { neighborEntry, MacAddress(), false };
+    notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
+
+    if(gMySwitchType == "voq")
+    {
+        //Sync the neighbor to delete from the CHASSIS_APP_DB
+        voqSyncDelNeigh(alias, ip_address);
+    }
+
+    return true;
+}
+
+void NeighOrch::flushBulkNeighbors(std::map<std::string, NeighborBulkContext>& toBulk)
+{
+    SWSS_LOG_ENTER();
+
+    /* Next hops have to be removed before their neighbor entries */
+    gNextHopBulker.flush();
+
+    for (auto& it : toBulk)
+    {
+        auto& ctx = it.second;
+        if (!ctx.remove_neighbor)
+        {
+            continue;
+        }
+
+        if (ctx.next_hop_status != SAI_STATUS_SUCCESS && ctx.next_hop_status != SAI_STATUS_ITEM_NOT_FOUND)
+        {
+            continue;
+        }
+
+        ctx.object_statuses.emplace_back();
+        gNeighBulker.remove_entry(&ctx.object_statuses.back(), &ctx.neighbor_entry);
+    }
+
+    gNeighBulker.flush();
+
+    /* Next hops are created for the neighbor entries which have been created */
+    for (auto& it : toBulk)
+    {
+        auto& ctx = it.second;
+        if (!ctx.create_neighbor || ctx.object_statuses.front() != SAI_STATUS_SUCCESS)
+        {
+            continue;
+        }
+
+        NextHopKey nexthop = getNeighborNextHopKey(ctx.neighborEntry);
+        assert(!hasNextHop(nexthop));
+
+        vector<sai_attribute_t> next_hop_attrs;
+        sai_attribute_t next_hop_attr;
+
+        next_hop_attr.id = SAI_NEXT_HOP_ATTR_TYPE;
+        next_hop_attr.value.s32 = SAI_NEXT_HOP_TYPE_IP;
+        next_hop_attrs.push_back(next_hop_attr);
+
+        next_hop_attr.id = SAI_NEXT_HOP_ATTR_IP;
+        copy(next_hop_attr.value.ipaddr, nexthop.ip_address);
+        next_hop_attrs.push_back(next_hop_attr);
+
+        next_hop_attr.id = SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID;
+        next_hop_attr.value.oid = ctx.neighbor_entry.rif_id;
+        next_hop_attrs.push_back(next_hop_attr);
+
+        gNextHopBulker.create_entry(&ctx.next_hop_status, &ctx.next_hop_id, (uint32_t)next_hop_attrs.size(), next_hop_attrs.data());
+    }
+
+    gNextHopBulker.flush();
+}
+
+bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress &macAddress)
+{
+    SWSS_LOG_ENTER();
+
+    sai_status_t status;
+    IpAddress ip_address = neighborEntry.ip_address;
+    string alias = neighborEntry.alias;
+
+    sai_neighbor_entry_t neighbor_entry;
+    vector<sai_attribute_t> neighbor_attrs;
+
+    if (!getNeighborAttrs(neighborEntry, macAddress, neighbor_entry, neighbor_attrs))
+    {
+        return false;
+    }
+
+    MuxOrch* mux_orch = gDirectory.get<MuxOrch*>();
+    bool hw_config = isHwConfigured(neighborEntry);
 
     if (!hw_config && mux_orch->isNeighborActive(ip_address, macAddress, alias))
     {
@@ -884,7 +1388,7 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
     }
     else if (isHwConfigured(neighborEntry))
     {
-        status = sai_neighbor_api->set_neighbor_entry_attribute(&neighbor_entry, &neighbor_attr);
+        status = sai_neighbor_api->set_neighbor_entry_attribute(&neighbor_entry, &neighbor_attrs.front());
         if (status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to update neighbor %s on %s, rv:%d",
@@ -898,7 +1402,7 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
         SWSS_LOG_NOTICE("Updated neighbor %s on %s", macAddress.to_string().c_str(), alias.c_str());
     }
 
-    m_syncdNeighbors[neighborEntry] = { macAddress, hw_config };
+    insertSyncdNeighbor(neighborEntry)->second = { macAddress, hw_config };
 
     NeighborUpdate update = { neighborEntry, macAddress, true };
     notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
@@ -1033,7 +1537,7 @@ bool NeighOrch::removeNeighbor(const NeighborEntry &neighborEntry, bool disable)
         return true;
     }
 
-    m_syncdNeighbors.erase(neighborEntry);
+    eraseSyncdNeighbor(neighborEntry);
 
     NeighborUpdate update = { neighborEntry, MacAddress(), false };
     notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
@@ -1218,15 +1722,15 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
 
         if (op == SET_COMMAND)
         {
-            Port p;
-            if (!gPortsOrch->getPort(alias, p))
+            const Port *p = gPortsOrch->findPort(alias);
+            if (p == nullptr)
             {
                 SWSS_LOG_INFO("Port %s doesn't exist", alias.c_str());
                 it++;
                 continue;
             }
 
-            if (!p.m_rif_id)
+            if (!p->m_rif_id)
             {
                 SWSS_LOG_INFO("Router interface doesn't exist on %s", alias.c_str());
                 it++;
@@ -1583,7 +2087,7 @@ void NeighOrch::voqSyncAddNeigh(string &alias, IpAddress &ip_address, const MacA
     }
 
     NeighborEntry nbrEntry = {ip_address, alias};
-    m_syncdNeighbors[nbrEntry].voq_encap_index = attr.value.u32;
+    insertSyncdNeighbor(nbrEntry)->second.voq_encap_index = attr.value.u32;
 
     //Sync only local neigh. Confirm for the local neigh and
     //get the system port alias for key for syncing to CHASSIS_APP_DB
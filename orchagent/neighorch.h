@@ -11,6 +11,7 @@
 #include "nexthopkey.h"
 #include "producerstatetable.h"
 #include "schema.h"
+#include "bulker.h"
 
 #define NHFLAGS_IFDOWN                  0x1 // nexthop's outbound i/f is down
 
@@ -32,6 +33,29 @@ struct NeighborData
 
 /* NeighborTable: NeighborEntry, neighbor MAC address */
 typedef map<NeighborEntry, NeighborData> NeighborTable;
+/* NeighborIndexKey: neighbor IP address, interface alias */
+typedef pair<IpAddress, string> NeighborIndexKey;
+
+struct NeighborIndexKeyHash
+{
+    size_t operator()(const NeighborIndexKey &key) const
+    {
+        size_t seed = std::hash<std::string>()(key.second);
+        if (key.first.isV4())
+        {
+            boost::hash_combine(seed, key.first.getV4Addr());
+        }
+        else
+        {
+            const unsigned char *addr = key.first.getV6Addr();
+            boost::hash_range(seed, addr, addr + 16);
+        }
+        return seed;
+    }
+};
+
+/* NeighborIndex: (IP address, alias) lookup index into NeighborTable */
+typedef unordered_map<NeighborIndexKey, NeighborTable::iterator, NeighborIndexKeyHash> NeighborIndex;
 /* NextHopTable: NextHopKey, NextHopEntry */
 typedef map<NextHopKey, NextHopEntry> NextHopTable;
 
@@ -42,6 +66,35 @@ struct NeighborUpdate
     bool add;
 };
 
+struct NeighborBulkContext
+{
+    std::deque<sai_status_t>            object_statuses;    // Bulk statuses
+    NeighborEntry                       neighborEntry;      // Neighbor entry to process
+    MacAddress                          mac;                // Neighbor MAC address
+    bool                                enable;             // Add (SET) or remove (DEL) neighbor
+    bool                                queued;             // Neighbor passed the pre-bulk checks
+    bool                                create_neighbor;    // Neighbor entry is created in bulk
+    bool                                set_neighbor;       // Neighbor MAC is updated in bulk
+    bool                                remove_neighbor;    // Neighbor entry is removed in bulk
+    bool                                nh_if_down;         // Outbound port of the next hop is down
+    sai_neighbor_entry_t                neighbor_entry;     // SAI neighbor entry
+    std::vector<sai_attribute_t>        neighbor_attrs;     // SAI neighbor attributes
+    sai_object_id_t                     next_hop_id;        // Next hop created or removed in bulk
+    sai_status_t                        next_hop_status;    // Next hop creation or removal status
+
+    NeighborBulkContext(const NeighborEntry &entry, bool enable)
+        : neighborEntry(entry), enable(enable), queued(false),
+          create_neighbor(false), set_neighbor(false), remove_neighbor(false),
+          nh_if_down(false), next_hop_id(SAI_NULL_OBJECT_ID),
+          next_hop_status(SAI_STATUS_NOT_EXECUTED)
+    {
+    }
+
+    // Disable any copy constructors
+    NeighborBulkContext(const NeighborBulkContext&) = delete;
+    NeighborBulkContext(NeighborBulkContext&&) = delete;
+};
+
 class NeighOrch : public Orch, public Subject, public Observer
 {
 public:
@@ -88,15 +141,32 @@ private:
     ProducerStateTable m_appNeighResolveProducer;
 
     NeighborTable m_syncdNeighbors;
+    NeighborIndex m_syncdNeighborIndex;
     NextHopTable m_syncdNextHops;
 
     std::set<NextHopKey> m_neighborToResolve;
 
     bool removeNextHop(const IpAddress&, const string&);
 
+    NeighborTable::iterator insertSyncdNeighbor(const NeighborEntry&);
+    void eraseSyncdNeighbor(const NeighborEntry&);
+
     bool addNeighbor(const NeighborEntry&, const MacAddress&);
     bool removeNeighbor(const NeighborEntry&, bool disable = false);
 
+    EntityBulker<sai_neighbor_api_t>    gNeighBulker;
+    ObjectBulker<sai_next_hop_api_t>    gNextHopBulker;
+
+    bool getNeighborAttrs(const NeighborEntry&, const MacAddress&, sai_neighbor_entry_t&, vector<sai_attribute_t>&);
+    NextHopKey getNeighborNextHopKey(const NeighborEntry&);
+
+    bool addBulkNeighbor(NeighborBulkContext& ctx);
+    bool addBulkNeighborPost(NeighborBulkContext& ctx);
+    bool removeBulkNeighbor(NeighborBulkContext& ctx);
+    bool removeBulkNeighborPost(NeighborBulkContext& ctx);
+    void flushBulkNeighbors(std::map<std::string, NeighborBulkContext>& toBulk);
+    void addNextHopPost(const NextHopKey&, sai_object_id_t, bool if_down);
+
     bool setNextHopFlag(const NextHopKey &, const uint32_t);
     bool clearNextHopFlag(const NextHopKey &, const uint32_t);
 
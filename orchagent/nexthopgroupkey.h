@@ -1,27 +1,46 @@
 #ifndef SWSS_NEXTHOPGROUPKEY_H
 #define SWSS_NEXTHOPGROUPKEY_H
 
+#include <memory>
+#include <unordered_map>
+#include <boost/functional/hash.hpp>
+
 #include "nexthopkey.h"
 
+/*
+ * The set of next hops is shared between copies of a key and copied on
+ * write, so copying a key is cheap and keys built from the same
+ * NextHopGroupKeyCache entry compare equal without walking the set. The
+ * hash is computed on first use and cached until the key is modified.
+ */
 class NextHopGroupKey
 {
 public:
-    NextHopGroupKey() = default;
+    NextHopGroupKey() :
+        m_nexthops(emptyNextHops()),
+        m_overlay_nexthops(false),
+        m_srv6_nexthops(false)
+    {
+    }
 
     /* ip_string@if_alias separated by ',' */
-    NextHopGroupKey(const std::string &nexthops)
+    NextHopGroupKey(const std::string &nexthops) :
+        m_nexthops(std::make_shared<NextHopSet>())
     {
         m_overlay_nexthops = false;
         m_srv6_nexthops = false;
         auto nhv = tokenize(nexthops, NHG_DELIMITER);
         for (const auto &nh : nhv)
         {
-            m_nexthops.insert(nh);
+            m_nexthops->insert(nh);
         }
     }
 
     /* ip_string|if_alias|vni|router_mac separated by ',' */
-    NextHopGroupKey(const std::string &nexthops, bool overlay_nh, bool srv6_nh = false)
+    NextHopGroupKey(const std::string &nexthops, bool overlay_nh, bool srv6_nh = false) :
+        m_nexthops(std::make_shared<NextHopSet>()),
+        m_overlay_nexthops(false),
+        m_srv6_nexthops(false)
     {
         if (overlay_nh)
         {
@@ -31,7 +50,7 @@ public:
             for (const auto &nh_str : nhv)
             {
                 auto nh = NextHopKey(nh_str, overlay_nh, srv6_nh);
-                m_nexthops.insert(nh);
+                m_nexthops->insert(nh);
             }
         }
         else if (srv6_nh)
@@ -42,12 +61,13 @@ public:
             for (const auto &nh_str : nhv)
             {
                 auto nh = NextHopKey(nh_str, overlay_nh, srv6_nh);
-                m_nexthops.insert(nh);
+                m_nexthops->insert(nh);
             }
         }
     }
 
-    NextHopGroupKey(const std::string &nexthops, const std::string &weights)
+    NextHopGroupKey(const std::string &nexthops, const std::string &weights) :
+        m_nexthops(std::make_shared<NextHopSet>())
     {
         m_overlay_nexthops = false;
         m_srv6_nexthops = false;
@@ -58,30 +78,50 @@ public:
         {
             NextHopKey nh(nhv[i]);
             nh.weight = set_weight? (uint32_t)std::stoi(wtv[i]) : 0;
-            m_nexthops.insert(nh);
+            m_nexthops->insert(nh);
         }
     }
 
     inline const std::set<NextHopKey> &getNextHops() const
     {
-        return m_nexthops;
+        return *m_nexthops;
     }
 
     inline size_t getSize() const
     {
-        return m_nexthops.size();
+        return m_nexthops->size();
+    }
+
+    size_t getHash() const
+    {
+        if (!m_hashValid)
+        {
+            size_t seed = 0;
+            for (const auto &nh : *m_nexthops)
+            {
+                hashNextHop(seed, nh);
+            }
+            m_hash = seed;
+            m_hashValid = true;
+        }
+        return m_hash;
     }
 
     inline bool operator<(const NextHopGroupKey &o) const
     {
-        if (m_nexthops < o.m_nexthops)
+        if (m_nexthops == o.m_nexthops)
+        {
+            return false;
+        }
+
+        if (*m_nexthops < *o.m_nexthops)
         {
             return true;
         }
-        else if (m_nexthops == o.m_nexthops)
+        else if (*m_nexthops == *o.m_nexthops)
         {
-            auto it1 = m_nexthops.begin();
-            for (auto& it2 : o.m_nexthops)
+            auto it1 = m_nexthops->begin();
+            for (auto& it2 : *o.m_nexthops)
             {
                 if (it1->weight < it2.weight)
                 {
@@ -99,12 +139,16 @@ public:
 
     inline bool operator==(const NextHopGroupKey &o) const
     {
-        if (m_nexthops != o.m_nexthops)
+        if (m_nexthops == o.m_nexthops)
+        {
+            return true;
+        }
+        if (getHash() != o.getHash() || *m_nexthops != *o.m_nexthops)
         {
             return false;
         }
-        auto it1 = m_nexthops.begin();
-        for (auto& it2 : o.m_nexthops)
+        auto it1 = m_nexthops->begin();
+        for (auto& it2 : *o.m_nexthops)
         {
             if (it2.weight != it1->weight)
             {
@@ -122,33 +166,33 @@ public:
 
     void add(const std::string &ip, const std::string &alias)
     {
-        m_nexthops.emplace(ip, alias);
+        mutableNextHops().emplace(ip, alias);
     }
 
     void add(const std::string &nh)
     {
-        m_nexthops.insert(nh);
+        mutableNextHops().insert(nh);
     }
 
     void add(const NextHopKey &nh)
     {
-        m_nexthops.insert(nh);
+        mutableNextHops().insert(nh);
     }
 
     bool contains(const std::string &ip, const std::string &alias) const
     {
         NextHopKey nh(ip, alias);
-        return m_nexthops.find(nh) != m_nexthops.end();
+        return m_nexthops->find(nh) != m_nexthops->end();
     }
 
     bool contains(const std::string &nh) const
     {
-        return m_nexthops.find(nh) != m_nexthops.end();
+        return m_nexthops->find(nh) != m_nexthops->end();
     }
 
     bool contains(const NextHopKey &nh) const
     {
-        return m_nexthops.find(nh) != m_nexthops.end();
+        return m_nexthops->find(nh) != m_nexthops->end();
     }
 
     bool contains(const NextHopGroupKey &nhs) const
@@ -165,7 +209,7 @@ public:
 
     bool hasIntfNextHop() const
     {
-        for (const auto &nh : m_nexthops)
+        for (const auto &nh : *m_nexthops)
         {
             if (nh.isIntfNextHop())
             {
@@ -178,26 +222,26 @@ public:
     void remove(const std::string &ip, const std::string &alias)
     {
         NextHopKey nh(ip, alias);
-        m_nexthops.erase(nh);
+        mutableNextHops().erase(nh);
     }
 
     void remove(const std::string &nh)
     {
-        m_nexthops.erase(nh);
+        mutableNextHops().erase(nh);
     }
 
     void remove(const NextHopKey &nh)
     {
-        m_nexthops.erase(nh);
+        mutableNextHops().erase(nh);
     }
 
     const std::string to_string() const
     {
         string nhs_str;
 
-        for (auto it = m_nexthops.begin(); it != m_nexthops.end(); ++it)
+        for (auto it = m_nexthops->begin(); it != m_nexthops->end(); ++it)
         {
-            if (it != m_nexthops.begin())
+            if (it != m_nexthops->begin())
             {
                 nhs_str += NHG_DELIMITER;
             }
@@ -223,13 +267,111 @@ public:
 
     void clear()
     {
-        m_nexthops.clear();
+        m_nexthops = emptyNextHops();
+        m_hashValid = false;
     }
 
 private:
-    std::set<NextHopKey> m_nexthops;
+    typedef std::set<NextHopKey> NextHopSet;
+
+    static const std::shared_ptr<NextHopSet> &emptyNextHops()
+    {
+        static const std::shared_ptr<NextHopSet> empty = std::make_shared<NextHopSet>();
+        return empty;
+    }
+
+    /* Copy the set if it is shared with another key */
+    NextHopSet &mutableNextHops()
+    {
+        if (m_nexthops.use_count() > 1)
+        {
+            m_nexthops = std::make_shared<NextHopSet>(*m_nexthops);
+        }
+        m_hashValid = false;
+        return *m_nexthops;
+    }
+
+    static void hashNextHop(size_t &seed, const NextHopKey &nh)
+    {
+        if (nh.ip_address.isV4())
+        {
+            boost::hash_combine(seed, nh.ip_address.getV4Addr());
+        }
+        else
+        {
+            const unsigned char *addr = nh.ip_address.getV6Addr();
+            boost::hash_range(seed, addr, addr + 16);
+        }
+        boost::hash_combine(seed, nh.alias);
+        boost::hash_combine(seed, nh.vni);
+        boost::hash_range(seed, nh.mac_address.getMac(), nh.mac_address.getMac() + 6);
+        boost::hash_range(seed, nh.label_stack.m_labelstack.begin(), nh.label_stack.m_labelstack.end());
+        boost::hash_combine(seed, nh.weight);
+        boost::hash_combine(seed, nh.srv6_segment);
+        boost::hash_combine(seed, nh.srv6_source);
+    }
+
+    std::shared_ptr<NextHopSet> m_nexthops;
     bool m_overlay_nexthops;
     bool m_srv6_nexthops;
+    mutable size_t m_hash = 0;
+    mutable bool m_hashValid = false;
+};
+
+struct NextHopGroupKeyHash
+{
+    size_t operator()(const NextHopGroupKey &key) const
+    {
+        return key.getHash();
+    }
+};
+
+/*
+ * Interning table from the raw next hop strings of a route to a parsed key.
+ * Routes sharing a group get copies of the same key, which share one set
+ * of next hops. The table is dropped when it grows past its size limit.
+ */
+class NextHopGroupKeyCache
+{
+public:
+    NextHopGroupKeyCache(size_t maxSize = 4096) :
+        m_maxSize(maxSize)
+    {
+    }
+
+    const NextHopGroupKey &get(const std::string &nexthops, const std::string &weights)
+    {
+        std::string raw = nexthops;
+        raw += '|';
+        raw += weights;
+
+        auto it = m_keys.find(raw);
+        if (it != m_keys.end())
+        {
+            return it->second;
+        }
+
+        if (m_keys.size() >= m_maxSize)
+        {
+            m_keys.clear();
+        }
+
+        return m_keys.emplace(std::move(raw), NextHopGroupKey(nexthops, weights)).first->second;
+    }
+
+    size_t size() const
+    {
+        return m_keys.size();
+    }
+
+    void clear()
+    {
+        m_keys.clear();
+    }
+
+private:
+    size_t m_maxSize;
+    std::unordered_map<std::string, NextHopGroupKey> m_keys;
 };
 
 #endif /* SWSS_NEXTHOPGROUPKEY_H */
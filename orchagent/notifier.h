@@ -17,5 +17,6 @@ public:
     void execute()
     {
         m_orch->doTask(*getNotificationConsumer());
+        gAppliedTaskCount++;
     }
 };
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <inttypes.h>
@@ -23,6 +24,9 @@ extern ofstream gRecordOfs;
 extern bool gLogRotate;
 extern string gRecordFile;
 
+/* Number of tasks removed from m_toSync by doTask(), used by the flush policy */
+uint64_t gAppliedTaskCount = 0;
+
 Orch::Orch(DBConnector *db, const string tableName, int pri)
 {
     addConsumer(db, tableName, pri);
@@ -75,8 +79,8 @@ void Consumer::addToSync(const KeyOpFieldsValuesTuple &entry)
     SWSS_LOG_ENTER();
 
 
-    string key = kfvKey(entry);
-    string op  = kfvOp(entry);
+    const string &key = kfvKey(entry);
+    const string &op  = kfvOp(entry);
 
     /* Record incoming tasks */
     if (gSwssRecord)
@@ -85,13 +89,13 @@ void Consumer::addToSync(const KeyOpFieldsValuesTuple &entry)
     }
 
     /*
-    * m_toSync is a multimap which will allow one key with multiple values,
-    * Also, the order of the key-value pairs whose keys compare equivalent
-    * is the order of insertion and does not change. (since C++11)
+    * m_toSync allows one key with multiple values. The values of one key
+    * are kept together in the order of insertion, see SyncMap.
     */
 
     /* If a new task comes we directly put it into getConsumerTable().m_toSync map */
-    if (m_toSync.find(key) == m_toSync.end())
+    auto ret = m_toSync.equal_range(key);
+    if (ret.first == ret.second)
     {
         m_toSync.emplace(key, entry);
     }
@@ -115,12 +119,10 @@ void Consumer::addToSync(const KeyOpFieldsValuesTuple &entry)
         * in such case, we insert the key-value with SET.
         * If there was a SET already (I,E, the pointer still points to the same key), we combine the kfv.
         */
-        auto ret = m_toSync.equal_range(key);
         auto iter = ret.first;
         for (; iter != ret.second; ++iter)
         {
-            auto old_op = kfvOp(iter->second);
-            if (old_op == SET_COMMAND)
+            if (kfvOp(iter->second) == SET_COMMAND)
                 break;
         }
         if (iter == ret.second)
@@ -129,29 +131,18 @@ void Consumer::addToSync(const KeyOpFieldsValuesTuple &entry)
         }
         else
         {
-            KeyOpFieldsValuesTuple existing_data = iter->second;
-
-            auto new_values = kfvFieldsValues(entry);
-            auto existing_values = kfvFieldsValues(existing_data);
-
+            /* Merge in place: a new value replaces the old one and moves to the end */
+            auto &existing_values = kfvFieldsValues(iter->second);
 
-            for (auto it : new_values)
+            for (const auto &fv : kfvFieldsValues(entry))
             {
-                string field = fvField(it);
-                string value = fvValue(it);
+                const string &field = fvField(fv);
 
-                auto iu = existing_values.begin();
-                while (iu != existing_values.end())
-                {
-                    string ofield = fvField(*iu);
-                    if (field == ofield)
-                        iu = existing_values.erase(iu);
-                    else
-                        iu++;
-                }
-                existing_values.push_back(FieldValueTuple(field, value));
+                existing_values.erase(std::remove_if(existing_values.begin(), existing_values.end(),
+                            [&field](const FieldValueTuple &ofv) { return fvField(ofv) == field; }),
+                        existing_values.end());
+                existing_values.push_back(fv);
             }
-            iter->second = KeyOpFieldsValuesTuple(key, op, existing_values);
         }
     }
 
@@ -235,10 +226,77 @@ void Consumer::execute()
     drain();
 }
 
+Consumer::~Consumer()
+{
+    if (m_retryScheduled)
+    {
+        m_orch->cancelRetry(this);
+    }
+}
+
 void Consumer::drain()
 {
-    if (!m_toSync.empty())
-        m_orch->doTask(*this);
+    /* m_toSync may have been emptied without draining, e.g. by a direct doTask() */
+    if (m_toSync.empty())
+    {
+        updateRetryState(0);
+        return;
+    }
+
+    if (m_retryScheduled && m_orch->isRetryDeferred(*this))
+    {
+        return;
+    }
+
+    size_t pending = m_toSync.size();
+    m_orch->doTask(*this);
+    if (m_toSync.size() < pending)
+    {
+        gAppliedTaskCount += pending - m_toSync.size();
+    }
+    updateRetryState(pending);
+}
+
+void Consumer::updateRetryState(size_t pendingBefore)
+{
+    if (m_toSync.empty())
+    {
+        m_retryCount = 0;
+        if (m_retryScheduled)
+        {
+            m_retryScheduled = false;
+            m_orch->cancelRetry(this);
+        }
+        return;
+    }
+
+    if (m_toSync.size() < pendingBefore)
+    {
+        /* Some tasks went through, retry the rest on the next pass */
+        m_retryCount = 0;
+        m_nextRetryTime = std::chrono::steady_clock::now();
+    }
+    else
+    {
+        m_retryCount++;
+
+        uint32_t shift = std::min<uint32_t>(m_retryCount - 1, 31);
+        int64_t backoff = std::min<int64_t>((int64_t)CONSUMER_RETRY_BACKOFF_MIN_MS << shift,
+                                            CONSUMER_RETRY_BACKOFF_MAX_MS);
+        m_nextRetryTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(backoff);
+
+        if (m_retryCount == CONSUMER_RETRY_WARN_THRESHOLD)
+        {
+            SWSS_LOG_WARN("Consumer %s has %zu pending tasks after %u retries",
+                          getName().c_str(), m_toSync.size(), m_retryCount);
+        }
+    }
+
+    if (!m_retryScheduled)
+    {
+        m_retryScheduled = true;
+        m_orch->scheduleRetry(this);
+    }
 }
 
 string Consumer::dumpTuple(const KeyOpFieldsValuesTuple &tuple)
@@ -557,6 +615,72 @@ void Orch::dumpPendingTasks(vector<string> &ts)
     }
 }
 
+void Orch::scheduleRetry(Consumer *consumer)
+{
+    m_retryConsumers.insert(consumer);
+}
+
+void Orch::cancelRetry(Consumer *consumer)
+{
+    m_retryConsumers.erase(consumer);
+}
+
+bool Orch::isRetryDue(const std::chrono::steady_clock::time_point &now) const
+{
+    for (const auto consumer : m_retryConsumers)
+    {
+        if (consumer->getNextRetryTime() <= now)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::chrono::steady_clock::time_point Orch::getNextRetryTime() const
+{
+    auto next = std::chrono::steady_clock::time_point::max();
+    for (const auto consumer : m_retryConsumers)
+    {
+        next = std::min(next, consumer->getNextRetryTime());
+    }
+
+    return next;
+}
+
+void Orch::doRetryTask(const std::chrono::steady_clock::time_point &now)
+{
+    m_retryPass = true;
+    m_retryPassTime = now;
+
+    try
+    {
+        doTask();
+    }
+    catch (...)
+    {
+        m_retryPass = false;
+        throw;
+    }
+
+    m_retryPass = false;
+}
+
+bool Orch::isRetryDeferred(const Consumer &consumer) const
+{
+    return m_retryPass && consumer.getNextRetryTime() > m_retryPassTime;
+}
+
+void Orch::dumpRetryStats(vector<string> &ts) const
+{
+    for (const auto consumer : m_retryConsumers)
+    {
+        ts.push_back(consumer->getName() + " pending:" + to_string(consumer->getPendingCount())
+                     + " retries:" + to_string(consumer->getRetryCount()));
+    }
+}
+
 void Orch::logfileReopen()
 {
     gRecordOfs.close();
@@ -7,6 +7,7 @@
 #include <set>
 #include <memory>
 #include <utility>
+#include <chrono>
 
 extern "C" {
 #include "sai.h"
@@ -21,6 +22,7 @@ extern "C" {
 #include "selectabletimer.h"
 #include "macaddress.h"
 #include "response_publisher.h"
+#include "syncmap.h"
 
 const char delimiter           = ':';
 const char list_item_delimiter = ',';
@@ -73,13 +75,28 @@ typedef std::map<std::string, object_reference_map*> type_map;
 typedef std::map<std::string, sai_object_id_t> object_map;
 typedef std::pair<std::string, sai_object_id_t> object_map_pair;
 
-// Use multimap to support multiple OpFieldsValues for the same key (e,g, DEL and SET)
-// The order of the key-value pairs whose keys compare equivalent is the order of
-// insertion and does not change. (since C++11)
-typedef std::multimap<std::string, swss::KeyOpFieldsValuesTuple> SyncMap;
 
 typedef std::pair<std::string, int> table_name_with_pri_t;
 
+/*
+ * Backoff applied to a consumer whose drain left its m_toSync unchanged,
+ * i.e. every remaining entry returned task_need_retry again. The delay
+ * doubles with every unproductive drain and is reset as soon as the
+ * consumer makes progress.
+ */
+#define CONSUMER_RETRY_BACKOFF_MIN_MS   1
+#define CONSUMER_RETRY_BACKOFF_MAX_MS   128
+/* Number of unproductive drains after which the consumer is reported as stuck */
+#define CONSUMER_RETRY_WARN_THRESHOLD   32
+
+/*
+ * Number of executions which may have queued SAI calls: the tasks applied
+ * by consumers, see Consumer::drain(), and the notifications handled by
+ * notifiers, see Notifier::execute(). OrchDaemon flushes the sairedis
+ * pipeline for them. Timers only poll counters and are not accounted.
+ */
+extern uint64_t gAppliedTaskCount;
+
 class Orch;
 
 // Design assumption
@@ -136,6 +153,8 @@ public:
     {
     }
 
+    ~Consumer() override;
+
     swss::ConsumerTableBase *getConsumerTable() const
     {
         return static_cast<swss::ConsumerTableBase *>(getSelectable());
@@ -164,6 +183,24 @@ public:
     void execute();
     void drain();
 
+    /* Number of tasks left in m_toSync */
+    size_t getPendingCount() const
+    {
+        return m_toSync.size();
+    }
+
+    /* Number of consecutive drains that did not reduce m_toSync */
+    uint32_t getRetryCount() const
+    {
+        return m_retryCount;
+    }
+
+    /* Time at which the pending tasks are due for the next retry */
+    std::chrono::steady_clock::time_point getNextRetryTime() const
+    {
+        return m_nextRetryTime;
+    }
+
     /* Store the latest 'golden' status */
     // TODO: hide?
     SyncMap m_toSync;
@@ -172,6 +209,13 @@ public:
 
     // Returns: the number of entries added to m_toSync
     size_t addToSync(const std::deque<swss::KeyOpFieldsValuesTuple> &entries);
+
+private:
+    void updateRetryState(size_t pendingBefore);
+
+    bool m_retryScheduled = false;
+    uint32_t m_retryCount = 0;
+    std::chrono::steady_clock::time_point m_nextRetryTime;
 };
 
 typedef std::map<std::string, std::shared_ptr<Executor>> ConsumerMap;
@@ -220,6 +264,36 @@ public:
     static void recordTuple(Consumer &consumer, const swss::KeyOpFieldsValuesTuple &tuple);
 
     void dumpPendingTasks(std::vector<std::string> &ts);
+
+    /*
+     * Retry scheduling: a consumer registers itself here when a drain leaves
+     * entries in its m_toSync, and unregisters once m_toSync becomes empty.
+     */
+    void scheduleRetry(Consumer *consumer);
+    void cancelRetry(Consumer *consumer);
+    bool hasPendingTasks() const
+    {
+        return !m_retryConsumers.empty();
+    }
+    bool isRetryDue(const std::chrono::steady_clock::time_point &now) const;
+    std::chrono::steady_clock::time_point getNextRetryTime() const;
+    void dumpRetryStats(std::vector<std::string> &ts) const;
+
+    /*
+     * Run doTask() as a retry pass: the consumers whose retry is not due at
+     * 'now' are left alone, see Consumer::drain(). The order in which
+     * doTask() drains the consumers is kept.
+     */
+    void doRetryTask(const std::chrono::steady_clock::time_point &now);
+    bool isRetryDeferred(const Consumer &consumer) const;
+
+private:
+    /* Declared before m_consumerMap so that it outlives the consumers */
+    std::set<Consumer *> m_retryConsumers;
+
+    bool m_retryPass = false;
+    std::chrono::steady_clock::time_point m_retryPassTime;
+
 protected:
     ConsumerMap m_consumerMap;
 
@@ -1,4 +1,5 @@
 #include <unistd.h>
+#include <algorithm>
 #include <unordered_map>
 #include <chrono>
 #include <limits.h>
@@ -16,6 +17,8 @@ using namespace swss;
 
 /* select() function timeout retry time */
 #define SELECT_TIMEOUT 1000
+/* Interval at which the flush histograms are logged */
+#define FLUSH_STATS_INTERVAL_SEC (5 * 60)
 #define PFC_WD_POLL_MSECS 100
 
 extern sai_switch_api_t*           sai_switch_api;
@@ -58,11 +61,17 @@ bool gIsNatSupported = false;
 #define DEFAULT_MAX_BULK_SIZE 1000
 size_t gMaxBulkSize = DEFAULT_MAX_BULK_SIZE;
 
+#define DEFAULT_FLUSH_BATCH_SIZE 1000
+#define DEFAULT_FLUSH_LATENCY_MS 50
+size_t gFlushBatchSize = DEFAULT_FLUSH_BATCH_SIZE;
+uint32_t gFlushLatencyMs = DEFAULT_FLUSH_LATENCY_MS;
+
 OrchDaemon::OrchDaemon(DBConnector *applDb, DBConnector *configDb, DBConnector *stateDb, DBConnector *chassisAppDb) :
         m_applDb(applDb),
         m_configDb(configDb),
         m_stateDb(stateDb),
-        m_chassisAppDb(chassisAppDb)
+        m_chassisAppDb(chassisAppDb),
+        m_flushPolicy(gFlushBatchSize, gFlushLatencyMs)
 {
     SWSS_LOG_ENTER();
     m_select = new Select();
@@ -269,6 +278,7 @@ bool OrchDaemon::init()
     };
 
     WatermarkOrch *wm_orch = new WatermarkOrch(m_configDb, wm_tables);
+    gDirectory.set(wm_orch);
 
     vector<string> sflow_tables = {
             APP_SFLOW_TABLE_NAME,
@@ -634,6 +644,8 @@ void OrchDaemon::flush()
 {
     SWSS_LOG_ENTER();
 
+    updateFlushPolicy();
+
     sai_attribute_t attr;
     attr.id = SAI_REDIS_SWITCH_ATTR_FLUSH;
     sai_status_t status = sai_switch_api->set_switch_attribute(gSwitchId, &attr);
@@ -643,6 +655,8 @@ void OrchDaemon::flush()
         abort();
     }
 
+    m_flushPolicy.onFlush(std::chrono::steady_clock::now());
+
     // check if logroate is requested
     if (gSaiRedisLogRotate)
     {
@@ -657,6 +671,18 @@ void OrchDaemon::flush()
     }
 }
 
+/* Account the tasks applied since the last call */
+void OrchDaemon::updateFlushPolicy()
+{
+    size_t ops = static_cast<size_t>(gAppliedTaskCount - m_flushedTaskCount);
+    m_flushedTaskCount = gAppliedTaskCount;
+
+    if (ops != 0)
+    {
+        m_flushPolicy.addPending(ops, std::chrono::steady_clock::now());
+    }
+}
+
 void OrchDaemon::start()
 {
     SWSS_LOG_ENTER();
@@ -667,13 +693,23 @@ void OrchDaemon::start()
     }
 
     auto tstart = std::chrono::high_resolution_clock::now();
+    auto tstats = std::chrono::steady_clock::now();
 
     while (true)
     {
         Selectable *s;
         int ret;
+        int timeout = getSelectTimeout();
 
-        ret = m_select->select(&s, SELECT_TIMEOUT);
+        /* Wake up in time to honour the flush latency target */
+        updateFlushPolicy();
+        int flushTimeout = m_flushPolicy.getTimeout(std::chrono::steady_clock::now());
+        if (flushTimeout >= 0)
+        {
+            timeout = std::min(timeout, flushTimeout);
+        }
+
+        ret = m_select->select(&s, timeout);
 
         auto tend = std::chrono::high_resolution_clock::now();
 
@@ -699,6 +735,7 @@ void OrchDaemon::start()
              * accumulated. Still it is possible that small amount of
              * requests live in it. When the daemon has nothing to do, it
              * is a good chance to flush the pipeline  */
+            retryPendingTasks();
             flush();
             continue;
         }
@@ -706,12 +743,32 @@ void OrchDaemon::start()
         auto *c = (Executor *)s;
         c->execute();
 
-        /* After each iteration, periodically check all m_toSync map to
-         * execute all the remaining tasks that need to be retried. */
+        /* After each iteration, retry the remaining tasks of the consumers
+         * that registered pending entries and whose backoff has expired. */
+        retryPendingTasks();
 
-        /* TODO: Abstract Orch class to have a specific todo list */
-        for (Orch *o : m_orchList)
-            o->doTask();
+        /*
+         * Only wakeups which applied tasks or handled a notification
+         * start the latency clock, see gAppliedTaskCount.
+         */
+        auto now = std::chrono::steady_clock::now();
+        updateFlushPolicy();
+        if (m_flushPolicy.isFlushDue(now))
+        {
+            flush();
+        }
+
+        if (now - tstats >= std::chrono::seconds(FLUSH_STATS_INTERVAL_SEC))
+        {
+            tstats = now;
+
+            vector<string> stats;
+            getFlushStats(stats);
+            for (auto &st : stats)
+            {
+                SWSS_LOG_NOTICE("sairedis %s", st.c_str());
+            }
+        }
 
         /*
          * Asked to check warm restart readiness.
@@ -751,6 +808,54 @@ void OrchDaemon::start()
     }
 }
 
+/*
+ * Compute the select timeout so that the loop wakes up when the earliest
+ * backed off consumer becomes due, but never later than SELECT_TIMEOUT.
+ */
+int OrchDaemon::getSelectTimeout()
+{
+    auto next = std::chrono::steady_clock::time_point::max();
+    for (Orch *o : m_orchList)
+    {
+        if (o->hasPendingTasks())
+        {
+            next = std::min(next, o->getNextRetryTime());
+        }
+    }
+
+    if (next == std::chrono::steady_clock::time_point::max())
+    {
+        return SELECT_TIMEOUT;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (next <= now)
+    {
+        return 0;
+    }
+
+    auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(next - now).count();
+    return static_cast<int>(std::min<int64_t>(diff + 1, SELECT_TIMEOUT));
+}
+
+/*
+ * Drain only the consumers with pending tasks due for retry, a consumer
+ * still backing off is not run because another one of its orch is due.
+ * The order of m_orchList is preserved.
+ */
+void OrchDaemon::retryPendingTasks()
+{
+    auto now = std::chrono::steady_clock::now();
+
+    for (Orch *o : m_orchList)
+    {
+        if (o->hasPendingTasks() && o->isRetryDue(now))
+        {
+            o->doRetryTask(now);
+        }
+    }
+}
+
 /*
  * Try to perform orchagent state restore and dynamic states sync up if
  * warm start request is detected.
@@ -834,6 +939,25 @@ void OrchDaemon::getTaskToSync(vector<string> &ts)
     }
 }
 
+/*
+ * Get pending and retry counts for every consumer that still has tasks left
+ */
+void OrchDaemon::getRetryStats(vector<string> &ts)
+{
+    for (Orch *o : m_orchList)
+    {
+        o->dumpRetryStats(ts);
+    }
+}
+
+
+/*
+ * Get the batch size and latency histograms of the sairedis flushes
+ */
+void OrchDaemon::getFlushStats(vector<string> &ts)
+{
+    m_flushPolicy.dump(ts);
+}
 
 /* Perform basic validation after start restore for warm start */
 bool OrchDaemon::warmRestoreValidation()
@@ -880,6 +1004,13 @@ bool OrchDaemon::warmRestartCheck()
         {
             SWSS_LOG_NOTICE("    %s", s.c_str());
         }
+
+        vector<string> stats;
+        getRetryStats(stats);
+        for (auto &s : stats)
+        {
+            SWSS_LOG_NOTICE("    retry %s", s.c_str());
+        }
         if (!gSwitchOrch->skipPendingTaskCheck())
         {
             data = "NOT_READY";
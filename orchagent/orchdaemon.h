@@ -44,6 +44,7 @@
 #include "bfdorch.h"
 #include "srv6orch.h"
 #include "nvgreorch.h"
+#include "flushpolicy.h"
 
 using namespace swss;
 
@@ -57,6 +58,8 @@ public:
     void start();
     bool warmRestoreAndSyncUp();
     void getTaskToSync(vector<string> &ts);
+    void getRetryStats(vector<string> &ts);
+    void getFlushStats(vector<string> &ts);
     bool warmRestoreValidation();
 
     bool warmRestartCheck();
@@ -77,7 +80,14 @@ private:
     std::vector<Orch *> m_orchList;
     Select *m_select;
 
+    FlushPolicy m_flushPolicy;
+    uint64_t m_flushedTaskCount = 0;
+
     void flush();
+    void updateFlushPolicy();
+
+    int getSelectTimeout();
+    void retryPendingTasks();
 };
 
 class FabricOrchDaemon : public OrchDaemon
@@ -109,6 +109,34 @@ void PortsOrch::setPort(string alias, Port port)
     m_portList[alias] = port;
 }
 
+const Port *PortsOrch::findPort(const string &alias) const
+{
+    auto it = m_portList.find(alias);
+    return it == m_portList.end() ? nullptr : &it->second;
+}
+
+const Port *PortsOrch::findPort(sai_object_id_t id) const
+{
+    return nullptr;
+}
+
+const Port *PortsOrch::findPortByBridgePortId(sai_object_id_t bridge_port_id) const
+{
+    return nullptr;
+}
+
+bool PortsOrch::updatePort(const string &alias, const std::function<void(Port &)> &update)
+{
+    auto it = m_portList.find(alias);
+    if (it == m_portList.end())
+    {
+        return false;
+    }
+
+    update(it->second);
+    return true;
+}
+
 void PortsOrch::getCpuPort(Port &port)
 {
 }
@@ -123,6 +151,11 @@ bool PortsOrch::getVlanByVlanId(sai_vlan_id_t vlan_id, Port &vlan)
     return true;
 }
 
+const Port *PortsOrch::findVlanByVlanId(sai_vlan_id_t vlan_id) const
+{
+    return nullptr;
+}
+
 bool PortsOrch::setHostIntfsOperStatus(const Port &port, bool up) const
 {
     return true;
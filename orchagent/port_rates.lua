@@ -36,21 +36,30 @@ for i = 1, n do
     logit(initialized)
 
     -- Get new COUNTERS values
-    local in_ucast_pkts = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_IN_UCAST_PKTS')
-    local in_non_ucast_pkts = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS')
-    local out_ucast_pkts = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_OUT_UCAST_PKTS')
-    local out_non_ucast_pkts = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS')
-    local in_octets = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_IN_OCTETS')
-    local out_octets = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_OUT_OCTETS')
+    local counters = redis.call('HMGET', counters_table_name .. ':' .. KEYS[i],
+        'SAI_PORT_STAT_IF_IN_UCAST_PKTS', 'SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS',
+        'SAI_PORT_STAT_IF_OUT_UCAST_PKTS', 'SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS',
+        'SAI_PORT_STAT_IF_IN_OCTETS', 'SAI_PORT_STAT_IF_OUT_OCTETS')
+    local in_ucast_pkts = counters[1]
+    local in_non_ucast_pkts = counters[2]
+    local out_ucast_pkts = counters[3]
+    local out_non_ucast_pkts = counters[4]
+    local in_octets = counters[5]
+    local out_octets = counters[6]
 
     if initialized == 'DONE' or initialized == 'COUNTERS_LAST' then
-        -- Get old COUNTERS values
-        local in_ucast_pkts_last = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_IN_UCAST_PKTS_last')
-        local in_non_ucast_pkts_last = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS_last')
-        local out_ucast_pkts_last = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_OUT_UCAST_PKTS_last')
-        local out_non_ucast_pkts_last = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS_last')
-        local in_octets_last = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_IN_OCTETS_last')
-        local out_octets_last = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_OUT_OCTETS_last')
+        -- Get old COUNTERS and rates values
+        local last = redis.call('HMGET', rates_table_name .. ':' .. KEYS[i],
+            'SAI_PORT_STAT_IF_IN_UCAST_PKTS_last', 'SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS_last',
+            'SAI_PORT_STAT_IF_OUT_UCAST_PKTS_last', 'SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS_last',
+            'SAI_PORT_STAT_IF_IN_OCTETS_last', 'SAI_PORT_STAT_IF_OUT_OCTETS_last',
+            'RX_BPS', 'RX_PPS', 'TX_BPS', 'TX_PPS')
+        local in_ucast_pkts_last = last[1]
+        local in_non_ucast_pkts_last = last[2]
+        local out_ucast_pkts_last = last[3]
+        local out_non_ucast_pkts_last = last[4]
+        local in_octets_last = last[5]
+        local out_octets_last = last[6]
 
         -- Calculate new rates values
         local rx_bps_new = (in_octets - in_octets_last) / delta * 1000
@@ -60,22 +69,24 @@ for i = 1, n do
 
         if initialized == "DONE" then
             -- Get old rates values
-            local rx_bps_old = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'RX_BPS')
-            local rx_pps_old = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'RX_PPS')
-            local tx_bps_old = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'TX_BPS')
-            local tx_pps_old = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'TX_PPS')
+            local rx_bps_old = last[7]
+            local rx_pps_old = last[8]
+            local tx_bps_old = last[9]
+            local tx_pps_old = last[10]
 
             -- Smooth the rates values and store them in DB
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'RX_BPS', alpha*rx_bps_new + one_minus_alpha*rx_bps_old)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'RX_PPS', alpha*rx_pps_new + one_minus_alpha*rx_pps_old)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'TX_BPS', alpha*tx_bps_new + one_minus_alpha*tx_bps_old)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'TX_PPS', alpha*tx_pps_new + one_minus_alpha*tx_pps_old)
+            redis.call('HMSET', rates_table_name .. ':' .. KEYS[i],
+                'RX_BPS', alpha*rx_bps_new + one_minus_alpha*rx_bps_old,
+                'RX_PPS', alpha*rx_pps_new + one_minus_alpha*rx_pps_old,
+                'TX_BPS', alpha*tx_bps_new + one_minus_alpha*tx_bps_old,
+                'TX_PPS', alpha*tx_pps_new + one_minus_alpha*tx_pps_old)
         else
             -- Store unsmoothed initial rates values in DB
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'RX_BPS', rx_bps_new)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'RX_PPS', rx_pps_new)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'TX_BPS', tx_bps_new)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'TX_PPS', tx_pps_new)
+            redis.call('HMSET', rates_table_name .. ':' .. KEYS[i],
+                'RX_BPS', rx_bps_new,
+                'RX_PPS', rx_pps_new,
+                'TX_BPS', tx_bps_new,
+                'TX_PPS', tx_pps_new)
             redis.call('HSET', state_table, 'INIT_DONE', 'DONE')
         end
     else
@@ -83,12 +94,13 @@ for i = 1, n do
     end
 
     -- Set old COUNTERS values
-    redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_IN_UCAST_PKTS_last', in_ucast_pkts)
-    redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS_last', in_non_ucast_pkts)
-    redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_OUT_UCAST_PKTS_last', out_ucast_pkts)
-    redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS_last', out_non_ucast_pkts)
-    redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_IN_OCTETS_last', in_octets)
-    redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'SAI_PORT_STAT_IF_OUT_OCTETS_last', out_octets)
+    redis.call('HMSET', rates_table_name .. ':' .. KEYS[i],
+        'SAI_PORT_STAT_IF_IN_UCAST_PKTS_last', in_ucast_pkts,
+        'SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS_last', in_non_ucast_pkts,
+        'SAI_PORT_STAT_IF_OUT_UCAST_PKTS_last', out_ucast_pkts,
+        'SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS_last', out_non_ucast_pkts,
+        'SAI_PORT_STAT_IF_IN_OCTETS_last', in_octets,
+        'SAI_PORT_STAT_IF_OUT_OCTETS_last', out_octets)
 end
 
 return logtable
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <tuple>
 #include <sstream>
+#include <chrono>
 #include <unordered_set>
 #include <boost/algorithm/string.hpp>
 
@@ -28,6 +29,7 @@
 #include "sai_serialize.h"
 #include "crmorch.h"
 #include "countercheckorch.h"
+#include "watermarkorch.h"
 #include "notifier.h"
 #include "fdborch.h"
 #include "stringutility.h"
@@ -329,7 +331,8 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
     m_pgIndexTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_PG_INDEX_MAP));
 
     m_flex_db = shared_ptr<DBConnector>(new DBConnector("FLEX_COUNTER_DB", 0));
-    m_flexCounterTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_TABLE));
+    m_flexCounterPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(m_flex_db.get()));
+    m_flexCounterTable = unique_ptr<ProducerTable>(new ProducerTable(m_flexCounterPipeline.get(), FLEX_COUNTER_TABLE));
     m_flexCounterGroupTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_GROUP_TABLE));
 
     m_state_db = shared_ptr<DBConnector>(new DBConnector("STATE_DB", 0));
@@ -731,15 +734,15 @@ bool PortsOrch::getPort(string alias, Port &p)
 {
     SWSS_LOG_ENTER();
 
-    if (m_portList.find(alias) == m_portList.end())
+    const Port *port = findPort(alias);
+    if (port == nullptr)
     {
         return false;
     }
-    else
-    {
-        p = m_portList[alias];
-        return true;
-    }
+
+    m_portCopyCount++;
+    p = *port;
+    return true;
 }
 
 bool PortsOrch::getPort(sai_object_id_t id, Port &port)
@@ -760,6 +763,50 @@ bool PortsOrch::getPort(sai_object_id_t id, Port &port)
     return false;
 }
 
+const Port *PortsOrch::findPort(const string &alias) const
+{
+    auto it = m_portList.find(alias);
+    if (it == m_portList.end())
+    {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+const Port *PortsOrch::findPort(sai_object_id_t id) const
+{
+    auto itr = saiOidToAlias.find(id);
+    if (itr == saiOidToAlias.end())
+    {
+        return nullptr;
+    }
+
+    return findPort(itr->second);
+}
+
+const Port *PortsOrch::findPortByBridgePortId(sai_object_id_t bridge_port_id) const
+{
+    return findPort(bridge_port_id);
+}
+
+bool PortsOrch::updatePort(const string &alias, const std::function<void(Port &)> &update)
+{
+    auto it = m_portList.find(alias);
+    if (it == m_portList.end())
+    {
+        return false;
+    }
+
+    update(it->second);
+    return true;
+}
+
+size_t PortsOrch::getPortCopyCount() const
+{
+    return m_portCopyCount;
+}
+
 void PortsOrch::increasePortRefCount(const string &alias)
 {
     assert (m_port_ref_count.find(alias) != m_port_ref_count.end());
@@ -3787,21 +3834,27 @@ void PortsOrch::doLagMemberTask(Consumer &consumer)
 
         string op = kfvOp(t);
 
-        Port lag, port;
-        if (!getPort(lag_alias, lag))
+        auto lag_it = m_portList.find(lag_alias);
+        if (lag_it == m_portList.end())
         {
             SWSS_LOG_INFO("Failed to locate LAG %s", lag_alias.c_str());
             it++;
             continue;
         }
 
-        if (!getPort(port_alias, port))
+        auto port_it = m_portList.find(port_alias);
+        if (port_it == m_portList.end())
         {
             SWSS_LOG_ERROR("Failed to locate port %s", port_alias.c_str());
             it = consumer.m_toSync.erase(it);
             continue;
         }
 
+        /* LAG and member are updated in place, a member storm would otherwise
+         * copy the LAG with its whole member set for every member */
+        Port &lag = lag_it->second;
+        Port &port = port_it->second;
+
         /* Fail if a port type is not a valid type for being a LAG member port.
          * Erase invalid entry, no need to retry in this case. */
         if (!isValidPortTypeForLagMember(port))
@@ -4478,6 +4531,7 @@ bool PortsOrch::addVlan(string vlan_alias)
     m_portList[vlan_alias] = vlan;
     m_port_ref_count[vlan_alias] = 0;
     saiOidToAlias[vlan_oid] =  vlan_alias;
+    vlanIdToAlias[vlan_id] = vlan_alias;
 
     return true;
 }
@@ -4541,6 +4595,7 @@ bool PortsOrch::removeVlan(Port vlan)
             vlan.m_vlan_info.vlan_id);
 
     saiOidToAlias.erase(vlan.m_vlan_info.vlan_oid);
+    vlanIdToAlias.erase(vlan.m_vlan_info.vlan_id);
     m_portList.erase(vlan.m_alias);
     m_port_ref_count.erase(vlan.m_alias);
 
@@ -4551,16 +4606,32 @@ bool PortsOrch::getVlanByVlanId(sai_vlan_id_t vlan_id, Port &vlan)
 {
     SWSS_LOG_ENTER();
 
-    for (auto &it: m_portList)
+    const Port *p = findVlanByVlanId(vlan_id);
+    if (p == nullptr)
     {
-        if (it.second.m_type == Port::VLAN && it.second.m_vlan_info.vlan_id == vlan_id)
-        {
-            vlan = it.second;
-            return true;
-        }
+        return false;
     }
 
-    return false;
+    m_portCopyCount++;
+    vlan = *p;
+    return true;
+}
+
+const Port *PortsOrch::findVlanByVlanId(sai_vlan_id_t vlan_id) const
+{
+    auto itr = vlanIdToAlias.find(vlan_id);
+    if (itr == vlanIdToAlias.end())
+    {
+        return nullptr;
+    }
+
+    auto it = m_portList.find(itr->second);
+    if (it == m_portList.end())
+    {
+        return nullptr;
+    }
+
+    return &it->second;
 }
 
 bool PortsOrch::addVlanMember(Port &vlan, Port &port, string &tagging_mode, string end_point_ip)
@@ -4911,7 +4982,7 @@ bool PortsOrch::removeVlanMember(Port &vlan, Port &port, string end_point_ip)
     return true;
 }
 
-bool PortsOrch::isVlanMember(Port &vlan, Port &port, string end_point_ip)
+bool PortsOrch::isVlanMember(const Port &vlan, const Port &port, string end_point_ip)
 {
     if (!end_point_ip.empty())
     {
@@ -5170,11 +5241,8 @@ bool PortsOrch::addLagMember(Port &lag, Port &port, bool enableForwarding)
 
     port.m_lag_id = lag.m_lag_id;
     port.m_lag_member_id = lag_member_id;
-    m_portList[port.m_alias] = port;
     lag.m_members.insert(port.m_alias);
 
-    m_portList[lag.m_alias] = lag;
-
     if (lag.m_bridge_port_id > 0)
     {
         if (!setHostIntfsStripTag(port, SAI_HOSTIF_VLAN_TAG_KEEP))
@@ -5219,9 +5287,7 @@ bool PortsOrch::removeLagMember(Port &lag, Port &port)
 
     port.m_lag_id = 0;
     port.m_lag_member_id = 0;
-    m_portList[port.m_alias] = port;
     lag.m_members.erase(port.m_alias);
-    m_portList[lag.m_alias] = lag;
 
     if (lag.m_bridge_port_id > 0)
     {
@@ -5387,14 +5453,28 @@ void PortsOrch::generateQueueMap()
         return;
     }
 
-    for (const auto& it: m_portList)
+    auto begin = chrono::steady_clock::now();
+
+    /* Queue counters of all the ports are written to FLEX_COUNTER_DB in pipelined batches */
     {
-        if (it.second.m_type == Port::PHY)
+        FlexCounterBulk bulk(queue_stat_manager);
+        m_flexCounterTable->setBuffered(true);
+
+        for (const auto& it: m_portList)
         {
-            generateQueueMapPerPort(it.second);
+            if (it.second.m_type == Port::PHY)
+            {
+                generateQueueMapPerPort(it.second);
+            }
         }
+
+        m_flexCounterTable->flush();
+        m_flexCounterTable->setBuffered(false);
     }
 
+    auto duration = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - begin);
+    SWSS_LOG_NOTICE("Generated queue counter map in %" PRId64 " ms", static_cast<int64_t>(duration.count()));
+
     m_isQueueMapGenerated = true;
 }
 
@@ -5407,6 +5487,23 @@ void PortsOrch::generateQueueMapPerPort(const Port& port)
     vector<FieldValueTuple> queueIndexVector;
     vector<FieldValueTuple> queueTypeVector;
 
+    std::unordered_set<string> counter_stats;
+    for (const auto& it: queue_stat_ids)
+    {
+        counter_stats.emplace(sai_serialize_queue_stat(it));
+    }
+
+    string delimiter("");
+    std::ostringstream counters_stream;
+    for (const auto& it: queueWatermarkStatIds)
+    {
+        counters_stream << delimiter << sai_serialize_queue_stat(it);
+        delimiter = comma;
+    }
+
+    vector<FieldValueTuple> fieldValues;
+    fieldValues.emplace_back(QUEUE_COUNTER_ID_LIST, counters_stream.str());
+
     for (size_t queueIndex = 0; queueIndex < port.m_queue_ids.size(); ++queueIndex)
     {
         std::ostringstream name;
@@ -5425,36 +5522,25 @@ void PortsOrch::generateQueueMapPerPort(const Port& port)
             queueIndexVector.emplace_back(id, to_string(queueRealIndex));
         }
 
-        // Install a flex counter for this queue to track stats
-        std::unordered_set<string> counter_stats;
-        for (const auto& it: queue_stat_ids)
-        {
-            counter_stats.emplace(sai_serialize_queue_stat(it));
-        }
-        queue_stat_manager.setCounterIdList(port.m_queue_ids[queueIndex], CounterType::QUEUE, counter_stats);
-
         /* add watermark queue counters */
         string key = getQueueWatermarkFlexCounterTableKey(id);
-
-        string delimiter("");
-        std::ostringstream counters_stream;
-        for (const auto& it: queueWatermarkStatIds)
-        {
-            counters_stream << delimiter << sai_serialize_queue_stat(it);
-            delimiter = comma;
-        }
-
-        vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(QUEUE_COUNTER_ID_LIST, counters_stream.str());
-
         m_flexCounterTable->set(key, fieldValues);
     }
 
+    // Install a flex counter for the queues to track stats
+    queue_stat_manager.setCounterIdListBulk(port.m_queue_ids, CounterType::QUEUE, counter_stats);
+
     m_queueTable->set("", queueVector);
     m_queuePortTable->set("", queuePortVector);
     m_queueIndexTable->set("", queueIndexVector);
     m_queueTypeTable->set("", queueTypeVector);
 
+    CounterCheckOrch::getInstance().addQueueTypes(queueTypeVector);
+    auto wm_orch = gDirectory.get<WatermarkOrch*>();
+    if (wm_orch)
+    {
+        wm_orch->invalidateQueueIds();
+    }
     CounterCheckOrch::getInstance().addPort(port);
 }
 
@@ -5465,6 +5551,11 @@ void PortsOrch::generatePriorityGroupMap()
         return;
     }
 
+    auto begin = chrono::steady_clock::now();
+
+    /* PG counters of all the ports are written to FLEX_COUNTER_DB in pipelined batches */
+    m_flexCounterTable->setBuffered(true);
+
     for (const auto& it: m_portList)
     {
         if (it.second.m_type == Port::PHY)
@@ -5473,6 +5564,12 @@ void PortsOrch::generatePriorityGroupMap()
         }
     }
 
+    m_flexCounterTable->flush();
+    m_flexCounterTable->setBuffered(false);
+
+    auto duration = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - begin);
+    SWSS_LOG_NOTICE("Generated priority group counter map in %" PRId64 " ms", static_cast<int64_t>(duration.count()));
+
     m_isPriorityGroupMapGenerated = true;
 }
 
@@ -5531,6 +5628,12 @@ void PortsOrch::generatePriorityGroupMapPerPort(const Port& port)
     m_pgPortTable->set("", pgPortVector);
     m_pgIndexTable->set("", pgIndexVector);
 
+    auto wm_orch = gDirectory.get<WatermarkOrch*>();
+    if (wm_orch)
+    {
+        wm_orch->invalidatePgIds();
+    }
+
     CounterCheckOrch::getInstance().addPort(port);
 }
 
@@ -5542,6 +5645,7 @@ void PortsOrch::generatePortCounterMap()
     }
 
     auto port_counter_stats = generateCounterStats(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP);
+    vector<sai_object_id_t> port_ids;
     for (const auto& it: m_portList)
     {
         // Set counter stats only for PHY ports to ensure syncd will not try to query the counter statistics from the HW for non-PHY ports.
@@ -5549,8 +5653,9 @@ void PortsOrch::generatePortCounterMap()
         {
             continue;
         }
-        port_stat_manager.setCounterIdList(it.second.m_port_id, CounterType::PORT, port_counter_stats);
+        port_ids.push_back(it.second.m_port_id);
     }
+    port_stat_manager.setCounterIdListBulk(port_ids, CounterType::PORT, port_counter_stats);
 
     m_isPortCounterMapGenerated = true;
 }
@@ -5563,6 +5668,7 @@ void PortsOrch::generatePortBufferDropCounterMap()
     }
 
     auto port_buffer_drop_stats = generateCounterStats(PORT_BUFFER_DROP_STAT_FLEX_COUNTER_GROUP);
+    vector<sai_object_id_t> port_ids;
     for (const auto& it: m_portList)
     {
         // Set counter stats only for PHY ports to ensure syncd will not try to query the counter statistics from the HW for non-PHY ports.
@@ -5570,8 +5676,9 @@ void PortsOrch::generatePortBufferDropCounterMap()
         {
             continue;
         }
-        port_buffer_drop_stat_manager.setCounterIdList(it.second.m_port_id, CounterType::PORT, port_buffer_drop_stats);
+        port_ids.push_back(it.second.m_port_id);
     }
+    port_buffer_drop_stat_manager.setCounterIdListBulk(port_ids, CounterType::PORT, port_buffer_drop_stats);
 
     m_isPortBufferDropCounterMapGenerated = true;
 }
@@ -2,6 +2,7 @@
 #define SWSS_PORTSORCH_H
 
 #include <map>
+#include <functional>
 
 #include "acltable.h"
 #include "orch.h"
@@ -9,6 +10,7 @@
 #include "observer.h"
 #include "macaddress.h"
 #include "producertable.h"
+#include "redispipeline.h"
 #include "flex_counter_manager.h"
 #include "gearboxutils.h"
 #include "saihelper.h"
@@ -93,9 +95,20 @@ public:
     void decreasePortRefCount(const string &alias);
     bool getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port);
     void setPort(string alias, Port port);
+
+    /* Non-copying lookups, the returned pointer is valid until the port is removed */
+    const Port *findPort(const string &alias) const;
+    const Port *findPort(sai_object_id_t id) const;
+    const Port *findPortByBridgePortId(sai_object_id_t bridge_port_id) const;
+    /* Apply an in-place update to a stored port, returns false if the port doesn't exist */
+    bool updatePort(const string &alias, const std::function<void(Port &)> &update);
+    /* Number of ports copied by getPort() and getVlanByVlanId(), hot paths use findPort() instead */
+    size_t getPortCopyCount() const;
+
     void getCpuPort(Port &port);
     bool getInbandPort(Port &port);
     bool getVlanByVlanId(sai_vlan_id_t vlan_id, Port &vlan);
+    const Port *findVlanByVlanId(sai_vlan_id_t vlan_id) const;
 
     bool setHostIntfsOperStatus(const Port& port, bool up) const;
     void updateDbPortOperStatus(const Port& port, sai_port_oper_status_t status) const;
@@ -144,7 +157,7 @@ public:
     bool removeBridgePort(Port &port);
     bool addVlanMember(Port &vlan, Port &port, string& tagging_mode, string end_point_ip = "");
     bool removeVlanMember(Port &vlan, Port &port, string end_point_ip = "");
-    bool isVlanMember(Port &vlan, Port &port, string end_point_ip = "");
+    bool isVlanMember(const Port &vlan, const Port &port, string end_point_ip = "");
     bool addVlanFloodGroups(Port &vlan, Port &port, string end_point_ip);
     bool removeVlanEndPointIp(Port &vlan, Port &port, string end_point_ip);
     void increaseBridgePortRefCount(Port &port);
@@ -178,6 +191,7 @@ private:
     unique_ptr<Table> m_pgPortTable;
     unique_ptr<Table> m_pgIndexTable;
     unique_ptr<Table> m_stateBufferMaximumValueTable;
+    unique_ptr<RedisPipeline> m_flexCounterPipeline;
     unique_ptr<ProducerTable> m_flexCounterTable;
     unique_ptr<ProducerTable> m_flexCounterGroupTable;
     Table m_portStateTable;
@@ -229,12 +243,17 @@ private:
     map<set<int>, sai_object_id_t> m_portListLaneMap;
     map<set<int>, tuple<string, uint32_t, int, string, int, string>> m_lanesAliasSpeedMap;
     map<string, Port> m_portList;
+    size_t m_portCopyCount = 0;
     map<string, vlan_members_t> m_portVlanMember;
     /* mapping from SAI object ID to Name for faster
      * retrieval of Port/VLAN from object ID for events
      * coming from SAI
      */
     unordered_map<sai_object_id_t, string> saiOidToAlias;
+    /* mapping from VLAN ID to VLAN alias for faster retrieval
+     * of VLAN from VLAN ID for FDB events
+     */
+    unordered_map<sai_vlan_id_t, string> vlanIdToAlias;
     unordered_map<sai_object_id_t, int> m_portOidToIndex;
     map<string, uint32_t> m_port_ref_count;
     unordered_set<string> m_pendingPortSet;
@@ -276,6 +295,7 @@ private:
     bool addLag(string lag, uint32_t spa_id, int32_t switch_id);
     bool removeLag(Port lag);
     bool setLagTpid(sai_object_id_t id, sai_uint16_t tpid);
+    /* lag and port are the entries stored in m_portList, they are updated in place */
     bool addLagMember(Port &lag, Port &port, bool enableForwarding);
     bool removeLagMember(Port &lag, Port &port);
     bool setCollectionOnLagMember(Port &lagMember, bool enableCollection);
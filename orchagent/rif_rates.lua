@@ -32,17 +32,24 @@ for i = 1, n do
     logit(initialized)
 
     -- Get new COUNTERS values
-    local in_octets = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], 'SAI_ROUTER_INTERFACE_STAT_IN_OCTETS')
-    local in_pkts = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], 'SAI_ROUTER_INTERFACE_STAT_IN_PACKETS')
-    local out_octets = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], 'SAI_ROUTER_INTERFACE_STAT_OUT_OCTETS')
-    local out_pkts = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], 'SAI_ROUTER_INTERFACE_STAT_OUT_PACKETS')
+    local counters = redis.call('HMGET', counters_table_name .. ':' .. KEYS[i],
+        'SAI_ROUTER_INTERFACE_STAT_IN_OCTETS', 'SAI_ROUTER_INTERFACE_STAT_IN_PACKETS',
+        'SAI_ROUTER_INTERFACE_STAT_OUT_OCTETS', 'SAI_ROUTER_INTERFACE_STAT_OUT_PACKETS')
+    local in_octets = counters[1]
+    local in_pkts = counters[2]
+    local out_octets = counters[3]
+    local out_pkts = counters[4]
 
     if initialized == "DONE" or initialized == "COUNTERS_LAST" then
-        -- Get old COUNTERS values
-        local in_octets_last = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'SAI_ROUTER_INTERFACE_STAT_IN_OCTETS_last')
-        local in_pkts_last = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'SAI_ROUTER_INTERFACE_STAT_IN_PACKETS_last')
-        local out_octets_last = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'SAI_ROUTER_INTERFACE_STAT_OUT_OCTETS_last')
-        local out_pkts_last = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'SAI_ROUTER_INTERFACE_STAT_OUT_PACKETS_last')
+        -- Get old COUNTERS and rates values
+        local last = redis.call('HMGET', rates_table_name .. ':' .. KEYS[i],
+            'SAI_ROUTER_INTERFACE_STAT_IN_OCTETS_last', 'SAI_ROUTER_INTERFACE_STAT_IN_PACKETS_last',
+            'SAI_ROUTER_INTERFACE_STAT_OUT_OCTETS_last', 'SAI_ROUTER_INTERFACE_STAT_OUT_PACKETS_last',
+            'RX_BPS', 'RX_PPS', 'TX_BPS', 'TX_PPS')
+        local in_octets_last = last[1]
+        local in_pkts_last = last[2]
+        local out_octets_last = last[3]
+        local out_pkts_last = last[4]
 
         -- Calculate new rates values
         local rx_bps_new = (in_octets - in_octets_last) / delta * 1000
@@ -52,22 +59,24 @@ for i = 1, n do
 
         if initialized == "DONE" then
             -- Get old rates values
-            local rx_bps_old = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'RX_BPS')
-            local rx_pps_old = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'RX_PPS')
-            local tx_bps_old = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'TX_BPS')
-            local tx_pps_old = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'TX_PPS')
+            local rx_bps_old = last[5]
+            local rx_pps_old = last[6]
+            local tx_bps_old = last[7]
+            local tx_pps_old = last[8]
 
             -- Smooth the rates values and store them in DB
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'RX_BPS', alpha*rx_bps_new + one_minus_alpha*rx_bps_old)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'RX_PPS', alpha*rx_pps_new + one_minus_alpha*rx_pps_old)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'TX_BPS', alpha*tx_bps_new + one_minus_alpha*tx_bps_old)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'TX_PPS', alpha*tx_pps_new + one_minus_alpha*tx_pps_old)
+            redis.call('HMSET', rates_table_name .. ':' .. KEYS[i],
+                'RX_BPS', alpha*rx_bps_new + one_minus_alpha*rx_bps_old,
+                'RX_PPS', alpha*rx_pps_new + one_minus_alpha*rx_pps_old,
+                'TX_BPS', alpha*tx_bps_new + one_minus_alpha*tx_bps_old,
+                'TX_PPS', alpha*tx_pps_new + one_minus_alpha*tx_pps_old)
         else
             -- Store unsmoothed initial rates values in DB
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'RX_BPS', rx_bps_new)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'RX_PPS', rx_pps_new)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'TX_BPS', tx_bps_new)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'TX_PPS', tx_pps_new)
+            redis.call('HMSET', rates_table_name .. ':' .. KEYS[i],
+                'RX_BPS', rx_bps_new,
+                'RX_PPS', rx_pps_new,
+                'TX_BPS', tx_bps_new,
+                'TX_PPS', tx_pps_new)
             redis.call('HSET', state_table, 'INIT_DONE', 'DONE')
         end
     else
@@ -75,10 +84,11 @@ for i = 1, n do
     end
 
     -- Set old COUNTERS values
-    redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'SAI_ROUTER_INTERFACE_STAT_IN_OCTETS_last', in_octets)
-    redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'SAI_ROUTER_INTERFACE_STAT_IN_PACKETS_last', in_pkts)
-    redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'SAI_ROUTER_INTERFACE_STAT_OUT_OCTETS_last', out_octets)
-    redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'SAI_ROUTER_INTERFACE_STAT_OUT_PACKETS_last', out_pkts)
+    redis.call('HMSET', rates_table_name .. ':' .. KEYS[i],
+        'SAI_ROUTER_INTERFACE_STAT_IN_OCTETS_last', in_octets,
+        'SAI_ROUTER_INTERFACE_STAT_IN_PACKETS_last', in_pkts,
+        'SAI_ROUTER_INTERFACE_STAT_OUT_OCTETS_last', out_octets,
+        'SAI_ROUTER_INTERFACE_STAT_OUT_PACKETS_last', out_pkts)
 end
 
 return logtable
@@ -754,6 +754,8 @@ void RouteOrch::doTask(Consumer& consumer)
                     }
                     else if (overlay_nh == false)
                     {
+                        /* VRF aliases are resolved against the current interfaces, don't intern them */
+                        bool cacheable = true;
                         for (uint32_t i = 0; i < ipv.size(); i++)
                         {
                             if (i) nhg_str += NHG_DELIMITER;
@@ -761,6 +763,10 @@ void RouteOrch::doTask(Consumer& consumer)
                             {
                                 alsv[i] = gIntfsOrch->getRouterIntfsAlias(ipv[i]);
                             }
+                            if (!alsv[i].compare(0, strlen(VRF_PREFIX), VRF_PREFIX))
+                            {
+                                cacheable = false;
+                            }
                             if (!mpls_nhv.empty() && mpls_nhv[i] != "na")
                             {
                                 nhg_str += mpls_nhv[i] + LABELSTACK_DELIMITER;
@@ -768,7 +774,14 @@ void RouteOrch::doTask(Consumer& consumer)
                             nhg_str += ipv[i] + NH_DELIMITER + alsv[i];
                         }
 
-                        nhg = NextHopGroupKey(nhg_str, weights);
+                        if (cacheable)
+                        {
+                            nhg = m_nhgKeyCache.get(nhg_str, weights);
+                        }
+                        else
+                        {
+                            nhg = NextHopGroupKey(nhg_str, weights);
+                        }
                     }
                     else
                     {
@@ -0,0 +1,196 @@
+#ifndef SWSS_SYNCMAP_H
+#define SWSS_SYNCMAP_H
+
+#include <functional>
+#include <list>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include "table.h"
+
+/*
+ * Pending task queue of a Consumer.
+ *
+ * Keeps the multimap interface the orchs iterate with (it->first,
+ * it->second, erase(it), find, count, equal_range, reverse iteration),
+ * but with O(1) key lookup and FIFO order across keys instead of the
+ * lexicographic order of std::multimap. Like std::multimap, the entries
+ * of one key are adjacent and kept in insertion order: a new entry for a
+ * key already queued is placed right after the last entry of that key.
+ *
+ * Iterators stay valid until the entry they point to is erased.
+ */
+class SyncMap
+{
+public:
+    typedef std::string key_type;
+    typedef swss::KeyOpFieldsValuesTuple mapped_type;
+    typedef std::pair<const key_type, mapped_type> value_type;
+
+private:
+    typedef std::list<value_type> List;
+
+public:
+    typedef List::iterator iterator;
+    typedef List::const_iterator const_iterator;
+    typedef List::reverse_iterator reverse_iterator;
+    typedef List::const_reverse_iterator const_reverse_iterator;
+    typedef List::size_type size_type;
+
+    SyncMap() = default;
+
+    /* The index points into m_list, copying would leave it dangling */
+    SyncMap(const SyncMap&) = delete;
+    SyncMap& operator=(const SyncMap&) = delete;
+
+    iterator begin() { return m_list.begin(); }
+    iterator end() { return m_list.end(); }
+    const_iterator begin() const { return m_list.begin(); }
+    const_iterator end() const { return m_list.end(); }
+    reverse_iterator rbegin() { return m_list.rbegin(); }
+    reverse_iterator rend() { return m_list.rend(); }
+    const_reverse_iterator rbegin() const { return m_list.rbegin(); }
+    const_reverse_iterator rend() const { return m_list.rend(); }
+
+    size_type size() const { return m_list.size(); }
+    bool empty() const { return m_list.empty(); }
+
+    void clear()
+    {
+        m_index.clear();
+        m_list.clear();
+    }
+
+    /* Queue an entry after the entries already queued for the same key */
+    template <typename... Args>
+    iterator emplace(const key_type &key, Args&&... args)
+    {
+        auto idx = m_index.find(&key);
+        if (idx == m_index.end())
+        {
+            auto it = m_list.emplace(m_list.end(), std::piecewise_construct,
+                    std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+            m_index.emplace(&it->first, Range{ it, it, 1 });
+            return it;
+        }
+
+        Range &range = idx->second;
+        auto it = m_list.emplace(std::next(range.last), std::piecewise_construct,
+                std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+        range.last = it;
+        range.count++;
+        return it;
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        auto idx = m_index.find(&pos->first);
+        Range &range = idx->second;
+
+        if (range.count == 1)
+        {
+            /* The index key points into the node being erased */
+            m_index.erase(idx);
+        }
+        else
+        {
+            if (const_iterator(range.first) == pos)
+            {
+                /* Re-key the index on the node that becomes the first one */
+                iterator first = std::next(range.first);
+                Range rest{ first, range.last, range.count - 1 };
+                m_index.erase(idx);
+                m_index.emplace(&first->first, rest);
+            }
+            else
+            {
+                if (const_iterator(range.last) == pos)
+                {
+                    range.last = std::prev(range.last);
+                }
+                range.count--;
+            }
+        }
+
+        return m_list.erase(pos);
+    }
+
+    iterator erase(iterator pos)
+    {
+        return erase(const_iterator(pos));
+    }
+
+    size_type erase(const key_type &key)
+    {
+        auto idx = m_index.find(&key);
+        if (idx == m_index.end())
+        {
+            return 0;
+        }
+
+        Range range = idx->second;
+        m_index.erase(idx);
+        m_list.erase(range.first, std::next(range.last));
+        return range.count;
+    }
+
+    iterator find(const key_type &key)
+    {
+        auto idx = m_index.find(&key);
+        return idx == m_index.end() ? m_list.end() : idx->second.first;
+    }
+
+    const_iterator find(const key_type &key) const
+    {
+        auto idx = m_index.find(&key);
+        return idx == m_index.end() ? m_list.end() : const_iterator(idx->second.first);
+    }
+
+    size_type count(const key_type &key) const
+    {
+        auto idx = m_index.find(&key);
+        return idx == m_index.end() ? 0 : idx->second.count;
+    }
+
+    std::pair<iterator, iterator> equal_range(const key_type &key)
+    {
+        auto idx = m_index.find(&key);
+        if (idx == m_index.end())
+        {
+            return { m_list.end(), m_list.end() };
+        }
+        return { idx->second.first, std::next(idx->second.last) };
+    }
+
+private:
+    struct Range
+    {
+        iterator first;
+        iterator last;
+        size_type count;
+    };
+
+    /* The index is keyed on the key stored in the first list node of a key */
+    struct KeyHash
+    {
+        size_t operator()(const key_type *key) const
+        {
+            return std::hash<key_type>()(*key);
+        }
+    };
+
+    struct KeyEqual
+    {
+        bool operator()(const key_type *lhs, const key_type *rhs) const
+        {
+            return *lhs == *rhs;
+        }
+    };
+
+    List m_list;
+    std::unordered_map<const key_type *, Range, KeyHash, KeyEqual> m_index;
+};
+
+#endif /* SWSS_SYNCMAP_H */
@@ -39,29 +39,35 @@ for i = 1, n do
     local in_pkts = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], 'SAI_COUNTER_STAT_PACKETS')
 
     if initialized == 'DONE' or initialized == 'COUNTERS_LAST' then
-        -- Get old COUNTERS values
-        local in_pkts_last = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'SAI_COUNTER_STAT_PACKETS_last')
-        
+        -- Get old COUNTERS and rates values
+        local last = redis.call('HMGET', rates_table_name .. ':' .. KEYS[i],
+            'SAI_COUNTER_STAT_PACKETS_last', 'RX_PPS')
+        local in_pkts_last = last[1]
+
         -- Calculate new rates values
         local rx_pps_new = (in_pkts - in_pkts_last) / delta * 1000
 
         if initialized == "DONE" then
             -- Get old rates values
-            local rx_pps_old = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'RX_PPS')
+            local rx_pps_old = last[2]
 
-            -- Smooth the rates values and store them in DB
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'RX_PPS', alpha*rx_pps_new + one_minus_alpha*rx_pps_old)
+            -- Smooth the rates values and store them in DB, along with the old COUNTERS values
+            redis.call('HMSET', rates_table_name .. ':' .. KEYS[i],
+                'RX_PPS', alpha*rx_pps_new + one_minus_alpha*rx_pps_old,
+                'SAI_COUNTER_STAT_PACKETS_last', in_pkts)
         else
-            -- Store unsmoothed initial rates values in DB
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'RX_PPS', rx_pps_new)
+            -- Store unsmoothed initial rates values in DB, along with the old COUNTERS values
+            redis.call('HMSET', rates_table_name .. ':' .. KEYS[i],
+                'RX_PPS', rx_pps_new,
+                'SAI_COUNTER_STAT_PACKETS_last', in_pkts)
             redis.call('HSET', state_table, 'INIT_DONE', 'DONE')
-        end        
-    else  
+        end
+    else
         redis.call('HSET', state_table, 'INIT_DONE', 'COUNTERS_LAST')
-    end
 
-    -- Set old COUNTERS values
-    redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'SAI_COUNTER_STAT_PACKETS_last', in_pkts)    
+        -- Set old COUNTERS values
+        redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'SAI_COUNTER_STAT_PACKETS_last', in_pkts)
+    end
 end
 
 return logtable
@@ -32,32 +32,26 @@ for i = 1, n do
     local initialized = redis.call('HGET', state_table, 'INIT_DONE')
     logit(initialized)
 
-    -- Get new COUNTERS values
-    local in_octets = 0
-    local in_packets = 0
-    local out_octets = 0
-    local out_packets = 0
-
-    if redis.call('HEXISTS', counters_table_name .. ':' .. KEYS[i], 'SAI_TUNNEL_STAT_IN_OCTETS') == 1 then
-        in_octets = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], 'SAI_TUNNEL_STAT_IN_OCTETS')
-    end
-    if redis.call('HEXISTS', counters_table_name .. ':' .. KEYS[i], 'SAI_TUNNEL_STAT_IN_PACKETS') == 1 then
-        in_packets = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], 'SAI_TUNNEL_STAT_IN_PACKETS')
-    end
-    if redis.call('HEXISTS', counters_table_name .. ':' .. KEYS[i], 'SAI_TUNNEL_STAT_OUT_OCTETS') == 1 then
-        out_octets = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], 'SAI_TUNNEL_STAT_OUT_OCTETS')
-    end
-    if redis.call('HEXISTS', counters_table_name .. ':' .. KEYS[i], 'SAI_TUNNEL_STAT_OUT_PACKETS') == 1 then
-        out_packets = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], 'SAI_TUNNEL_STAT_OUT_PACKETS')
-    end
+    -- Get new COUNTERS values, a counter the tunnel doesn't report reads as 0
+    local counters = redis.call('HMGET', counters_table_name .. ':' .. KEYS[i],
+        'SAI_TUNNEL_STAT_IN_OCTETS', 'SAI_TUNNEL_STAT_IN_PACKETS',
+        'SAI_TUNNEL_STAT_OUT_OCTETS', 'SAI_TUNNEL_STAT_OUT_PACKETS')
+    local in_octets = counters[1] or 0
+    local in_packets = counters[2] or 0
+    local out_octets = counters[3] or 0
+    local out_packets = counters[4] or 0
 
     if initialized == "DONE" or initialized == "COUNTERS_LAST" then
-        -- Get old COUNTERS values
-        local in_octets_last = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'SAI_TUNNEL_STAT_IN_OCTETS_last')
-        local in_packets_last = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'SAI_TUNNEL_STAT_IN_PACKETS_last')
-        local out_octets_last = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'SAI_TUNNEL_STAT_OUT_OCTETS_last')
-        local out_packets_last = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'SAI_TUNNEL_STAT_OUT_PACKETS_last')
-        
+        -- Get old COUNTERS and rates values
+        local last = redis.call('HMGET', rates_table_name .. ':' .. KEYS[i],
+            'SAI_TUNNEL_STAT_IN_OCTETS_last', 'SAI_TUNNEL_STAT_IN_PACKETS_last',
+            'SAI_TUNNEL_STAT_OUT_OCTETS_last', 'SAI_TUNNEL_STAT_OUT_PACKETS_last',
+            'RX_BPS', 'RX_PPS', 'TX_BPS', 'TX_PPS')
+        local in_octets_last = last[1]
+        local in_packets_last = last[2]
+        local out_octets_last = last[3]
+        local out_packets_last = last[4]
+
         -- Calculate new rates values
         local rx_bps_new = (in_octets - in_octets_last)*sec_to_ms/delta
         local tx_bps_new = (out_octets - out_octets_last)*sec_to_ms/delta
@@ -66,33 +60,36 @@ for i = 1, n do
 
         if initialized == "DONE" then
             -- Get old rates values
-            local rx_bps_old = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'RX_BPS')
-            local rx_pps_old = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'RX_PPS')
-            local tx_bps_old = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'TX_BPS')
-            local tx_pps_old = redis.call('HGET', rates_table_name .. ':' .. KEYS[i], 'TX_PPS')
+            local rx_bps_old = last[5]
+            local rx_pps_old = last[6]
+            local tx_bps_old = last[7]
+            local tx_pps_old = last[8]
 
             -- Smooth the rates values and store them in DB
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'RX_BPS', alpha*rx_bps_new + one_minus_alpha*rx_bps_old)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'RX_PPS', alpha*rx_pps_new + one_minus_alpha*rx_pps_old)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'TX_BPS', alpha*tx_bps_new + one_minus_alpha*tx_bps_old)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'TX_PPS', alpha*tx_pps_new + one_minus_alpha*tx_pps_old)   
+            redis.call('HMSET', rates_table_name .. ':' .. KEYS[i],
+                'RX_BPS', alpha*rx_bps_new + one_minus_alpha*rx_bps_old,
+                'RX_PPS', alpha*rx_pps_new + one_minus_alpha*rx_pps_old,
+                'TX_BPS', alpha*tx_bps_new + one_minus_alpha*tx_bps_old,
+                'TX_PPS', alpha*tx_pps_new + one_minus_alpha*tx_pps_old)
         else
             -- Store unsmoothed initial rates values in DB
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'RX_BPS', rx_bps_new)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'RX_PPS', rx_pps_new)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'TX_BPS', tx_bps_new)
-            redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'TX_PPS', tx_pps_new)
+            redis.call('HMSET', rates_table_name .. ':' .. KEYS[i],
+                'RX_BPS', rx_bps_new,
+                'RX_PPS', rx_pps_new,
+                'TX_BPS', tx_bps_new,
+                'TX_PPS', tx_pps_new)
             redis.call('HSET', state_table, 'INIT_DONE', 'DONE')
-        end        
+        end
     else
         redis.call('HSET', state_table, 'INIT_DONE', 'COUNTERS_LAST')
     end
 
     -- Set old COUNTERS values
-    redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'SAI_TUNNEL_STAT_IN_OCTETS_last', in_octets)
-    redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'SAI_TUNNEL_STAT_IN_PACKETS_last', in_packets)
-    redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'SAI_TUNNEL_STAT_OUT_OCTETS_last', out_octets)
-    redis.call('HSET', rates_table_name .. ':' .. KEYS[i], 'SAI_TUNNEL_STAT_OUT_PACKETS_last', out_packets)
+    redis.call('HMSET', rates_table_name .. ':' .. KEYS[i],
+        'SAI_TUNNEL_STAT_IN_OCTETS_last', in_octets,
+        'SAI_TUNNEL_STAT_IN_PACKETS_last', in_packets,
+        'SAI_TUNNEL_STAT_OUT_OCTETS_last', out_octets,
+        'SAI_TUNNEL_STAT_OUT_PACKETS_last', out_packets)
 end
 
 return logtable
@@ -5,6 +5,7 @@
 #include "converter.h"
 #include "bufferorch.h"
 #include <inttypes.h>
+#include <algorithm>
 
 #define DEFAULT_TELEMETRY_INTERVAL 120
 
@@ -16,6 +17,14 @@
 #define CLEAR_BUFFER_POOL_REQUEST "BUFFER_POOL"
 #define CLEAR_HEADROOM_POOL_REQUEST "HEADROOM_POOL"
 
+#define WATERMARK_CLEAR_STATS_TABLE "WATERMARK_CLEAR_STATS"
+
+#define PG_XOFF_ROOM_WM "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES"
+#define PG_SHARED_WM "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES"
+#define QUEUE_SHARED_WM "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES"
+#define BUFFER_POOL_WM "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES"
+#define BUFFER_POOL_XOFF_ROOM_WM "SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES"
+
 extern PortsOrch *gPortsOrch;
 extern BufferOrch *gBufferOrch;
 
@@ -27,10 +36,13 @@ WatermarkOrch::WatermarkOrch(DBConnector *db, const vector<string> &tables):
 
     m_countersDb = make_shared<DBConnector>("COUNTERS_DB", 0);
     m_appDb = make_shared<DBConnector>("APPL_DB", 0);
+    m_countersPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(m_countersDb.get()));
     m_countersTable = make_shared<Table>(m_countersDb.get(), COUNTERS_TABLE);
-    m_periodicWatermarkTable = make_shared<Table>(m_countersDb.get(), PERIODIC_WATERMARKS_TABLE);
-    m_persistentWatermarkTable = make_shared<Table>(m_countersDb.get(), PERSISTENT_WATERMARKS_TABLE);
-    m_userWatermarkTable = make_shared<Table>(m_countersDb.get(), USER_WATERMARKS_TABLE);
+    /* The watermarks of a stat family are cleared in one pipelined batch */
+    m_periodicWatermarkTable = make_shared<Table>(m_countersPipeline.get(), PERIODIC_WATERMARKS_TABLE, true);
+    m_persistentWatermarkTable = make_shared<Table>(m_countersPipeline.get(), PERSISTENT_WATERMARKS_TABLE, true);
+    m_userWatermarkTable = make_shared<Table>(m_countersPipeline.get(), USER_WATERMARKS_TABLE, true);
+    m_clearStatsTable = make_shared<Table>(m_countersDb.get(), WATERMARK_CLEAR_STATS_TABLE);
 
     m_clearNotificationConsumer = new swss::NotificationConsumer(
             m_appDb.get(),
@@ -149,15 +161,8 @@ void WatermarkOrch::doTask(NotificationConsumer &consumer)
         return;
     }
 
-    if (m_pg_ids.empty())
-    {
-        init_pg_ids();
-    }
-
-    if (m_multicast_queue_ids.empty() and m_unicast_queue_ids.empty() and m_all_queue_ids.empty())
-    {
-        init_queue_ids();
-    }
+    init_pg_ids();
+    init_queue_ids();
 
     std::string op;
     std::string data;
@@ -181,68 +186,62 @@ void WatermarkOrch::doTask(NotificationConsumer &consumer)
         return;
     }
 
+    auto begin = chrono::steady_clock::now();
+    size_t objects = 0;
+
     if (data == CLEAR_PG_HEADROOM_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES",
-                      m_pg_ids);
+        clearWm(table, { PG_XOFF_ROOM_WM }, m_pg_ids);
+        objects = m_pg_ids.size();
     }
     else if (data == CLEAR_PG_SHARED_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES",
-                      m_pg_ids);
+        clearWm(table, { PG_SHARED_WM }, m_pg_ids);
+        objects = m_pg_ids.size();
     }
     else if (data == CLEAR_QUEUE_SHARED_UNI_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_unicast_queue_ids);
+        clearWm(table, { QUEUE_SHARED_WM }, m_unicast_queue_ids);
+        objects = m_unicast_queue_ids.size();
     }
     else if (data == CLEAR_QUEUE_SHARED_MULTI_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_multicast_queue_ids);
+        clearWm(table, { QUEUE_SHARED_WM }, m_multicast_queue_ids);
+        objects = m_multicast_queue_ids.size();
     }
     else if (data == CLEAR_QUEUE_SHARED_ALL_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_all_queue_ids);
+        clearWm(table, { QUEUE_SHARED_WM }, m_all_queue_ids);
+        objects = m_all_queue_ids.size();
     }
     else if (data == CLEAR_BUFFER_POOL_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES",
-                      gBufferOrch->getBufferPoolNameOidMap());
+        auto pool_ids = getBufferPoolIds();
+        clearWm(table, { BUFFER_POOL_WM }, pool_ids);
+        objects = pool_ids.size();
     }
     else if (data == CLEAR_HEADROOM_POOL_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES",
-                      gBufferOrch->getBufferPoolNameOidMap());
+        auto pool_ids = getBufferPoolIds();
+        clearWm(table, { BUFFER_POOL_XOFF_ROOM_WM }, pool_ids);
+        objects = pool_ids.size();
     }
     else
     {
         SWSS_LOG_WARN("Unknown watermark clear request data: %s", data.c_str());
         return;
     }
+
+    auto duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - begin);
+    publishClearStats(table, objects, duration);
 }
 
 void WatermarkOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
-    if (m_pg_ids.empty())
-    {
-        init_pg_ids();
-    }
-
-    if (m_multicast_queue_ids.empty() and m_unicast_queue_ids.empty() and m_all_queue_ids.empty())
-    {
-        init_queue_ids();
-    }
+    init_pg_ids();
+    init_queue_ids();
 
     if (&timer == m_telemetryTimer)
     {
@@ -256,27 +255,16 @@ void WatermarkOrch::doTask(SelectableTimer &timer)
             m_telemetryTimer->stop();
         }
 
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES",
-                      m_pg_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES",
-                      m_pg_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_unicast_queue_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_multicast_queue_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_all_queue_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES",
-                      gBufferOrch->getBufferPoolNameOidMap());
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES",
-                      gBufferOrch->getBufferPoolNameOidMap());
+        auto begin = chrono::steady_clock::now();
+        Table *table = m_periodicWatermarkTable.get();
+        auto pool_ids = getBufferPoolIds();
+
+        clearWm(table, { PG_XOFF_ROOM_WM, PG_SHARED_WM }, m_pg_ids);
+        clearWm(table, { QUEUE_SHARED_WM }, m_queue_ids);
+        clearWm(table, { BUFFER_POOL_WM, BUFFER_POOL_XOFF_ROOM_WM }, pool_ids);
+
+        auto duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - begin);
+        publishClearStats(table, m_pg_ids.size() + m_queue_ids.size() + pool_ids.size(), duration);
         SWSS_LOG_DEBUG("Periodic watermark cleared by timer!");
     }
 }
@@ -284,24 +272,47 @@ void WatermarkOrch::doTask(SelectableTimer &timer)
 void WatermarkOrch::init_pg_ids()
 {
     SWSS_LOG_ENTER();
+
+    if (!m_pgIdsDirty)
+    {
+        return;
+    }
+
     std::vector<FieldValueTuple> values;
     Table pg_index_table(m_countersDb.get(), COUNTERS_PG_INDEX_MAP);
     pg_index_table.get("", values);
-    for (auto fv: values)
+
+    m_pg_ids.clear();
+    m_pg_ids.reserve(values.size());
+    for (const auto &fv: values)
     {
         sai_object_id_t id;
         sai_deserialize_object_id(fv.first, id);
         m_pg_ids.push_back(id);
     }
+
+    m_pgIdsDirty = false;
 }
 
 void WatermarkOrch::init_queue_ids()
 {
     SWSS_LOG_ENTER();
+
+    if (!m_queueIdsDirty)
+    {
+        return;
+    }
+
     std::vector<FieldValueTuple> values;
     Table m_queue_type_table(m_countersDb.get(), COUNTERS_QUEUE_TYPE_MAP);
     m_queue_type_table.get("", values);
-    for (auto fv: values)
+
+    m_unicast_queue_ids.clear();
+    m_multicast_queue_ids.clear();
+    m_all_queue_ids.clear();
+    m_queue_ids.clear();
+    m_queue_ids.reserve(values.size());
+    for (const auto &fv: values)
     {
         sai_object_id_t id;
         sai_deserialize_object_id(fv.first, id);
@@ -317,32 +328,76 @@ void WatermarkOrch::init_queue_ids()
         {
             m_all_queue_ids.push_back(id);
         }
+        else
+        {
+            continue;
+        }
+        m_queue_ids.push_back(id);
     }
+
+    m_queueIdsDirty = false;
+}
+
+void WatermarkOrch::invalidatePgIds()
+{
+    m_pgIdsDirty = true;
 }
 
-void WatermarkOrch::clearSingleWm(Table *table, string wm_name, vector<sai_object_id_t> &obj_ids)
+void WatermarkOrch::invalidateQueueIds()
 {
-    /* Zero-out some WM in some table for some vector of object ids*/
+    m_queueIdsDirty = true;
+}
+
+vector<sai_object_id_t> WatermarkOrch::getBufferPoolIds() const
+{
+    const auto &nameOidMap = gBufferOrch->getBufferPoolNameOidMap();
+
+    vector<sai_object_id_t> obj_ids;
+    obj_ids.reserve(nameOidMap.size());
+    for (const auto &it : nameOidMap)
+    {
+        obj_ids.push_back(it.second.m_saiObjectId);
+    }
+
+    return obj_ids;
+}
+
+void WatermarkOrch::clearWm(Table *table, const vector<string> &wm_names, const vector<sai_object_id_t> &obj_ids)
+{
+    /* Zero-out the WMs of a stat family in some table for some vector of object ids,
+     * with one HSET per object, all sent in one pipelined batch */
     SWSS_LOG_ENTER();
-    SWSS_LOG_DEBUG("clear WM %s, for %zu obj ids", wm_name.c_str(), obj_ids.size());
+    SWSS_LOG_DEBUG("clear %zu WMs, for %zu obj ids", wm_names.size(), obj_ids.size());
 
-    vector<FieldValueTuple> vfvt = {{wm_name, "0"}};
+    vector<FieldValueTuple> vfvt;
+    vfvt.reserve(wm_names.size());
+    for (const auto &wm_name : wm_names)
+    {
+        vfvt.emplace_back(wm_name, "0");
+    }
 
     for (sai_object_id_t id: obj_ids)
     {
         table->set(sai_serialize_object_id(id), vfvt);
     }
+
+    table->flush();
 }
 
-void WatermarkOrch::clearSingleWm(Table *table, string wm_name, const object_reference_map &nameOidMap)
+void WatermarkOrch::publishClearStats(Table *table, size_t objects, chrono::microseconds duration)
 {
     SWSS_LOG_ENTER();
-    SWSS_LOG_DEBUG("clear WM %s, for %zu obj ids", wm_name.c_str(), nameOidMap.size());
 
-    vector<FieldValueTuple> fvTuples = {{wm_name, "0"}};
+    const string &name = table->getTableName();
+    auto &maxDuration = m_maxClearDuration[name];
+    maxDuration = max(maxDuration, duration);
 
-    for (const auto &it : nameOidMap)
-    {
-        table->set(sai_serialize_object_id(it.second.m_saiObjectId), fvTuples);
-    }
+    vector<FieldValueTuple> fieldValues;
+    fieldValues.emplace_back("objects", to_string(objects));
+    fieldValues.emplace_back("last_duration_us", to_string(duration.count()));
+    fieldValues.emplace_back("max_duration_us", to_string(maxDuration.count()));
+    m_clearStatsTable->set(name, fieldValues);
+
+    SWSS_LOG_INFO("Cleared %s of %zu objects in %" PRId64 " us",
+            name.c_str(), objects, static_cast<int64_t>(duration.count()));
 }
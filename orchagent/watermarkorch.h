@@ -2,11 +2,13 @@
 #define WATERMARKORCH_H
 
 #include <map>
+#include <chrono>
 
 #include "orch.h"
 #include "port.h"
 
 #include "notificationconsumer.h"
+#include "redispipeline.h"
 #include "timer.h"
 
 const uint8_t queue_wm_status_mask = 1 << 0;
@@ -30,12 +32,13 @@ public:
 
     void init_pg_ids();
     void init_queue_ids();
+    void invalidatePgIds();
+    void invalidateQueueIds();
 
     void handleWmConfigUpdate(const std::string &key, const std::vector<swss::FieldValueTuple> &fvt);
     void handleFcConfigUpdate(const std::string &key, const std::vector<swss::FieldValueTuple> &fvt);
 
-    void clearSingleWm(swss::Table *table, std::string wm_name, std::vector<sai_object_id_t> &obj_ids);
-    void clearSingleWm(swss::Table *table, std::string wm_name, const object_reference_map &nameOidMap);
+    void clearWm(swss::Table *table, const std::vector<std::string> &wm_names, const std::vector<sai_object_id_t> &obj_ids);
 
     std::shared_ptr<swss::Table> getCountersTable(void)
     {
@@ -48,6 +51,9 @@ public:
     }
 
 private:
+    std::vector<sai_object_id_t> getBufferPoolIds() const;
+    void publishClearStats(swss::Table *table, size_t objects, std::chrono::microseconds duration);
+
     /*
     [7-2] - unused
     [1] - pg wm status
@@ -58,10 +64,12 @@ private:
 
     std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
     std::shared_ptr<swss::DBConnector> m_appDb = nullptr;
+    std::unique_ptr<swss::RedisPipeline> m_countersPipeline = nullptr;
     std::shared_ptr<swss::Table> m_countersTable = nullptr;
     std::shared_ptr<swss::Table> m_periodicWatermarkTable = nullptr;
     std::shared_ptr<swss::Table> m_persistentWatermarkTable = nullptr;
     std::shared_ptr<swss::Table> m_userWatermarkTable = nullptr;
+    std::shared_ptr<swss::Table> m_clearStatsTable = nullptr;
 
     swss::NotificationConsumer* m_clearNotificationConsumer = nullptr;
     swss::SelectableTimer* m_telemetryTimer = nullptr;
@@ -69,7 +77,15 @@ private:
     std::vector<sai_object_id_t> m_unicast_queue_ids;
     std::vector<sai_object_id_t> m_multicast_queue_ids;
     std::vector<sai_object_id_t> m_all_queue_ids;
+    /* Queues of every type, cleared together by the timer */
+    std::vector<sai_object_id_t> m_queue_ids;
     std::vector<sai_object_id_t> m_pg_ids;
+
+    /* Set when the queue/PG maps in COUNTERS_DB change and the ids must be reloaded */
+    bool m_queueIdsDirty = true;
+    bool m_pgIdsDirty = true;
+
+    std::map<std::string, std::chrono::microseconds> m_maxClearDuration;
 };
 
 #endif // WATERMARKORCH_H
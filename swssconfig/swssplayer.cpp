@@ -1,7 +1,15 @@
+#include <getopt.h>
+#include <time.h>
+
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <thread>
 
 #include <dbconnector.h>
+#include <redispipeline.h>
 #include <producerstatetable.h>
 #include <schema.h>
 #include <tokenize.h>
@@ -9,12 +17,18 @@
 using namespace std;
 using namespace swss;
 
+#define DEFAULT_BATCH_SIZE	128
+
 static int line_index = 0;
 static DBConnector db("APPL_DB", 0, true);
 
 void usage()
 {
-	cout << "Usage: swssplayer <file>" << endl;
+	cout << "Usage: swssplayer [-b batch_size] [-s speed] <file>" << endl;
+	cout << "    -b batch_size: operations written to APPL_DB per round trip (default " << DEFAULT_BATCH_SIZE << ")" << endl;
+	cout << "    -s speed: replay with the recorded timing, sped up by <speed> (1: as recorded)." << endl;
+	cout << "              Without it, the operations are replayed as fast as possible." << endl;
+	cout << "<file> is a swss.rec recording, the throughput achieved is printed at the end." << endl;
 	/* TODO: Add sample input file */
 }
 
@@ -34,46 +48,171 @@ vector<FieldValueTuple> processFieldsValuesTuple(string s)
 	return result;
 }
 
-void processTokens(vector<string> tokens)
+/* Parse a swss::getTimestamp() time, such as 2021-06-02.11:42:17.123456 */
+bool parseTimestamp(const string &s, chrono::microseconds &timestamp)
 {
-	auto key = tokens[1];
+	struct tm tm = {};
+	const char *end = strptime(s.c_str(), "%Y-%m-%d.%H:%M:%S", &tm);
+	if (!end)
+	{
+		return false;
+	}
 
-	/* Process the key */
-	auto v_key = tokenize(key, ':', 1);
-	auto table_name = v_key[0];
-	auto key_name = v_key[1];
+	long usec = 0;
+	if (*end == '.')
+	{
+		usec = strtol(end + 1, NULL, 10);
+	}
 
-	ProducerStateTable producer(&db, table_name);
+	timestamp = chrono::seconds(timegm(&tm)) + chrono::microseconds(usec);
+	return true;
+}
 
-	/* Process the operation */
-	auto op = tokens[2];
-	if (op == SET_COMMAND)
+class Player
+{
+public:
+	Player(size_t batchSize) :
+		m_pipeline(&db, batchSize)
 	{
-		auto tuples = processFieldsValuesTuple(tokens[3]);
-		producer.set(key_name, tuples, SET_COMMAND);
 	}
-	else if (op == DEL_COMMAND)
+
+	/* Returns false if the line is not a table operation, like "recording started" */
+	bool processTokens(const vector<string> &tokens)
 	{
-		producer.del(key_name, DEL_COMMAND);
+		if (tokens.size() < 3)
+		{
+			return false;
+		}
+
+		/* Process the key */
+		auto v_key = tokenize(tokens[1], ':', 1);
+		if (v_key.size() != 2)
+		{
+			return false;
+		}
+		auto &table_name = v_key[0];
+		auto &key_name = v_key[1];
+
+		/* Process the operation */
+		auto &op = tokens[2];
+		if (op == SET_COMMAND)
+		{
+			auto tuples = tokens.size() > 3 ? processFieldsValuesTuple(tokens[3]) : vector<FieldValueTuple>();
+			getProducer(table_name).set(key_name, tuples, SET_COMMAND);
+		}
+		else if (op == DEL_COMMAND)
+		{
+			getProducer(table_name).del(key_name, DEL_COMMAND);
+		}
+		else
+		{
+			return false;
+		}
+		return true;
 	}
-}
+
+	void flush()
+	{
+		m_pipeline.flush();
+	}
+
+private:
+	RedisPipeline m_pipeline;
+	/* One producer per table, all writing through m_pipeline */
+	map<string, unique_ptr<ProducerStateTable>> m_producers;
+
+	ProducerStateTable &getProducer(const string &table_name)
+	{
+		auto &producer = m_producers[table_name];
+		if (!producer)
+		{
+			producer.reset(new ProducerStateTable(&m_pipeline, table_name, true));
+		}
+		return *producer;
+	}
+};
 
 int main(int argc, char **argv)
 {
-	if (argc != 2)
+	size_t batch_size = DEFAULT_BATCH_SIZE;
+	double speed = 0;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "b:s:h")) != -1)
+	{
+		switch (opt)
+		{
+		case 'b':
+			batch_size = strtoul(optarg, NULL, 10);
+			break;
+		case 's':
+			speed = atof(optarg);
+			break;
+		case 'h':
+			usage();
+			exit(EXIT_SUCCESS);
+		default:
+			usage();
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if (optind != argc - 1 || batch_size == 0 || speed < 0)
 	{
 		usage();
 		exit(EXIT_FAILURE);
 	}
 
-	ifstream file(argv[1]);
+	ifstream file(argv[optind]);
+	if (!file.is_open())
+	{
+		cerr << "Failed to open " << argv[optind] << endl;
+		exit(EXIT_FAILURE);
+	}
+
+	Player player(batch_size);
 	string line;
+	size_t operations = 0;
+	bool timed = false;
+	chrono::microseconds first_timestamp;
+	auto start = chrono::steady_clock::now();
 
 	while (getline(file, line))
 	{
+		line_index++;
+
 		auto tokens = tokenize(line, '|', 3);
-		processTokens(tokens);
 
-		line_index++;
+		chrono::microseconds timestamp;
+		if (speed > 0 && !tokens.empty() && parseTimestamp(tokens[0], timestamp))
+		{
+			if (!timed)
+			{
+				timed = true;
+				first_timestamp = timestamp;
+			}
+
+			/* Write what is due before waiting for the next operation */
+			auto due = start + chrono::duration_cast<chrono::steady_clock::duration>(
+					(timestamp - first_timestamp) / speed);
+			if (due > chrono::steady_clock::now())
+			{
+				player.flush();
+				this_thread::sleep_until(due);
+			}
+		}
+
+		if (player.processTokens(tokens))
+		{
+			operations++;
+		}
 	}
+	player.flush();
+
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+	cout << "Replayed " << operations << " operations from " << line_index << " lines in "
+	     << elapsed.count() << " s (" << (elapsed.count() > 0 ? operations / elapsed.count() : 0)
+	     << " ops/s)" << endl;
+
+	return 0;
 }
@@ -142,4 +142,106 @@ namespace bulker_test
         // Confirm route entry is not pending removal
         ASSERT_FALSE(gRouteBulker.bulk_entry_pending_removal(route_entry_non_remove));
     }
+
+    TEST_F(BulkerTest, NeighborBulkerCreateRemove)
+    {
+        // Create bulker
+        sai_neighbor_api_t neighbor_api = {};
+        EntityBulker<sai_neighbor_api_t> gNeighBulker(&neighbor_api, 1000);
+        deque<sai_status_t> object_statuses;
+
+        // Create two dummy neighbor entries on the same router interface
+        sai_neighbor_entry_t neighbor_entry_v4;
+        neighbor_entry_v4.switch_id = 0x0;
+        neighbor_entry_v4.rif_id = 0x1;
+        neighbor_entry_v4.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+        neighbor_entry_v4.ip_address.addr.ip4 = htonl(0x0a000001);
+
+        sai_neighbor_entry_t neighbor_entry_v6;
+        neighbor_entry_v6.switch_id = 0x0;
+        neighbor_entry_v6.rif_id = 0x1;
+        neighbor_entry_v6.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV6;
+        memset(neighbor_entry_v6.ip_address.addr.ip6, 0, sizeof(neighbor_entry_v6.ip_address.addr.ip6));
+        neighbor_entry_v6.ip_address.addr.ip6[15] = 0x1;
+
+        sai_attribute_t neighbor_attr;
+        neighbor_attr.id = SAI_NEIGHBOR_ENTRY_ATTR_DST_MAC_ADDRESS;
+        memset(neighbor_attr.value.mac, 0, sizeof(neighbor_attr.value.mac));
+
+        object_statuses.emplace_back();
+        gNeighBulker.create_entry(&object_statuses.back(), &neighbor_entry_v4, 1, &neighbor_attr);
+        object_statuses.emplace_back();
+        gNeighBulker.create_entry(&object_statuses.back(), &neighbor_entry_v6, 1, &neighbor_attr);
+
+        // Check both neighbors are pending creation
+        ASSERT_EQ(gNeighBulker.creating_entries_count(), 2);
+        ASSERT_EQ(gNeighBulker.creating_entries_count(neighbor_entry_v4), 1);
+        ASSERT_EQ(gNeighBulker.creating_entries_count(neighbor_entry_v6), 1);
+
+        // Creating the same neighbor twice is rejected
+        sai_status_t status;
+        ASSERT_EQ(gNeighBulker.create_entry(&status, &neighbor_entry_v4, 1, &neighbor_attr), SAI_STATUS_ITEM_ALREADY_EXISTS);
+
+        // Removing a neighbor pending creation cancels both operations
+        object_statuses.emplace_back();
+        ASSERT_EQ(gNeighBulker.remove_entry(&object_statuses.back(), &neighbor_entry_v4), SAI_STATUS_SUCCESS);
+        ASSERT_EQ(object_statuses.front(), SAI_STATUS_SUCCESS);
+        ASSERT_EQ(gNeighBulker.creating_entries_count(), 1);
+        ASSERT_FALSE(gNeighBulker.bulk_entry_pending_removal(neighbor_entry_v4));
+
+        // Clear the bulk
+        gNeighBulker.clear();
+        ASSERT_EQ(gNeighBulker.creating_entries_count(), 0);
+    }
+
+    sai_status_t _ut_stub_create_next_hops(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        // Fail the second next hop of the bulk, the others are created
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = (i == 1) ? SAI_STATUS_INSUFFICIENT_RESOURCES : SAI_STATUS_SUCCESS;
+            object_id[i] = (i == 1) ? SAI_NULL_OBJECT_ID : 0x40000000000001 + i;
+        }
+        return SAI_STATUS_FAILURE;
+    }
+
+    TEST_F(BulkerTest, NextHopBulkerCreateStatus)
+    {
+        // Create bulker
+        sai_next_hop_api_t next_hop_api = {};
+        next_hop_api.create_next_hops = _ut_stub_create_next_hops;
+        ObjectBulker<sai_next_hop_api_t> gNextHopBulker(&next_hop_api, 0x0, 1000);
+
+        sai_attribute_t next_hop_attr;
+        next_hop_attr.id = SAI_NEXT_HOP_ATTR_TYPE;
+        next_hop_attr.value.s32 = SAI_NEXT_HOP_TYPE_IP;
+
+        // Queue three next hops, the last one without a status
+        sai_status_t next_hop_status[2];
+        sai_object_id_t next_hop_id[3];
+        ASSERT_EQ(gNextHopBulker.create_entry(&next_hop_status[0], &next_hop_id[0], 1, &next_hop_attr), SAI_STATUS_NOT_EXECUTED);
+        ASSERT_EQ(gNextHopBulker.create_entry(&next_hop_status[1], &next_hop_id[1], 1, &next_hop_attr), SAI_STATUS_NOT_EXECUTED);
+        ASSERT_EQ(gNextHopBulker.create_entry(&next_hop_id[2], 1, &next_hop_attr), SAI_STATUS_NOT_EXECUTED);
+        ASSERT_EQ(next_hop_status[0], SAI_STATUS_NOT_EXECUTED);
+        ASSERT_EQ(next_hop_status[1], SAI_STATUS_NOT_EXECUTED);
+        ASSERT_EQ(gNextHopBulker.creating_entries_count(), 3);
+
+        gNextHopBulker.flush();
+
+        // Each next hop gets its own creating status and object id
+        ASSERT_EQ(next_hop_status[0], SAI_STATUS_SUCCESS);
+        ASSERT_EQ(next_hop_id[0], 0x40000000000001);
+        ASSERT_EQ(next_hop_status[1], SAI_STATUS_INSUFFICIENT_RESOURCES);
+        ASSERT_EQ(next_hop_id[1], SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(next_hop_id[2], 0x40000000000003);
+        ASSERT_EQ(gNextHopBulker.creating_entries_count(), 0);
+        ASSERT_TRUE(gNextHopBulker.creating_statuses.empty());
+    }
 }
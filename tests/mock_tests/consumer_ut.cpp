@@ -2,6 +2,8 @@
 #include "mock_orchagent_main.h"
 #include "mock_table.h"
 
+#include <chrono>
+#include <map>
 #include <sstream>
 
 extern PortsOrch *gPortsOrch;
@@ -322,4 +324,266 @@ namespace consumer_test
         validate_syncmap(consumer->m_toSync, 1, key, exp_kofv);
 
     }
+
+    TEST_F(ConsumerTest, ConsumerAddToSync_FifoAcrossKeys)
+    {
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "b", SET_COMMAND, { { f1, v1a } } }));
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "a", SET_COMMAND, { { f1, v1a } } }));
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "c", DEL_COMMAND, { { } } }));
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "c", SET_COMMAND, { { f2, v2a } } }));
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "a", SET_COMMAND, { { f2, v2a } } }));
+
+        // keys are served in arrival order, DEL then SET of a key stay together
+        auto &sync = consumer->m_toSync;
+        ASSERT_EQ(sync.size(), 4);
+        vector<pair<string, string>> order;
+        for (const auto &it : sync)
+        {
+            order.emplace_back(it.first, kfvOp(it.second));
+        }
+        vector<pair<string, string>> exp_order = {
+            { "b", SET_COMMAND }, { "a", SET_COMMAND }, { "c", DEL_COMMAND }, { "c", SET_COMMAND } };
+        ASSERT_EQ(order, exp_order);
+        ASSERT_EQ(sync.count("c"), 2);
+
+        // erasing the DEL keeps the SET of the same key reachable
+        sync.erase(sync.find("c"));
+        ASSERT_EQ(sync.count("c"), 1);
+        ASSERT_EQ(kfvOp(sync.find("c")->second), SET_COMMAND);
+
+        // a new SET is queued after the pending one and merged
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "c", DEL_COMMAND, { { } } }));
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "c", SET_COMMAND, { { f3, v3a } } }));
+        ASSERT_EQ(sync.count("c"), 2);
+        ASSERT_EQ(kfvOp(next(sync.find("c"))->second), SET_COMMAND);
+        ASSERT_EQ(sync.rbegin()->second, KeyOpFieldsValuesTuple({ "c", SET_COMMAND, { { f3, v3a } } }));
+    }
+
+    /* Reference implementation of addToSync on top of std::multimap */
+    static void legacyAddToSync(multimap<string, KeyOpFieldsValuesTuple> &sync, const KeyOpFieldsValuesTuple &entry)
+    {
+        string key = kfvKey(entry);
+        string op = kfvOp(entry);
+
+        if (sync.find(key) == sync.end())
+        {
+            sync.emplace(key, entry);
+        }
+        else if (op == DEL_COMMAND)
+        {
+            sync.erase(key);
+            sync.emplace(key, entry);
+        }
+        else
+        {
+            auto ret = sync.equal_range(key);
+            auto iter = ret.first;
+            for (; iter != ret.second; ++iter)
+            {
+                if (kfvOp(iter->second) == SET_COMMAND)
+                    break;
+            }
+            if (iter == ret.second)
+            {
+                sync.emplace(key, entry);
+                return;
+            }
+
+            KeyOpFieldsValuesTuple existing_data = iter->second;
+            auto new_values = kfvFieldsValues(entry);
+            auto existing_values = kfvFieldsValues(existing_data);
+            for (auto it : new_values)
+            {
+                string field = fvField(it);
+                string value = fvValue(it);
+                auto iu = existing_values.begin();
+                while (iu != existing_values.end())
+                {
+                    string ofield = fvField(*iu);
+                    if (field == ofield)
+                        iu = existing_values.erase(iu);
+                    else
+                        iu++;
+                }
+                existing_values.push_back(FieldValueTuple(field, value));
+            }
+            iter->second = KeyOpFieldsValuesTuple(key, op, existing_values);
+        }
+    }
+
+    TEST_F(ConsumerTest, ConsumerAddToSync_RouteBurst)
+    {
+        // Route burst: every prefix is updated a few times before it is drained
+        const int prefixes = 20000;
+        const int updates = 4;
+        deque<KeyOpFieldsValuesTuple> burst;
+        for (int u = 0; u < updates; u++)
+        {
+            for (int p = 0; p < prefixes; p++)
+            {
+                string key = "10." + to_string(p / 256) + "." + to_string(p % 256) + ".0/24";
+                if (u == 1 && p % 8 == 0)
+                {
+                    burst.emplace_back(key, DEL_COMMAND, vector<FieldValueTuple>{});
+                    continue;
+                }
+                burst.emplace_back(key, SET_COMMAND, vector<FieldValueTuple>{
+                        { "nexthop", "10.0.0." + to_string(u) + ",10.0.1." + to_string(u) },
+                        { "ifname", "Ethernet0,Ethernet4" },
+                        { "weight", to_string(u) } });
+            }
+        }
+
+        multimap<string, KeyOpFieldsValuesTuple> legacy;
+        for (const auto &entry : burst)
+        {
+            legacyAddToSync(legacy, entry);
+        }
+
+        consumer->addToSync(burst);
+
+        // Same tasks per key, only the order across keys differs
+        ASSERT_EQ(consumer->m_toSync.size(), legacy.size());
+        for (const auto &it : legacy)
+        {
+            auto ret = consumer->m_toSync.equal_range(it.first);
+            ASSERT_EQ(consumer->m_toSync.count(it.first), legacy.count(it.first));
+            auto lret = legacy.equal_range(it.first);
+            ASSERT_TRUE(equal(lret.first, lret.second, ret.first,
+                        [](const pair<const string, KeyOpFieldsValuesTuple> &l,
+                           const pair<const string, KeyOpFieldsValuesTuple> &r) { return l.second == r.second; }));
+        }
+    }
+
+    class RetryTestOrch : public Orch
+    {
+    public:
+        RetryTestOrch(swss::DBConnector *db, const string &tableName)
+            : Orch(db, tableName)
+        {
+        }
+
+        RetryTestOrch(swss::DBConnector *db, const vector<string> &tableNames)
+            : Orch(db, tableNames)
+        {
+        }
+
+        Consumer *getConsumer(const string &name)
+        {
+            return dynamic_cast<Consumer *>(getExecutor(name));
+        }
+
+        void doTask(Consumer &consumer) override
+        {
+            auto it = consumer.m_toSync.begin();
+            while (it != consumer.m_toSync.end())
+            {
+                if (!m_resolved && kfvKey(it->second) == "retry")
+                {
+                    it++;
+                    continue;
+                }
+                it = consumer.m_toSync.erase(it);
+            }
+        }
+
+        bool m_resolved = false;
+    };
+
+    TEST_F(ConsumerTest, ConsumerDrain_RetrySchedule)
+    {
+        RetryTestOrch orch(m_config_db.get(), "CFG_RETRY_TABLE");
+        auto retryConsumer = orch.getConsumer("CFG_RETRY_TABLE");
+        ASSERT_NE(retryConsumer, nullptr);
+
+        retryConsumer->addToSync(KeyOpFieldsValuesTuple({ "retry", SET_COMMAND, { { f1, v1a } } }));
+        retryConsumer->addToSync(KeyOpFieldsValuesTuple({ "done", SET_COMMAND, { { f1, v1a } } }));
+        ASSERT_FALSE(orch.hasPendingTasks());
+
+        // "done" is processed, "retry" is left and registered for retry without backoff
+        retryConsumer->drain();
+        ASSERT_EQ(retryConsumer->getPendingCount(), 1);
+        ASSERT_EQ(retryConsumer->getRetryCount(), 0);
+        ASSERT_TRUE(orch.hasPendingTasks());
+        ASSERT_TRUE(orch.isRetryDue(std::chrono::steady_clock::now()));
+
+        // No progress, consumer backs off
+        retryConsumer->drain();
+        retryConsumer->drain();
+        ASSERT_EQ(retryConsumer->getPendingCount(), 1);
+        ASSERT_EQ(retryConsumer->getRetryCount(), 2);
+        ASSERT_FALSE(orch.isRetryDue(retryConsumer->getNextRetryTime() - std::chrono::milliseconds(1)));
+        ASSERT_TRUE(orch.isRetryDue(retryConsumer->getNextRetryTime()));
+
+        vector<string> stats;
+        orch.dumpRetryStats(stats);
+        ASSERT_EQ(stats.size(), 1);
+        ASSERT_EQ(stats[0], "CFG_RETRY_TABLE pending:1 retries:2");
+
+        // Resolved, consumer unregisters itself
+        orch.m_resolved = true;
+        retryConsumer->drain();
+        ASSERT_EQ(retryConsumer->getPendingCount(), 0);
+        ASSERT_EQ(retryConsumer->getRetryCount(), 0);
+        ASSERT_FALSE(orch.hasPendingTasks());
+    }
+
+    TEST_F(ConsumerTest, ConsumerDrain_EmptiedOutsideDrain)
+    {
+        RetryTestOrch orch(m_config_db.get(), "CFG_RETRY_TABLE");
+        auto retryConsumer = orch.getConsumer("CFG_RETRY_TABLE");
+
+        retryConsumer->addToSync(KeyOpFieldsValuesTuple({ "retry", SET_COMMAND, { { f1, v1a } } }));
+        retryConsumer->drain();
+        ASSERT_TRUE(orch.hasPendingTasks());
+
+        // The task is handled by a direct doTask() call, not through drain()
+        orch.m_resolved = true;
+        orch.doTask(*retryConsumer);
+        ASSERT_EQ(retryConsumer->getPendingCount(), 0);
+        ASSERT_TRUE(orch.hasPendingTasks());
+
+        // The next drain unregisters the consumer, nothing is left to retry
+        retryConsumer->drain();
+        ASSERT_FALSE(orch.hasPendingTasks());
+        ASSERT_EQ(retryConsumer->getRetryCount(), 0);
+    }
+
+    TEST_F(ConsumerTest, ConsumerDrain_RetryPassPerConsumer)
+    {
+        RetryTestOrch orch(m_config_db.get(), vector<string>{ "CFG_RETRY_A_TABLE", "CFG_RETRY_B_TABLE" });
+        auto dueConsumer = orch.getConsumer("CFG_RETRY_A_TABLE");
+        auto backedOffConsumer = orch.getConsumer("CFG_RETRY_B_TABLE");
+
+        // A makes progress and is due right away
+        dueConsumer->addToSync(KeyOpFieldsValuesTuple({ "retry", SET_COMMAND, { { f1, v1a } } }));
+        dueConsumer->addToSync(KeyOpFieldsValuesTuple({ "done", SET_COMMAND, { { f1, v1a } } }));
+        dueConsumer->drain();
+        ASSERT_EQ(dueConsumer->getRetryCount(), 0);
+
+        // B makes no progress and backs off
+        backedOffConsumer->addToSync(KeyOpFieldsValuesTuple({ "retry", SET_COMMAND, { { f1, v1a } } }));
+        backedOffConsumer->drain();
+        backedOffConsumer->drain();
+        backedOffConsumer->drain();
+        ASSERT_EQ(backedOffConsumer->getRetryCount(), 3);
+        ASSERT_GT(backedOffConsumer->getNextRetryTime(), dueConsumer->getNextRetryTime());
+
+        // Only A is run by a retry pass at its retry time
+        orch.m_resolved = true;
+        orch.doRetryTask(dueConsumer->getNextRetryTime());
+        ASSERT_EQ(dueConsumer->getPendingCount(), 0);
+        ASSERT_EQ(backedOffConsumer->getPendingCount(), 1);
+        ASSERT_EQ(backedOffConsumer->getRetryCount(), 3);
+        ASSERT_TRUE(orch.hasPendingTasks());
+
+        orch.doRetryTask(backedOffConsumer->getNextRetryTime());
+        ASSERT_EQ(backedOffConsumer->getPendingCount(), 0);
+        ASSERT_FALSE(orch.hasPendingTasks());
+
+        // Outside of a retry pass every consumer is drained
+        backedOffConsumer->addToSync(KeyOpFieldsValuesTuple({ "done", SET_COMMAND, { { f1, v1a } } }));
+        orch.doTask();
+        ASSERT_EQ(backedOffConsumer->getPendingCount(), 0);
+    }
 }
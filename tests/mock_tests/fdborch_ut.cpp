@@ -0,0 +1,371 @@
+#define private public // make Directory::m_values available to clean it.
+#include "directory.h"
+#undef private
+#define protected public
+#include "orch.h"
+#undef protected
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+
+extern string gMySwitchType;
+
+
+namespace fdborch_test
+{
+    using namespace std;
+
+    shared_ptr<swss::DBConnector> m_app_db;
+    shared_ptr<swss::DBConnector> m_config_db;
+    shared_ptr<swss::DBConnector> m_state_db;
+    shared_ptr<swss::DBConnector> m_chassis_app_db;
+
+    int create_fdb_count;
+    int remove_fdb_count;
+    MacAddress fail_fdb_mac;
+
+    sai_fdb_api_t ut_sai_fdb_api;
+    sai_fdb_api_t *pold_sai_fdb_api;
+
+    sai_status_t _ut_stub_sai_bulk_create_fdb_entry(
+        _In_ uint32_t object_count,
+        _In_ const sai_fdb_entry_t *fdb_entry,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        create_fdb_count++;
+
+        // Fail the chosen MAC, create the other entries one by one
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            if (MacAddress(fdb_entry[i].mac_address) == fail_fdb_mac)
+            {
+                object_statuses[i] = SAI_STATUS_INSUFFICIENT_RESOURCES;
+            }
+            else
+            {
+                object_statuses[i] = pold_sai_fdb_api->create_fdb_entry(&fdb_entry[i], attr_count[i], attr_list[i]);
+            }
+
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t _ut_stub_sai_bulk_remove_fdb_entry(
+        _In_ uint32_t object_count,
+        _In_ const sai_fdb_entry_t *fdb_entry,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        remove_fdb_count++;
+
+        // Fail the chosen MAC, remove the other entries one by one
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            if (MacAddress(fdb_entry[i].mac_address) == fail_fdb_mac)
+            {
+                object_statuses[i] = SAI_STATUS_OBJECT_IN_USE;
+            }
+            else
+            {
+                object_statuses[i] = pold_sai_fdb_api->remove_fdb_entry(&fdb_entry[i]);
+            }
+
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    // The default handling exits orchagent on a failed create or remove, retry instead
+    struct RetryFdbOrch : public FdbOrch
+    {
+        using FdbOrch::FdbOrch;
+
+        task_process_status handleSaiCreateStatus(sai_api_t api, sai_status_t status, void *context = nullptr) override
+        {
+            return task_need_retry;
+        }
+
+        task_process_status handleSaiRemoveStatus(sai_api_t api, sai_status_t status, void *context = nullptr) override
+        {
+            return task_need_retry;
+        }
+    };
+
+    struct FdbOrchTest : public ::testing::Test
+    {
+        FdbOrchTest()
+        {
+        }
+
+        void SetUp() override
+        {
+            map<string, string> profile = {
+                { "SAI_VS_SWITCH_TYPE", "SAI_VS_SWITCH_TYPE_BCM56850" },
+                { "KV_DEVICE_MAC_ADDRESS", "20:03:04:05:06:00" }
+            };
+
+            ut_helper::initSaiApi(profile);
+
+            // Hack the FDB bulk functions, the FDB bulker takes them when constructed
+            pold_sai_fdb_api = sai_fdb_api;
+            ut_sai_fdb_api = *sai_fdb_api;
+            sai_fdb_api = &ut_sai_fdb_api;
+            sai_fdb_api->create_fdb_entries = _ut_stub_sai_bulk_create_fdb_entry;
+            sai_fdb_api->remove_fdb_entries = _ut_stub_sai_bulk_remove_fdb_entry;
+
+            create_fdb_count = 0;
+            remove_fdb_count = 0;
+            fail_fdb_mac = MacAddress();
+
+            // Init switch and create dependencies
+            m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+            if(gMySwitchType == "voq")
+                m_chassis_app_db = make_shared<swss::DBConnector>("CHASSIS_APP_DB", 0);
+
+            sai_attribute_t attr;
+
+            attr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+            attr.value.booldata = true;
+
+            auto status = sai_switch_api->create_switch(&gSwitchId, 1, &attr);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            // Get switch source MAC address
+            attr.id = SAI_SWITCH_ATTR_SRC_MAC_ADDRESS;
+            status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            gMacAddress = attr.value.mac;
+
+            // Get the default virtual router ID
+            attr.id = SAI_SWITCH_ATTR_DEFAULT_VIRTUAL_ROUTER_ID;
+            status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            gVirtualRouterId = attr.value.oid;
+
+            ASSERT_EQ(gCrmOrch, nullptr);
+            gCrmOrch = new CrmOrch(m_config_db.get(), CFG_CRM_TABLE_NAME);
+
+            TableConnector stateDbSwitchTable(m_state_db.get(), "SWITCH_CAPABILITY");
+            TableConnector conf_asic_sensors(m_config_db.get(), CFG_ASIC_SENSORS_TABLE_NAME);
+            TableConnector app_switch_table(m_app_db.get(),  APP_SWITCH_TABLE_NAME);
+
+            vector<TableConnector> switch_tables = {
+                conf_asic_sensors,
+                app_switch_table
+            };
+
+            ASSERT_EQ(gSwitchOrch, nullptr);
+            gSwitchOrch = new SwitchOrch(m_app_db.get(), switch_tables, stateDbSwitchTable);
+
+            // Create dependencies ...
+
+            const int portsorch_base_pri = 40;
+
+            vector<table_name_with_pri_t> ports_tables = {
+                { APP_PORT_TABLE_NAME, portsorch_base_pri + 5 },
+                { APP_VLAN_TABLE_NAME, portsorch_base_pri + 2 },
+                { APP_VLAN_MEMBER_TABLE_NAME, portsorch_base_pri },
+                { APP_LAG_TABLE_NAME, portsorch_base_pri + 4 },
+                { APP_LAG_MEMBER_TABLE_NAME, portsorch_base_pri }
+            };
+
+            vector<string> flex_counter_tables = {
+                CFG_FLEX_COUNTER_TABLE_NAME
+            };
+            auto* flexCounterOrch = new FlexCounterOrch(m_config_db.get(), flex_counter_tables);
+            gDirectory.set(flexCounterOrch);
+
+            ASSERT_EQ(gPortsOrch, nullptr);
+            gPortsOrch = new PortsOrch(m_app_db.get(), m_state_db.get(), ports_tables, m_chassis_app_db.get());
+
+            vector<string> buffer_tables = { APP_BUFFER_POOL_TABLE_NAME,
+                                             APP_BUFFER_PROFILE_TABLE_NAME,
+                                             APP_BUFFER_QUEUE_TABLE_NAME,
+                                             APP_BUFFER_PG_TABLE_NAME,
+                                             APP_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME,
+                                             APP_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME };
+
+            gBufferOrch = new BufferOrch(m_app_db.get(), m_config_db.get(), m_state_db.get(), buffer_tables);
+
+            // FDB entries look up the VXLAN tunnel orch
+            auto* vxlanTunnelOrch = new VxlanTunnelOrch(m_state_db.get(), m_app_db.get(), APP_VXLAN_TUNNEL_TABLE_NAME);
+            gDirectory.set(vxlanTunnelOrch);
+
+            const int fdborch_pri = 20;
+
+            vector<table_name_with_pri_t> app_fdb_tables = {
+                { APP_FDB_TABLE_NAME,        FdbOrch::fdborch_pri},
+                { APP_VXLAN_FDB_TABLE_NAME,  FdbOrch::fdborch_pri},
+                { APP_MCLAG_FDB_TABLE_NAME,  fdborch_pri}
+            };
+
+            TableConnector stateDbFdb(m_state_db.get(), STATE_FDB_TABLE_NAME);
+            TableConnector stateMclagDbFdb(m_state_db.get(), STATE_MCLAG_REMOTE_FDB_TABLE_NAME);
+            ASSERT_EQ(gFdbOrch, nullptr);
+            gFdbOrch = new RetryFdbOrch(m_app_db.get(), app_fdb_tables, stateDbFdb, stateMclagDbFdb, gPortsOrch);
+
+            Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+            Table vlanTable = Table(m_app_db.get(), APP_VLAN_TABLE_NAME);
+            Table vlanMemberTable = Table(m_app_db.get(), APP_VLAN_MEMBER_TABLE_NAME);
+
+            // Get SAI default ports to populate DB
+            auto ports = ut_helper::getInitialSaiPorts();
+
+            // Populate pot table with SAI ports
+            for (const auto &it : ports)
+            {
+                portTable.set(it.first, it.second);
+            }
+
+            // Set PortConfigDone
+            portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+            gPortsOrch->addExistingData(&portTable);
+            static_cast<Orch *>(gPortsOrch)->doTask();
+
+            portTable.set("PortInitDone", { { "lanes", "0" } });
+            gPortsOrch->addExistingData(&portTable);
+            static_cast<Orch *>(gPortsOrch)->doTask();
+
+            // Put Ethernet0 in Vlan2
+            vlanTable.set("Vlan2",
+                {
+                    {"admin_status", "up"},
+                    {"mtu", "9100"}
+                }
+            );
+            vlanMemberTable.set(
+                std::string("Vlan2") + vlanMemberTable.getTableNameSeparator() + std::string("Ethernet0"),
+                { {"tagging_mode", "untagged"} }
+            );
+            gPortsOrch->addExistingData(&vlanTable);
+            gPortsOrch->addExistingData(&vlanMemberTable);
+            static_cast<Orch *>(gPortsOrch)->doTask();
+        }
+
+        void TearDown() override
+        {
+            gDirectory.m_values.clear();
+
+            delete gFdbOrch;
+            gFdbOrch = nullptr;
+
+            delete gCrmOrch;
+            gCrmOrch = nullptr;
+
+            delete gSwitchOrch;
+            gSwitchOrch = nullptr;
+
+            delete gBufferOrch;
+            gBufferOrch = nullptr;
+
+            delete gPortsOrch;
+            gPortsOrch = nullptr;
+
+            sai_fdb_api = pold_sai_fdb_api;
+            ut_helper::uninitSaiApi();
+        }
+
+        void doFdbTask(const std::string &op, const std::vector<std::string> &macs)
+        {
+            std::deque<KeyOpFieldsValuesTuple> entries;
+            for (const auto &mac : macs)
+            {
+                if (op == SET_COMMAND)
+                {
+                    entries.push_back({"Vlan2:" + mac, op, { {"port", "Ethernet0"},
+                                                             {"type", "static"}}});
+                }
+                else
+                {
+                    entries.push_back({"Vlan2:" + mac, op, { {} }});
+                }
+            }
+
+            auto consumer = dynamic_cast<Consumer *>(gFdbOrch->getExecutor(APP_FDB_TABLE_NAME));
+            consumer->addToSync(entries);
+            static_cast<Orch *>(gFdbOrch)->doTask();
+        }
+
+        size_t pendingFdbTasks()
+        {
+            auto consumer = dynamic_cast<Consumer *>(gFdbOrch->getExecutor(APP_FDB_TABLE_NAME));
+            return consumer->m_toSync.size();
+        }
+    };
+
+    TEST_F(FdbOrchTest, FdbBulkCreateRemove)
+    {
+        vector<string> macs = { "00:00:00:00:00:01", "00:00:00:00:00:02", "00:00:00:00:00:03" };
+        size_t copyCount = gPortsOrch->getPortCopyCount();
+
+        // All FDB entries are created with a single bulk
+        doFdbTask(SET_COMMAND, macs);
+        ASSERT_EQ(create_fdb_count, 1);
+        ASSERT_EQ(gFdbOrch->m_entries.size(), 3);
+        ASSERT_EQ(pendingFdbTasks(), 0);
+        ASSERT_EQ(gPortsOrch->findPort("Ethernet0")->m_fdb_count, 3);
+        ASSERT_EQ(gPortsOrch->findPort("Vlan2")->m_fdb_count, 3);
+
+        // All FDB entries are removed with a single bulk
+        doFdbTask(DEL_COMMAND, macs);
+        ASSERT_EQ(remove_fdb_count, 1);
+        ASSERT_EQ(gFdbOrch->m_entries.size(), 0);
+        ASSERT_EQ(pendingFdbTasks(), 0);
+        ASSERT_EQ(gPortsOrch->findPort("Ethernet0")->m_fdb_count, 0);
+        ASSERT_EQ(gPortsOrch->findPort("Vlan2")->m_fdb_count, 0);
+
+        // The vlan and port are looked up in place
+        ASSERT_EQ(gPortsOrch->getPortCopyCount(), copyCount);
+    }
+
+    TEST_F(FdbOrchTest, FdbBulkFailedEntry)
+    {
+        vector<string> macs = { "00:00:00:00:00:01", "00:00:00:00:00:02", "00:00:00:00:00:03" };
+
+        // The failed entry is kept for retry, the rest of the bulk is created
+        fail_fdb_mac = MacAddress("00:00:00:00:00:02");
+        doFdbTask(SET_COMMAND, macs);
+        ASSERT_EQ(gFdbOrch->m_entries.size(), 2);
+        ASSERT_EQ(pendingFdbTasks(), 1);
+        ASSERT_EQ(gPortsOrch->findPort("Ethernet0")->m_fdb_count, 2);
+
+        fail_fdb_mac = MacAddress();
+        static_cast<Orch *>(gFdbOrch)->doTask();
+        ASSERT_EQ(gFdbOrch->m_entries.size(), 3);
+        ASSERT_EQ(pendingFdbTasks(), 0);
+        ASSERT_EQ(gPortsOrch->findPort("Ethernet0")->m_fdb_count, 3);
+
+        // The failed entry is kept for retry, the rest of the bulk is removed
+        fail_fdb_mac = MacAddress("00:00:00:00:00:02");
+        doFdbTask(DEL_COMMAND, macs);
+        ASSERT_EQ(gFdbOrch->m_entries.size(), 1);
+        ASSERT_EQ(pendingFdbTasks(), 1);
+        ASSERT_EQ(gPortsOrch->findPort("Ethernet0")->m_fdb_count, 1);
+        ASSERT_EQ(gPortsOrch->findPort("Vlan2")->m_fdb_count, 1);
+
+        fail_fdb_mac = MacAddress();
+        static_cast<Orch *>(gFdbOrch)->doTask();
+        ASSERT_EQ(gFdbOrch->m_entries.size(), 0);
+        ASSERT_EQ(pendingFdbTasks(), 0);
+        ASSERT_EQ(gPortsOrch->findPort("Ethernet0")->m_fdb_count, 0);
+        ASSERT_EQ(gPortsOrch->findPort("Vlan2")->m_fdb_count, 0);
+    }
+}
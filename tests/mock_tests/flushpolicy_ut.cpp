@@ -0,0 +1,78 @@
+#include "ut_helper.h"
+#include "flushpolicy.h"
+
+namespace flushpolicy_test
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    TEST(FlushPolicyTest, FlushesOnBatchSize)
+    {
+        FlushPolicy policy(100, 50);
+        auto t0 = steady_clock::now();
+
+        ASSERT_FALSE(policy.hasPending());
+        ASSERT_FALSE(policy.isFlushDue(t0));
+        ASSERT_EQ(policy.getTimeout(t0), -1);
+
+        policy.addPending(60, t0);
+        ASSERT_FALSE(policy.isFlushDue(t0));
+        policy.addPending(40, t0 + milliseconds(1));
+        ASSERT_TRUE(policy.isFlushDue(t0 + milliseconds(1)));
+
+        policy.onFlush(t0 + milliseconds(2));
+        ASSERT_FALSE(policy.hasPending());
+        ASSERT_EQ(policy.getBatchSizeHistogram().getCount(), 1);
+        // 100 falls in (64, 128]
+        ASSERT_EQ(policy.getBatchSizeHistogram().getBucket(7), 1);
+        // 2ms falls in (1, 2]
+        ASSERT_EQ(policy.getLatencyHistogram().getBucket(1), 1);
+    }
+
+    TEST(FlushPolicyTest, FlushesOnLatency)
+    {
+        FlushPolicy policy(1000, 50);
+        auto t0 = steady_clock::now();
+
+        // A single route change must not wait for the batch to fill up
+        policy.addPending(1, t0);
+        ASSERT_EQ(policy.getTimeout(t0), 50);
+        ASSERT_EQ(policy.getTimeout(t0 + milliseconds(30)), 20);
+        ASSERT_FALSE(policy.isFlushDue(t0 + milliseconds(49)));
+
+        // The clock starts with the first unflushed task, not the last one
+        policy.addPending(1, t0 + milliseconds(40));
+        ASSERT_TRUE(policy.isFlushDue(t0 + milliseconds(50)));
+        ASSERT_EQ(policy.getTimeout(t0 + milliseconds(60)), 0);
+
+        policy.onFlush(t0 + milliseconds(50));
+        ASSERT_EQ(policy.getBatchSizeHistogram().getBucket(1), 1);
+        ASSERT_EQ(policy.getLatencyHistogram().getBucket(6), 1);
+
+        // Nothing pending, a flush is not a batch
+        policy.onFlush(t0 + milliseconds(100));
+        ASSERT_EQ(policy.getBatchSizeHistogram().getCount(), 1);
+
+        vector<string> ts;
+        policy.dump(ts);
+        ASSERT_EQ(ts.size(), 3);
+        ASSERT_EQ(ts[0], "flushes:1");
+        ASSERT_EQ(ts[1], "batch size <=2:1");
+        ASSERT_EQ(ts[2], "latency ms <=64:1");
+    }
+
+    TEST(FlushPolicyTest, HistogramBuckets)
+    {
+        FlushHistogram hist;
+        hist.add(0);
+        hist.add(1);
+        hist.add(3);
+        hist.add(UINT64_MAX);
+
+        ASSERT_EQ(hist.getCount(), 4);
+        ASSERT_EQ(hist.getBucket(0), 2);
+        ASSERT_EQ(hist.getBucket(2), 1);
+        ASSERT_EQ(hist.getBucket(FlushHistogram::BUCKETS - 1), 1);
+        ASSERT_EQ(hist.toString(), "<=1:2 <=4:1 >262144:1");
+    }
+}
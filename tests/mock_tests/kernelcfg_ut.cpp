@@ -0,0 +1,208 @@
+#include <net/if.h>
+#include <net/ethernet.h>
+#include <linux/if_bridge.h>
+#include <linux/rtnetlink.h>
+#include <netlink/msg.h>
+#include <netlink/attr.h>
+#include "gtest/gtest.h"
+#define private public
+#include "kernelcfg.h"
+#undef private
+
+namespace kernelcfg_test
+{
+    using namespace std;
+    using namespace swss;
+
+    /*
+     * The requests are only encoded and checked here, none is sent to the
+     * kernel. Those needing an ifindex use lo.
+     */
+    struct KernelCfgTest : public ::testing::Test
+    {
+        KernelCfg m_cfg;
+
+        struct nlmsghdr *request(size_t i)
+        {
+            EXPECT_LT(i, m_cfg.m_requests.size());
+            EXPECT_NE(m_cfg.m_requests[i].msg, nullptr);
+            return nlmsg_hdr(m_cfg.m_requests[i].msg);
+        }
+
+        void parseLink(size_t i, struct ifinfomsg **ifi, struct nlattr **tb)
+        {
+            struct nlmsghdr *hdr = request(i);
+            *ifi = (struct ifinfomsg *)nlmsg_data(hdr);
+            ASSERT_EQ(nlmsg_parse(hdr, sizeof(struct ifinfomsg), tb, IFLA_MAX, NULL), 0);
+        }
+
+        void parseAddr(size_t i, struct ifaddrmsg **ifa, struct nlattr **tb)
+        {
+            struct nlmsghdr *hdr = request(i);
+            *ifa = (struct ifaddrmsg *)nlmsg_data(hdr);
+            ASSERT_EQ(nlmsg_parse(hdr, sizeof(struct ifaddrmsg), tb, IFA_MAX, NULL), 0);
+        }
+
+        void checkError(size_t i, int err, const string &desc)
+        {
+            ASSERT_LT(i, m_cfg.m_requests.size());
+            ASSERT_EQ(m_cfg.m_requests[i].msg, nullptr);
+            ASSERT_EQ(m_cfg.m_requests[i].err, err);
+            ASSERT_EQ(m_cfg.m_requests[i].desc, desc);
+        }
+    };
+
+    TEST_F(KernelCfgTest, LinkRequests)
+    {
+        struct ifinfomsg *ifi;
+        struct nlattr *tb[IFLA_MAX + 1];
+
+        m_cfg.setLinkAdminState("Ethernet0", "up");
+        m_cfg.setLinkAdminState("Ethernet4", false);
+        m_cfg.setLinkMtu("Ethernet0", "9100");
+        m_cfg.setLinkMac("Vlan10", MacAddress("00:01:02:03:04:05"));
+        m_cfg.setLinkMaster("Ethernet0", "");
+        m_cfg.setLinkMaster("Ethernet0", "lo");
+        ASSERT_EQ(m_cfg.pending(), 6);
+
+        parseLink(0, &ifi, tb);
+        ASSERT_EQ(request(0)->nlmsg_type, RTM_NEWLINK);
+        ASSERT_EQ(ifi->ifi_family, AF_UNSPEC);
+        ASSERT_EQ(ifi->ifi_index, 0);
+        ASSERT_EQ(ifi->ifi_change, (unsigned)IFF_UP);
+        ASSERT_EQ(ifi->ifi_flags, (unsigned)IFF_UP);
+        ASSERT_NE(tb[IFLA_IFNAME], nullptr);
+        ASSERT_STREQ(nla_get_string(tb[IFLA_IFNAME]), "Ethernet0");
+        ASSERT_EQ(m_cfg.m_requests[0].desc, "ip link set Ethernet0 up");
+
+        parseLink(1, &ifi, tb);
+        ASSERT_EQ(ifi->ifi_change, (unsigned)IFF_UP);
+        ASSERT_EQ(ifi->ifi_flags, 0u);
+        ASSERT_EQ(m_cfg.m_requests[1].desc, "ip link set Ethernet4 down");
+
+        parseLink(2, &ifi, tb);
+        ASSERT_EQ(ifi->ifi_change, 0u);
+        ASSERT_NE(tb[IFLA_MTU], nullptr);
+        ASSERT_EQ(nla_get_u32(tb[IFLA_MTU]), 9100u);
+
+        parseLink(3, &ifi, tb);
+        ASSERT_NE(tb[IFLA_ADDRESS], nullptr);
+        ASSERT_EQ(nla_len(tb[IFLA_ADDRESS]), ETHER_ADDR_LEN);
+        ASSERT_EQ(MacAddress((const uint8_t *)nla_data(tb[IFLA_ADDRESS])), MacAddress("00:01:02:03:04:05"));
+        ASSERT_STREQ(nla_get_string(tb[IFLA_IFNAME]), "Vlan10");
+
+        parseLink(4, &ifi, tb);
+        ASSERT_NE(tb[IFLA_MASTER], nullptr);
+        ASSERT_EQ(nla_get_u32(tb[IFLA_MASTER]), 0u);
+        ASSERT_EQ(m_cfg.m_requests[4].desc, "ip link set Ethernet0 nomaster");
+
+        parseLink(5, &ifi, tb);
+        ASSERT_EQ(nla_get_u32(tb[IFLA_MASTER]), if_nametoindex("lo"));
+    }
+
+    TEST_F(KernelCfgTest, AddressRequests)
+    {
+        struct ifaddrmsg *ifa;
+        struct nlattr *tb[IFA_MAX + 1];
+        uint32_t lo = if_nametoindex("lo");
+
+        m_cfg.addAddress("lo", IpPrefix("10.1.0.1/24"), true);
+        m_cfg.addAddress("lo", IpPrefix("fc00::1/64"), false, 256);
+        m_cfg.delAddress("lo", IpPrefix("10.1.0.1/24"));
+
+        parseAddr(0, &ifa, tb);
+        ASSERT_EQ(request(0)->nlmsg_type, RTM_NEWADDR);
+        ASSERT_EQ(request(0)->nlmsg_flags & (NLM_F_CREATE | NLM_F_EXCL), NLM_F_CREATE | NLM_F_EXCL);
+        ASSERT_EQ(ifa->ifa_family, AF_INET);
+        ASSERT_EQ(ifa->ifa_prefixlen, 24);
+        ASSERT_EQ(ifa->ifa_index, lo);
+        ASSERT_EQ(IpAddress(*(uint32_t *)nla_data(tb[IFA_LOCAL])), IpAddress("10.1.0.1"));
+        ASSERT_EQ(IpAddress(*(uint32_t *)nla_data(tb[IFA_ADDRESS])), IpAddress("10.1.0.1"));
+        ASSERT_NE(tb[IFA_BROADCAST], nullptr);
+        ASSERT_EQ(IpAddress(*(uint32_t *)nla_data(tb[IFA_BROADCAST])), IpAddress("10.1.0.255"));
+        ASSERT_EQ(tb[IFA_RT_PRIORITY], nullptr);
+
+        parseAddr(1, &ifa, tb);
+        ASSERT_EQ(ifa->ifa_family, AF_INET6);
+        ASSERT_EQ(ifa->ifa_prefixlen, 64);
+        ASSERT_EQ(nla_len(tb[IFA_LOCAL]), 16);
+        ASSERT_EQ(tb[IFA_BROADCAST], nullptr);
+        ASSERT_NE(tb[IFA_RT_PRIORITY], nullptr);
+        ASSERT_EQ(nla_get_u32(tb[IFA_RT_PRIORITY]), 256u);
+
+        parseAddr(2, &ifa, tb);
+        ASSERT_EQ(request(2)->nlmsg_type, RTM_DELADDR);
+        ASSERT_EQ(ifa->ifa_prefixlen, 24);
+        ASSERT_NE(tb[IFA_LOCAL], nullptr);
+        ASSERT_EQ(m_cfg.m_requests[2].desc, "ip address del 10.1.0.1/24 dev lo");
+    }
+
+    TEST_F(KernelCfgTest, BridgeVlanRequests)
+    {
+        struct ifinfomsg *ifi;
+        struct nlattr *tb[IFLA_MAX + 1];
+        struct nlattr *attr;
+        int rem;
+        vector<struct bridge_vlan_info> vinfos;
+
+        m_cfg.addBridgeVlan("lo", 10, true, true);
+        m_cfg.addBridgeVlanRange("lo", 20, 30, false);
+
+        parseLink(0, &ifi, tb);
+        ASSERT_EQ(request(0)->nlmsg_type, RTM_SETLINK);
+        ASSERT_EQ(ifi->ifi_family, AF_BRIDGE);
+        ASSERT_EQ(ifi->ifi_index, (int)if_nametoindex("lo"));
+        ASSERT_NE(tb[IFLA_AF_SPEC], nullptr);
+        nla_for_each_nested(attr, tb[IFLA_AF_SPEC], rem)
+        {
+            ASSERT_EQ(nla_type(attr), IFLA_BRIDGE_VLAN_INFO);
+            vinfos.push_back(*(struct bridge_vlan_info *)nla_data(attr));
+        }
+        ASSERT_EQ(vinfos.size(), 1);
+        ASSERT_EQ(vinfos[0].vid, 10);
+        ASSERT_EQ(vinfos[0].flags, BRIDGE_VLAN_INFO_PVID | BRIDGE_VLAN_INFO_UNTAGGED);
+
+        /* A range is sent as its first and last VLAN */
+        vinfos.clear();
+        parseLink(1, &ifi, tb);
+        nla_for_each_nested(attr, tb[IFLA_AF_SPEC], rem)
+        {
+            vinfos.push_back(*(struct bridge_vlan_info *)nla_data(attr));
+        }
+        ASSERT_EQ(vinfos.size(), 2);
+        ASSERT_EQ(vinfos[0].vid, 20);
+        ASSERT_EQ(vinfos[0].flags, BRIDGE_VLAN_INFO_RANGE_BEGIN);
+        ASSERT_EQ(vinfos[1].vid, 30);
+        ASSERT_EQ(vinfos[1].flags, BRIDGE_VLAN_INFO_RANGE_END);
+        ASSERT_EQ(m_cfg.m_requests[1].desc, "bridge vlan add vid 20-30 dev lo");
+    }
+
+    TEST_F(KernelCfgTest, InvalidRequestsFailFlush)
+    {
+        m_cfg.setLinkAdminState("Ethernet0", "bogus");
+        m_cfg.setLinkMtu("Ethernet0", "9100x");
+        m_cfg.setLinkMtu("Ethernet0", "0");
+        m_cfg.setLinkMaster("Ethernet0", "NoSuchDevice0");
+        m_cfg.addBridgeVlanRange("lo", 30, 20, false);
+        m_cfg.addBridgeVlan("lo", 4095, false, false);
+        m_cfg.addAddress("NoSuchDevice0", IpPrefix("10.1.0.1/24"), true);
+
+        checkError(0, -EINVAL, "ip link set Ethernet0 bogus");
+        checkError(1, -EINVAL, "ip link set Ethernet0 mtu 9100x");
+        checkError(2, -EINVAL, "ip link set Ethernet0 mtu 0");
+        checkError(3, -ENODEV, "ip link set Ethernet0 master NoSuchDevice0");
+        checkError(4, -EINVAL, "bridge vlan add vid 30-20 dev lo");
+        checkError(5, -EINVAL, "bridge vlan add vid 4095 dev lo");
+        checkError(6, -ENODEV, "ip address add 10.1.0.1/24 dev NoSuchDevice0");
+
+        /* Nothing is sent, the first failed request is reported */
+        string error;
+        ASSERT_FALSE(m_cfg.flush(error));
+        ASSERT_EQ(error, string("ip link set Ethernet0 bogus : ") + strerror(EINVAL));
+        ASSERT_EQ(m_cfg.pending(), 0);
+
+        m_cfg.setLinkMtu("Ethernet0", "");
+        ASSERT_THROW(m_cfg.flush(), runtime_error);
+        ASSERT_EQ(m_cfg.pending(), 0);
+    }
+}
@@ -0,0 +1,323 @@
+#define private public // make Directory::m_values available to clean it.
+#include "directory.h"
+#undef private
+#define protected public
+#include "orch.h"
+#undef protected
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+
+extern string gMySwitchType;
+
+
+namespace neighorch_test
+{
+    using namespace std;
+
+    shared_ptr<swss::DBConnector> m_app_db;
+    shared_ptr<swss::DBConnector> m_config_db;
+    shared_ptr<swss::DBConnector> m_state_db;
+    shared_ptr<swss::DBConnector> m_chassis_app_db;
+
+    int remove_neighbor_count;
+    sai_ip4_t fail_next_hop_ip4;
+
+    sai_next_hop_api_t ut_sai_next_hop_api;
+    sai_next_hop_api_t *pold_sai_next_hop_api;
+    sai_neighbor_api_t ut_sai_neighbor_api;
+    sai_neighbor_api_t *pold_sai_neighbor_api;
+
+    sai_status_t _ut_stub_sai_bulk_create_next_hop(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            sai_ip4_t ip4 = 0;
+            for (uint32_t j = 0; j < attr_count[i]; j++)
+            {
+                if (attr_list[i][j].id == SAI_NEXT_HOP_ATTR_IP)
+                {
+                    ip4 = attr_list[i][j].value.ipaddr.addr.ip4;
+                }
+            }
+
+            // Fail the next hop of the chosen neighbor, create the others one by one
+            if (ip4 == fail_next_hop_ip4)
+            {
+                object_id[i] = SAI_NULL_OBJECT_ID;
+                object_statuses[i] = SAI_STATUS_INSUFFICIENT_RESOURCES;
+                status = SAI_STATUS_FAILURE;
+                continue;
+            }
+
+            object_statuses[i] = pold_sai_next_hop_api->create_next_hop(&object_id[i], switch_id, attr_count[i], attr_list[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t _ut_stub_sai_remove_neighbor_entry(
+        _In_ const sai_neighbor_entry_t *neighbor_entry)
+    {
+        remove_neighbor_count++;
+        return pold_sai_neighbor_api->remove_neighbor_entry(neighbor_entry);
+    }
+
+    // The default handling exits orchagent on a failed create, retry instead
+    struct RetryNeighOrch : public NeighOrch
+    {
+        using NeighOrch::NeighOrch;
+
+        task_process_status handleSaiCreateStatus(sai_api_t api, sai_status_t status, void *context = nullptr) override
+        {
+            return task_need_retry;
+        }
+    };
+
+    struct NeighOrchTest : public ::testing::Test
+    {
+        NeighOrchTest()
+        {
+        }
+
+        void SetUp() override
+        {
+            map<string, string> profile = {
+                { "SAI_VS_SWITCH_TYPE", "SAI_VS_SWITCH_TYPE_BCM56850" },
+                { "KV_DEVICE_MAC_ADDRESS", "20:03:04:05:06:00" }
+            };
+
+            ut_helper::initSaiApi(profile);
+
+            // Hack the next hop bulk create and the neighbor remove functions,
+            // the bulkers of NeighOrch take their functions when constructed
+            pold_sai_next_hop_api = sai_next_hop_api;
+            ut_sai_next_hop_api = *sai_next_hop_api;
+            sai_next_hop_api = &ut_sai_next_hop_api;
+            sai_next_hop_api->create_next_hops = _ut_stub_sai_bulk_create_next_hop;
+
+            pold_sai_neighbor_api = sai_neighbor_api;
+            ut_sai_neighbor_api = *sai_neighbor_api;
+            sai_neighbor_api = &ut_sai_neighbor_api;
+            sai_neighbor_api->remove_neighbor_entry = _ut_stub_sai_remove_neighbor_entry;
+
+            remove_neighbor_count = 0;
+            fail_next_hop_ip4 = 0;
+
+            // Init switch and create dependencies
+            m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+            if(gMySwitchType == "voq")
+                m_chassis_app_db = make_shared<swss::DBConnector>("CHASSIS_APP_DB", 0);
+
+            sai_attribute_t attr;
+
+            attr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+            attr.value.booldata = true;
+
+            auto status = sai_switch_api->create_switch(&gSwitchId, 1, &attr);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            // Get switch source MAC address
+            attr.id = SAI_SWITCH_ATTR_SRC_MAC_ADDRESS;
+            status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            gMacAddress = attr.value.mac;
+
+            // Get the default virtual router ID
+            attr.id = SAI_SWITCH_ATTR_DEFAULT_VIRTUAL_ROUTER_ID;
+            status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            gVirtualRouterId = attr.value.oid;
+
+            ASSERT_EQ(gCrmOrch, nullptr);
+            gCrmOrch = new CrmOrch(m_config_db.get(), CFG_CRM_TABLE_NAME);
+
+            TableConnector stateDbSwitchTable(m_state_db.get(), "SWITCH_CAPABILITY");
+            TableConnector conf_asic_sensors(m_config_db.get(), CFG_ASIC_SENSORS_TABLE_NAME);
+            TableConnector app_switch_table(m_app_db.get(),  APP_SWITCH_TABLE_NAME);
+
+            vector<TableConnector> switch_tables = {
+                conf_asic_sensors,
+                app_switch_table
+            };
+
+            ASSERT_EQ(gSwitchOrch, nullptr);
+            gSwitchOrch = new SwitchOrch(m_app_db.get(), switch_tables, stateDbSwitchTable);
+
+            // Create dependencies ...
+
+            const int portsorch_base_pri = 40;
+
+            vector<table_name_with_pri_t> ports_tables = {
+                { APP_PORT_TABLE_NAME, portsorch_base_pri + 5 },
+                { APP_VLAN_TABLE_NAME, portsorch_base_pri + 2 },
+                { APP_VLAN_MEMBER_TABLE_NAME, portsorch_base_pri },
+                { APP_LAG_TABLE_NAME, portsorch_base_pri + 4 },
+                { APP_LAG_MEMBER_TABLE_NAME, portsorch_base_pri }
+            };
+
+            vector<string> flex_counter_tables = {
+                CFG_FLEX_COUNTER_TABLE_NAME
+            };
+            auto* flexCounterOrch = new FlexCounterOrch(m_config_db.get(), flex_counter_tables);
+            gDirectory.set(flexCounterOrch);
+
+            ASSERT_EQ(gPortsOrch, nullptr);
+            gPortsOrch = new PortsOrch(m_app_db.get(), m_state_db.get(), ports_tables, m_chassis_app_db.get());
+
+            vector<string> buffer_tables = { APP_BUFFER_POOL_TABLE_NAME,
+                                             APP_BUFFER_PROFILE_TABLE_NAME,
+                                             APP_BUFFER_QUEUE_TABLE_NAME,
+                                             APP_BUFFER_PG_TABLE_NAME,
+                                             APP_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME,
+                                             APP_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME };
+
+            gBufferOrch = new BufferOrch(m_app_db.get(), m_config_db.get(), m_state_db.get(), buffer_tables);
+
+            ASSERT_EQ(gVrfOrch, nullptr);
+            gVrfOrch = new VRFOrch(m_app_db.get(), APP_VRF_TABLE_NAME, m_state_db.get(), STATE_VRF_OBJECT_TABLE_NAME);
+
+            ASSERT_EQ(gIntfsOrch, nullptr);
+            gIntfsOrch = new IntfsOrch(m_app_db.get(), APP_INTF_TABLE_NAME, gVrfOrch, m_chassis_app_db.get());
+
+            const int fdborch_pri = 20;
+
+            vector<table_name_with_pri_t> app_fdb_tables = {
+                { APP_FDB_TABLE_NAME,        FdbOrch::fdborch_pri},
+                { APP_VXLAN_FDB_TABLE_NAME,  FdbOrch::fdborch_pri},
+                { APP_MCLAG_FDB_TABLE_NAME,  fdborch_pri}
+            };
+
+            TableConnector stateDbFdb(m_state_db.get(), STATE_FDB_TABLE_NAME);
+            TableConnector stateMclagDbFdb(m_state_db.get(), STATE_MCLAG_REMOTE_FDB_TABLE_NAME);
+            ASSERT_EQ(gFdbOrch, nullptr);
+            gFdbOrch = new FdbOrch(m_app_db.get(), app_fdb_tables, stateDbFdb, stateMclagDbFdb, gPortsOrch);
+
+            ASSERT_EQ(gNeighOrch, nullptr);
+            gNeighOrch = new RetryNeighOrch(m_app_db.get(), APP_NEIGH_TABLE_NAME, gIntfsOrch, gFdbOrch, gPortsOrch, m_chassis_app_db.get());
+
+            TunnelDecapOrch *tunnel_decap_orch = new TunnelDecapOrch(m_app_db.get(), APP_TUNNEL_DECAP_TABLE_NAME);
+            vector<string> mux_tables = {
+                CFG_MUX_CABLE_TABLE_NAME,
+                CFG_PEER_SWITCH_TABLE_NAME
+            };
+            MuxOrch *mux_orch = new MuxOrch(m_config_db.get(), mux_tables, tunnel_decap_orch, gNeighOrch, gFdbOrch);
+            gDirectory.set(mux_orch);
+
+            Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+
+            // Get SAI default ports to populate DB
+            auto ports = ut_helper::getInitialSaiPorts();
+
+            // Populate pot table with SAI ports
+            for (const auto &it : ports)
+            {
+                portTable.set(it.first, it.second);
+            }
+
+            // Set PortConfigDone
+            portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+            gPortsOrch->addExistingData(&portTable);
+            static_cast<Orch *>(gPortsOrch)->doTask();
+
+            portTable.set("PortInitDone", { { "lanes", "0" } });
+            gPortsOrch->addExistingData(&portTable);
+            static_cast<Orch *>(gPortsOrch)->doTask();
+
+            Table intfTable = Table(m_app_db.get(), APP_INTF_TABLE_NAME);
+            intfTable.set("Ethernet0", { {"NULL", "NULL" },
+                                         {"mac_addr", "00:00:00:00:00:00" }});
+            intfTable.set("Ethernet0:10.0.0.1/24", { { "scope", "global" },
+                                                     { "family", "IPv4" }});
+            gIntfsOrch->addExistingData(&intfTable);
+            static_cast<Orch *>(gIntfsOrch)->doTask();
+        }
+
+        void TearDown() override
+        {
+            gDirectory.m_values.clear();
+
+            delete gCrmOrch;
+            gCrmOrch = nullptr;
+
+            delete gSwitchOrch;
+            gSwitchOrch = nullptr;
+
+            delete gVrfOrch;
+            gVrfOrch = nullptr;
+
+            delete gIntfsOrch;
+            gIntfsOrch = nullptr;
+
+            delete gNeighOrch;
+            gNeighOrch = nullptr;
+
+            delete gFdbOrch;
+            gFdbOrch = nullptr;
+
+            delete gBufferOrch;
+            gBufferOrch = nullptr;
+
+            delete gPortsOrch;
+            gPortsOrch = nullptr;
+
+            sai_next_hop_api = pold_sai_next_hop_api;
+            sai_neighbor_api = pold_sai_neighbor_api;
+            ut_helper::uninitSaiApi();
+        }
+    };
+
+    TEST_F(NeighOrchTest, NeighborBulkNextHopFailure)
+    {
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"Ethernet0:10.0.0.2", "SET", { {"neigh", "00:00:0a:00:00:02"},
+                                                          {"family", "IPv4"}}});
+        entries.push_back({"Ethernet0:10.0.0.3", "SET", { {"neigh", "00:00:0a:00:00:03"},
+                                                          {"family", "IPv4"}}});
+        entries.push_back({"Ethernet0:10.0.0.4", "SET", { {"neigh", "00:00:0a:00:00:04"},
+                                                          {"family", "IPv4"}}});
+
+        auto consumer = dynamic_cast<Consumer *>(gNeighOrch->getExecutor(APP_NEIGH_TABLE_NAME));
+        consumer->addToSync(entries);
+
+        // The next hop of 10.0.0.3 fails in the middle of the bulk
+        fail_next_hop_ip4 = IpAddress("10.0.0.3").getV4Addr();
+        static_cast<Orch *>(gNeighOrch)->doTask();
+
+        // The other neighbors of the bulk are synced
+        ASSERT_TRUE(gNeighOrch->hasNextHop(NextHopKey(IpAddress("10.0.0.2"), "Ethernet0")));
+        ASSERT_TRUE(gNeighOrch->hasNextHop(NextHopKey(IpAddress("10.0.0.4"), "Ethernet0")));
+
+        // The failed neighbor is rolled back and kept for retry
+        ASSERT_FALSE(gNeighOrch->hasNextHop(NextHopKey(IpAddress("10.0.0.3"), "Ethernet0")));
+        ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(NeighborEntry(IpAddress("10.0.0.3"), "Ethernet0")), 0);
+        ASSERT_EQ(remove_neighbor_count, 1);
+        ASSERT_EQ(consumer->m_toSync.size(), 1);
+        ASSERT_EQ(kfvKey(consumer->m_toSync.begin()->second), "Ethernet0:10.0.0.3");
+
+        // The retry creates the neighbor once the next hop can be created
+        fail_next_hop_ip4 = 0;
+        static_cast<Orch *>(gNeighOrch)->doTask();
+
+        ASSERT_TRUE(gNeighOrch->hasNextHop(NextHopKey(IpAddress("10.0.0.3"), "Ethernet0")));
+        ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(NeighborEntry(IpAddress("10.0.0.3"), "Ethernet0")), 1);
+        ASSERT_EQ(consumer->m_toSync.size(), 0);
+    }
+}
@@ -5,6 +5,7 @@
 
 #include "aclorch.h"
 #include "crmorch.h"
+#include "neighorch.h"
 
 #undef protected
 #undef private
@@ -37,6 +38,19 @@ struct Portal
         }
     };
 
+    struct NeighOrchInternal
+    {
+        static const NeighborTable &getSyncdNeighbors(const NeighOrch *neighOrch)
+        {
+            return neighOrch->m_syncdNeighbors;
+        }
+
+        static const NeighborIndex &getSyncdNeighborIndex(const NeighOrch *neighOrch)
+        {
+            return neighOrch->m_syncdNeighborIndex;
+        }
+    };
+
     struct CrmOrchInternal
     {
         static const std::map<CrmResourceType, CrmOrch::CrmResourceEntry> &getResourceMap(const CrmOrch *crmOrch)
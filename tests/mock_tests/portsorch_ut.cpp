@@ -1083,4 +1083,122 @@ namespace portsorch_test
 
         ASSERT_FALSE(bridgePortCalledBeforeLagMember); // bridge port created on lag before lag member was created
     }
+
+    /*
+    * The scope of this test is to verify that VLANs are looked up by VLAN ID
+    * through the index kept by addVlan and removeVlan.
+    */
+    TEST_F(PortsOrchTest, VlanIsFoundByVlanIdAfterAddAndNotAfterRemove)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        Table vlanTable = Table(m_app_db.get(), APP_VLAN_TABLE_NAME);
+
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        // Populate pot table with SAI ports
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { } });
+
+        vlanTable.set("Vlan5", { {"admin_status", "up"}, {"mtu", "9100"} });
+        vlanTable.set("Vlan4094", { {"admin_status", "up"}, {"mtu", "9100"} });
+
+        // refill consumer
+        gPortsOrch->addExistingData(&portTable);
+        gPortsOrch->addExistingData(&vlanTable);
+
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        Port vlan;
+        ASSERT_TRUE(gPortsOrch->getVlanByVlanId(5, vlan));
+        ASSERT_EQ(vlan.m_alias, "Vlan5");
+
+        const Port *vlanPtr = gPortsOrch->findVlanByVlanId(4094);
+        ASSERT_NE(vlanPtr, nullptr);
+        ASSERT_EQ(vlanPtr->m_alias, "Vlan4094");
+        ASSERT_EQ(vlanPtr->m_type, Port::VLAN);
+
+        ASSERT_EQ(gPortsOrch->findVlanByVlanId(100), nullptr);
+        ASSERT_FALSE(gPortsOrch->getVlanByVlanId(100, vlan));
+
+        // Remove Vlan5 and verify only Vlan4094 remains indexed
+        vlanTable.del("Vlan5");
+        auto consumer = static_cast<Consumer*>(gPortsOrch->getExecutor(APP_VLAN_TABLE_NAME));
+        consumer->addToSync(KeyOpFieldsValuesTuple("Vlan5", DEL_COMMAND, vector<FieldValueTuple>()));
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ASSERT_EQ(gPortsOrch->findVlanByVlanId(5), nullptr);
+        ASSERT_NE(gPortsOrch->findVlanByVlanId(4094), nullptr);
+    }
+
+    /*
+    * The scope of this test is to verify that the non-copying port accessors
+    * return the stored port while a LAG member storm is processed.
+    */
+    TEST_F(PortsOrchTest, LagMemberStormPortLookup)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        Table lagTable = Table(m_app_db.get(), APP_LAG_TABLE_NAME);
+        Table lagMemberTable = Table(m_app_db.get(), APP_LAG_MEMBER_TABLE_NAME);
+
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        // Populate pot table with SAI ports
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { } });
+
+        gPortsOrch->addExistingData(&portTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        // Add every port to the same LAG in one batch
+        lagTable.set("PortChannel0001", { {"admin_status", "up"}, {"mtu", "9100"} });
+        for (const auto &it : ports)
+        {
+            lagMemberTable.set(
+                std::string("PortChannel0001") + lagMemberTable.getTableNameSeparator() + it.first,
+                { {"status", "enabled"} });
+        }
+
+        gPortsOrch->addExistingData(&lagTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        // The member storm looks ports up in place, no Port is copied
+        size_t copyCount = gPortsOrch->getPortCopyCount();
+
+        gPortsOrch->addExistingData(&lagMemberTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ASSERT_EQ(gPortsOrch->getPortCopyCount(), copyCount);
+
+        const Port *lagPtr = gPortsOrch->findPort("PortChannel0001");
+        ASSERT_NE(lagPtr, nullptr);
+        ASSERT_EQ(lagPtr->m_members.size(), ports.size());
+
+        // The pointer lookup returns the stored port, a copying lookup returns an equal copy
+        ASSERT_EQ(gPortsOrch->findPort("PortChannel0001"), lagPtr);
+
+        Port lag;
+        ASSERT_TRUE(gPortsOrch->getPort("PortChannel0001", lag));
+        ASSERT_EQ(gPortsOrch->getPortCopyCount(), copyCount + 1);
+        ASSERT_NE(&lag, lagPtr);
+        ASSERT_EQ(lag.m_members, lagPtr->m_members);
+
+        // In-place updates are visible through the stored port
+        ASSERT_TRUE(gPortsOrch->updatePort("PortChannel0001", [](Port &p) { p.m_fdb_count++; }));
+        ASSERT_EQ(gPortsOrch->findPort("PortChannel0001")->m_fdb_count, 1);
+        ASSERT_FALSE(gPortsOrch->updatePort("PortChannel9999", [](Port &p) { p.m_fdb_count++; }));
+    }
 }
@@ -416,4 +416,168 @@ namespace routeorch_test
         ASSERT_EQ(current_set_count + 1, set_route_count);
         ASSERT_EQ(sai_fail_count, 0);
     }
+
+    TEST_F(RouteOrchTest, NeighborLookupScale)
+    {
+        // Populate the neighbor table up to the given size with neighbors on Ethernet0
+        size_t neighbor_count = 0;
+        auto addNeighbors = [&](size_t count)
+        {
+            std::deque<KeyOpFieldsValuesTuple> entries;
+            for (; neighbor_count < count; neighbor_count++)
+            {
+                string ip = "10.1." + to_string(neighbor_count / 256) + "." + to_string(neighbor_count % 256);
+                entries.push_back({"Ethernet0:" + ip, "SET", { {"neigh", "00:00:0a:01:00:01"},
+                                                               {"family", "IPv4"}}});
+            }
+            auto consumer = dynamic_cast<Consumer *>(gNeighOrch->getExecutor(APP_NEIGH_TABLE_NAME));
+            consumer->addToSync(entries);
+            static_cast<Orch *>(gNeighOrch)->doTask();
+            ASSERT_TRUE(consumer->m_toSync.empty());
+        };
+
+        // Every synced neighbor is indexed and resolved through a short bucket chain,
+        // independently of the number of neighbors
+        auto checkIndex = [&]()
+        {
+            const auto &neighbors = Portal::NeighOrchInternal::getSyncdNeighbors(gNeighOrch);
+            const auto &index = Portal::NeighOrchInternal::getSyncdNeighborIndex(gNeighOrch);
+            ASSERT_EQ(index.size(), neighbors.size());
+            ASSERT_LE(index.load_factor(), index.max_load_factor());
+
+            size_t max_probes = 0;
+            for (const auto &neighbor : neighbors)
+            {
+                NeighborIndexKey key(neighbor.first.ip_address, neighbor.first.alias);
+                auto found = index.find(key);
+                ASSERT_NE(found, index.end());
+                ASSERT_EQ(found->second->first, neighbor.first);
+                max_probes = max(max_probes, index.bucket_size(index.bucket(key)));
+            }
+            ASSERT_LE(max_probes, 8u);
+
+            size_t last = neighbor_count - 1;
+            NextHopKey nexthop(IpAddress("10.1." + to_string(last / 256) + "." + to_string(last % 256)), "Ethernet0");
+            NeighborEntry neighbor_entry;
+            MacAddress mac;
+            ASSERT_TRUE(gNeighOrch->getNeighborEntry(nexthop, neighbor_entry, mac));
+            ASSERT_EQ(neighbor_entry.ip_address, nexthop.ip_address);
+            ASSERT_EQ(mac, MacAddress("00:00:0a:01:00:01"));
+        };
+
+        addNeighbors(256);
+        checkIndex();
+
+        addNeighbors(8192);
+        checkIndex();
+
+        // Disabled neighbors are not resolvable until enabled again
+        NeighborEntry neighbor_entry;
+        MacAddress mac;
+        NextHopKey nexthop(IpAddress("10.1.0.1"), "Ethernet0");
+        ASSERT_TRUE(gNeighOrch->disableNeighbor(nexthop));
+        ASSERT_FALSE(gNeighOrch->getNeighborEntry(nexthop, neighbor_entry, mac));
+        ASSERT_TRUE(gNeighOrch->enableNeighbor(nexthop));
+        ASSERT_TRUE(gNeighOrch->getNeighborEntry(nexthop, neighbor_entry, mac));
+
+        // Removed neighbors are dropped from the lookup index
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"Ethernet0:10.1.0.1", "DEL", { {} }});
+        auto consumer = dynamic_cast<Consumer *>(gNeighOrch->getExecutor(APP_NEIGH_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gNeighOrch)->doTask();
+        ASSERT_FALSE(gNeighOrch->getNeighborEntry(nexthop, neighbor_entry, mac));
+    }
+
+    TEST(NextHopGroupKeyTest, InternedKeysShareNextHops)
+    {
+        NextHopGroupKeyCache cache;
+        const string nexthops = "10.0.0.1@Ethernet0,10.0.0.3@Ethernet4";
+
+        NextHopGroupKey a = cache.get(nexthops, "1,2");
+        NextHopGroupKey b = cache.get(nexthops, "1,2");
+        ASSERT_EQ(cache.size(), 1);
+        ASSERT_EQ(&a.getNextHops(), &b.getNextHops());
+        ASSERT_EQ(a, b);
+
+        // A parsed key compares and hashes the same as the interned one
+        NextHopGroupKey parsed(nexthops, "1,2");
+        ASSERT_EQ(parsed, a);
+        ASSERT_EQ(parsed.getHash(), a.getHash());
+        ASSERT_FALSE(parsed < a);
+        ASSERT_FALSE(a < parsed);
+
+        // Weights are part of the group
+        NextHopGroupKey weighted = cache.get(nexthops, "2,1");
+        ASSERT_EQ(cache.size(), 2);
+        ASSERT_NE(weighted, a);
+
+        // Modifying a copy does not touch the interned key
+        b.remove("10.0.0.3", "Ethernet4");
+        ASSERT_EQ(b.getSize(), 1);
+        ASSERT_EQ(a.getSize(), 2);
+        ASSERT_EQ(cache.get(nexthops, "1,2").getSize(), 2);
+        ASSERT_NE(a, b);
+        b.add("10.0.0.3", "Ethernet4");
+        ASSERT_EQ(b.to_string(), a.to_string());
+
+        NextHopGroupTable table;
+        table[a].ref_count = 1;
+        ASSERT_NE(table.find(parsed), table.end());
+        ASSERT_EQ(table.find(weighted), table.end());
+    }
+
+    TEST(NextHopGroupKeyTest, InternedKeyLookupScale)
+    {
+        // Many routes sharing a few wide ECMP groups
+        const int groups = 100;
+        const int width = 32;
+        const int routes = 20000;
+
+        vector<string> groupStrs;
+        for (int g = 0; g < groups; g++)
+        {
+            string str;
+            for (int n = 0; n < width; n++)
+            {
+                if (n) str += NHG_DELIMITER;
+                str += "10." + to_string(g) + "." + to_string(n) + ".1@Ethernet" + to_string(n * 4);
+            }
+            groupStrs.push_back(str);
+        }
+
+        NextHopGroupTable table;
+        for (const auto &str : groupStrs)
+        {
+            table[NextHopGroupKey(str, "")].ref_count = 0;
+        }
+
+        auto start = chrono::steady_clock::now();
+        for (int r = 0; r < routes; r++)
+        {
+            NextHopGroupKey nhg(groupStrs[r % groups], "");
+            table[nhg].ref_count++;
+        }
+        auto parseTime = chrono::steady_clock::now() - start;
+
+        NextHopGroupKeyCache cache;
+        start = chrono::steady_clock::now();
+        for (int r = 0; r < routes; r++)
+        {
+            NextHopGroupKey nhg = cache.get(groupStrs[r % groups], "");
+            table[nhg].ref_count++;
+        }
+        auto internTime = chrono::steady_clock::now() - start;
+
+        cout << routes << " routes over " << groups << " groups of " << width << ": parsed "
+             << chrono::duration_cast<chrono::microseconds>(parseTime).count() << "us, interned "
+             << chrono::duration_cast<chrono::microseconds>(internTime).count() << "us" << endl;
+
+        ASSERT_EQ(table.size(), static_cast<size_t>(groups));
+        for (const auto &it : table)
+        {
+            ASSERT_EQ(it.second.ref_count, 2 * routes / groups);
+        }
+        ASSERT_EQ(cache.size(), static_cast<size_t>(groups));
+    }
 }
@@ -0,0 +1,239 @@
+#include <net/if.h>
+#include <netlink/msg.h>
+#include "gtest/gtest.h"
+#include "netdispatcher.h"
+#define private public
+#include "fpmsyncd/routesync.h"
+#undef private
+
+namespace routesync_test
+{
+    using namespace std;
+    using namespace swss;
+
+    /* Builds a route netlink message the way zebra writes it to the FPM socket */
+    class RouteMsg
+    {
+    public:
+        RouteMsg(uint16_t type, unsigned char family, unsigned char dst_len, unsigned char rt_type = RTN_UNICAST)
+        {
+            memset(m_buf, 0, sizeof(m_buf));
+            m_hdr = (struct nlmsghdr *)m_buf;
+            m_hdr->nlmsg_type = type;
+            m_hdr->nlmsg_len = NLMSG_LENGTH(sizeof(struct rtmsg));
+
+            struct rtmsg *rtm = (struct rtmsg *)NLMSG_DATA(m_hdr);
+            rtm->rtm_family = family;
+            rtm->rtm_dst_len = dst_len;
+            /* zebra sets the VRF ifindex as table, 0 for the default VRF */
+            rtm->rtm_table = 0;
+            rtm->rtm_type = rt_type;
+            rtm->rtm_protocol = RTPROT_BGP;
+        }
+
+        struct rtattr *addAttr(unsigned short type, const void *data, size_t len)
+        {
+            struct rtattr *rta = (struct rtattr *)((char *)m_hdr + NLMSG_ALIGN(m_hdr->nlmsg_len));
+            rta->rta_type = type;
+            rta->rta_len = (unsigned short)RTA_LENGTH(len);
+            if (len)
+            {
+                memcpy(RTA_DATA(rta), data, len);
+            }
+            m_hdr->nlmsg_len = NLMSG_ALIGN(m_hdr->nlmsg_len) + RTA_ALIGN(rta->rta_len);
+            return rta;
+        }
+
+        void addAddr(unsigned short type, unsigned char family, const char *addr)
+        {
+            unsigned char data[16];
+            ASSERT_EQ(inet_pton(family, addr, data), 1);
+            addAttr(type, data, family == AF_INET ? 4 : 16);
+        }
+
+        /* RTA_MULTIPATH with one gateway per next hop, hops is the weight - 1 */
+        void addMultipath(unsigned char family, const vector<pair<string, unsigned char>> &nexthops, int if_index)
+        {
+            char mp[512] = {0};
+            size_t mp_len = 0;
+            for (const auto &nh : nexthops)
+            {
+                struct rtnexthop *rtnh = (struct rtnexthop *)(mp + mp_len);
+                rtnh->rtnh_ifindex = if_index;
+                rtnh->rtnh_hops = nh.second;
+
+                struct rtattr *gw = (struct rtattr *)RTNH_DATA(rtnh);
+                size_t addr_len = family == AF_INET ? 4 : 16;
+                gw->rta_type = RTA_GATEWAY;
+                gw->rta_len = (unsigned short)RTA_LENGTH(addr_len);
+                ASSERT_EQ(inet_pton(family, nh.first.c_str(), RTA_DATA(gw)), 1);
+
+                rtnh->rtnh_len = (unsigned short)(sizeof(*rtnh) + RTA_ALIGN(gw->rta_len));
+                mp_len += RTNH_ALIGN(rtnh->rtnh_len);
+            }
+            addAttr(RTA_MULTIPATH, mp, mp_len);
+        }
+
+        struct nlmsghdr *get()
+        {
+            return m_hdr;
+        }
+
+    private:
+        char m_buf[1024];
+        struct nlmsghdr *m_hdr;
+    };
+
+    struct RouteSyncTest : public ::testing::Test
+    {
+        shared_ptr<DBConnector> m_app_db;
+        shared_ptr<RedisPipeline> m_pipeline;
+        shared_ptr<RouteSync> m_fastSync;
+        shared_ptr<RouteSync> m_libnlSync;
+        int m_loIndex;
+
+        void SetUp() override
+        {
+            m_app_db = make_shared<DBConnector>("APPL_DB", 0);
+            m_pipeline = make_shared<RedisPipeline>(m_app_db.get());
+
+            /* Routes are only queued, nothing is flushed to the database */
+            m_fastSync = make_shared<RouteSync>(m_pipeline.get());
+            m_fastSync->setRouteCoalescing(0, 0);
+
+            m_libnlSync = make_shared<RouteSync>(m_pipeline.get());
+            m_libnlSync->setRouteCoalescing(0, 0);
+            m_libnlSync->setFastRouteDecode(false);
+
+            NetDispatcher::getInstance().registerMessageHandler(RTM_NEWROUTE, m_libnlSync.get());
+            NetDispatcher::getInstance().registerMessageHandler(RTM_DELROUTE, m_libnlSync.get());
+
+            m_loIndex = (int)if_nametoindex("lo");
+        }
+
+        void TearDown() override
+        {
+            NetDispatcher::getInstance().unregisterMessageHandler(RTM_NEWROUTE);
+            NetDispatcher::getInstance().unregisterMessageHandler(RTM_DELROUTE);
+        }
+
+        /* Decode the message through both paths, the queued routes must be identical */
+        void checkSameRoute(struct nlmsghdr *h, const string &key)
+        {
+            ASSERT_TRUE(m_fastSync->onRouteMsgFast(h));
+
+            ASSERT_FALSE(m_libnlSync->onRouteMsgFast(h));
+            nl_msg *msg = nlmsg_convert(h);
+            ASSERT_NE(msg, nullptr);
+            nlmsg_set_proto(msg, NETLINK_ROUTE);
+            NetDispatcher::getInstance().onNetlinkMessage(msg);
+            nlmsg_free(msg);
+
+            auto fast = m_fastSync->m_pendingRoutes.find(key);
+            auto libnl = m_libnlSync->m_pendingRoutes.find(key);
+            ASSERT_NE(fast, m_fastSync->m_pendingRoutes.end());
+            ASSERT_NE(libnl, m_libnlSync->m_pendingRoutes.end());
+            ASSERT_EQ(fast->second.del, libnl->second.del);
+            ASSERT_EQ(fast->second.fvVector, libnl->second.fvVector);
+            ASSERT_EQ(m_fastSync->m_pendingRoutes.size(), m_libnlSync->m_pendingRoutes.size());
+        }
+    };
+
+    TEST_F(RouteSyncTest, FastDecodeMatchesLibnlIPv4)
+    {
+        RouteMsg route(RTM_NEWROUTE, AF_INET, 24);
+        route.addAddr(RTA_DST, AF_INET, "16.1.2.0");
+        route.addAddr(RTA_GATEWAY, AF_INET, "10.0.0.1");
+        route.addAttr(RTA_OIF, &m_loIndex, sizeof(m_loIndex));
+        checkSameRoute(route.get(), "16.1.2.0/24");
+
+        /* Directly connected, no gateway */
+        RouteMsg connected(RTM_NEWROUTE, AF_INET, 16);
+        connected.addAddr(RTA_DST, AF_INET, "16.2.0.0");
+        connected.addAttr(RTA_OIF, &m_loIndex, sizeof(m_loIndex));
+        checkSameRoute(connected.get(), "16.2.0.0/16");
+
+        /* Host routes are published without the prefix length */
+        RouteMsg host(RTM_NEWROUTE, AF_INET, 32);
+        host.addAddr(RTA_DST, AF_INET, "16.3.0.1");
+        host.addAddr(RTA_GATEWAY, AF_INET, "10.0.0.1");
+        host.addAttr(RTA_OIF, &m_loIndex, sizeof(m_loIndex));
+        checkSameRoute(host.get(), "16.3.0.1");
+
+        RouteMsg blackhole(RTM_NEWROUTE, AF_INET, 24, RTN_BLACKHOLE);
+        blackhole.addAddr(RTA_DST, AF_INET, "16.4.0.0");
+        checkSameRoute(blackhole.get(), "16.4.0.0/24");
+
+        RouteMsg del(RTM_DELROUTE, AF_INET, 24);
+        del.addAddr(RTA_DST, AF_INET, "16.1.2.0");
+        checkSameRoute(del.get(), "16.1.2.0/24");
+    }
+
+    TEST_F(RouteSyncTest, FastDecodeMatchesLibnlIPv6Multipath)
+    {
+        RouteMsg weighted(RTM_NEWROUTE, AF_INET6, 64);
+        weighted.addAddr(RTA_DST, AF_INET6, "2001:db8:1::");
+        weighted.addMultipath(AF_INET6, { { "fc00::1", 1 }, { "fc00::2", 2 } }, m_loIndex);
+        checkSameRoute(weighted.get(), "2001:db8:1::/64");
+
+        RouteMsg unweighted(RTM_NEWROUTE, AF_INET6, 64);
+        unweighted.addAddr(RTA_DST, AF_INET6, "2001:db8:2::");
+        /* Weights are only published if every next hop has one */
+        unweighted.addMultipath(AF_INET6, { { "fc00::1", 1 }, { "fc00::2", 0 } }, m_loIndex);
+        checkSameRoute(unweighted.get(), "2001:db8:2::/64");
+    }
+
+    TEST_F(RouteSyncTest, FastDecodeRejectsShortAttributes)
+    {
+        /* A truncated RTA_TABLE or RTA_OIF is left to the libnl path */
+        uint16_t table = 10;
+        RouteMsg shortTable(RTM_NEWROUTE, AF_INET, 24);
+        shortTable.addAddr(RTA_DST, AF_INET, "16.5.0.0");
+        shortTable.addAttr(RTA_TABLE, &table, sizeof(table));
+        shortTable.addAttr(RTA_OIF, &m_loIndex, sizeof(m_loIndex));
+        ASSERT_FALSE(m_fastSync->onRouteMsgFast(shortTable.get()));
+
+        uint16_t oif = 1;
+        RouteMsg shortOif(RTM_NEWROUTE, AF_INET, 24);
+        shortOif.addAddr(RTA_DST, AF_INET, "16.6.0.0");
+        shortOif.addAttr(RTA_OIF, &oif, sizeof(oif));
+        ASSERT_FALSE(m_fastSync->onRouteMsgFast(shortOif.get()));
+
+        ASSERT_TRUE(m_fastSync->m_pendingRoutes.empty());
+    }
+
+    TEST_F(RouteSyncTest, FlushSuppressesUnchangedRoutes)
+    {
+        RouteMsg route(RTM_NEWROUTE, AF_INET, 24);
+        route.addAddr(RTA_DST, AF_INET, "16.7.0.0");
+        route.addAddr(RTA_GATEWAY, AF_INET, "10.0.0.1");
+        route.addAttr(RTA_OIF, &m_loIndex, sizeof(m_loIndex));
+
+        ASSERT_TRUE(m_fastSync->onRouteMsgFast(route.get()));
+        m_fastSync->flushRoutes();
+        ASSERT_EQ(m_fastSync->m_publishedRoutes.count("16.7.0.0/24"), 1);
+        ASSERT_EQ(m_fastSync->m_suppressedRoutes, 0);
+
+        /* Same next hops again, nothing to publish */
+        ASSERT_TRUE(m_fastSync->onRouteMsgFast(route.get()));
+        m_fastSync->flushRoutes();
+        ASSERT_EQ(m_fastSync->m_suppressedRoutes, 1);
+
+        RouteMsg moved(RTM_NEWROUTE, AF_INET, 24);
+        moved.addAddr(RTA_DST, AF_INET, "16.7.0.0");
+        moved.addAddr(RTA_GATEWAY, AF_INET, "10.0.0.2");
+        moved.addAttr(RTA_OIF, &m_loIndex, sizeof(m_loIndex));
+        uint64_t hash = m_fastSync->m_publishedRoutes["16.7.0.0/24"];
+
+        ASSERT_TRUE(m_fastSync->onRouteMsgFast(moved.get()));
+        m_fastSync->flushRoutes();
+        ASSERT_EQ(m_fastSync->m_suppressedRoutes, 1);
+        ASSERT_NE(m_fastSync->m_publishedRoutes["16.7.0.0/24"], hash);
+
+        RouteMsg del(RTM_DELROUTE, AF_INET, 24);
+        del.addAddr(RTA_DST, AF_INET, "16.7.0.0");
+        ASSERT_TRUE(m_fastSync->onRouteMsgFast(del.get()));
+        m_fastSync->flushRoutes();
+        ASSERT_TRUE(m_fastSync->m_publishedRoutes.empty());
+    }
+}
@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+#define private public
+#include "warmRestartHelper.h"
+#include "warmRestartAssist.h"
+#undef private
+
+namespace warmrestart_test
+{
+    using namespace std;
+    using namespace swss;
+
+    TEST(WarmStartHelper, CompareOneFV)
+    {
+        /* false means the values match */
+        ASSERT_FALSE(WarmStartHelper::compareOneFV("10.1.1.1,10.1.1.2", "10.1.1.1,10.1.1.2"));
+        ASSERT_FALSE(WarmStartHelper::compareOneFV("10.1.1.1,10.1.1.2", "10.1.1.2,10.1.1.1"));
+        ASSERT_FALSE(WarmStartHelper::compareOneFV("Ethernet1,Ethernet2,Ethernet1", "Ethernet1,Ethernet1,Ethernet2"));
+        ASSERT_TRUE(WarmStartHelper::compareOneFV("10.1.1.1,10.1.1.2", "10.1.1.1,10.1.1.3"));
+
+        /* Same elements and length, different multiplicity */
+        ASSERT_TRUE(WarmStartHelper::compareOneFV("a,a,b", "a,b,b"));
+
+        /* Empty values and elements */
+        ASSERT_FALSE(WarmStartHelper::compareOneFV("", ""));
+        ASSERT_TRUE(WarmStartHelper::compareOneFV("", "a"));
+        ASSERT_FALSE(WarmStartHelper::compareOneFV("a,", ",a"));
+        ASSERT_FALSE(WarmStartHelper::compareOneFV("a,,b", "a,b,"));
+        ASSERT_TRUE(WarmStartHelper::compareOneFV("a,,", "a,b"));
+    }
+
+    TEST(WarmStartHelper, CompareAllFV)
+    {
+        vector<FieldValueTuple> restored = { { "nexthop", "10.1.1.1,10.1.1.2" }, { "ifname", "Ethernet1,Ethernet2" } };
+
+        /* false means the vectors match */
+        ASSERT_FALSE(WarmStartHelper::compareAllFV(restored, restored));
+        ASSERT_FALSE(WarmStartHelper::compareAllFV(restored,
+                { { "ifname", "Ethernet2,Ethernet1" }, { "nexthop", "10.1.1.2,10.1.1.1" } }));
+        ASSERT_TRUE(WarmStartHelper::compareAllFV(restored,
+                { { "nexthop", "10.1.1.1,10.1.1.2" }, { "weight", "1,1" } }));
+        ASSERT_TRUE(WarmStartHelper::compareAllFV(restored, { { "nexthop", "10.1.1.1,10.1.1.2" } }));
+
+        /* A repeated field must be repeated as often with the same values */
+        ASSERT_TRUE(WarmStartHelper::compareAllFV({ { "a", "1" }, { "a", "2" } }, { { "a", "1" }, { "a", "1" } }));
+        ASSERT_FALSE(WarmStartHelper::compareAllFV({ { "a", "1" }, { "a", "2" } }, { { "a", "2" }, { "a", "1" } }));
+
+        ASSERT_FALSE(WarmStartHelper::compareAllFV({ { "a", "" } }, { { "a", "" } }));
+        ASSERT_TRUE(WarmStartHelper::compareAllFV({ { "a", "" } }, { { "a", "1" } }));
+        ASSERT_FALSE(WarmStartHelper::compareAllFV({}, {}));
+    }
+
+    TEST(AppRestartAssist, SameFieldValues)
+    {
+        vector<FieldValueTuple> neigh = { { "neigh", "00:01:02:03:04:05" }, { "family", "IPv4" } };
+
+        ASSERT_TRUE(AppRestartAssist::sameFieldValues(neigh, neigh));
+        ASSERT_TRUE(AppRestartAssist::sameFieldValues(neigh, { { "family", "IPv4" }, { "neigh", "00:01:02:03:04:05" } }));
+        ASSERT_FALSE(AppRestartAssist::sameFieldValues(neigh, { { "neigh", "00:01:02:03:04:06" }, { "family", "IPv4" } }));
+        ASSERT_FALSE(AppRestartAssist::sameFieldValues(neigh, { { "neigh", "00:01:02:03:04:05" } }));
+
+        /* Duplicate pairs must occur as often in both */
+        ASSERT_FALSE(AppRestartAssist::sameFieldValues({ { "a", "1" }, { "a", "1" }, { "b", "2" } },
+                                                       { { "a", "1" }, { "b", "2" }, { "b", "2" } }));
+        ASSERT_TRUE(AppRestartAssist::sameFieldValues({ { "a", "1" }, { "a", "1" }, { "b", "2" } },
+                                                      { { "b", "2" }, { "a", "1" }, { "a", "1" } }));
+
+        ASSERT_TRUE(AppRestartAssist::sameFieldValues({ { "a", "" } }, { { "a", "" } }));
+        ASSERT_FALSE(AppRestartAssist::sameFieldValues({ { "a", "" } }, { { "a", "1" } }));
+        ASSERT_TRUE(AppRestartAssist::sameFieldValues({}, {}));
+    }
+
+    TEST(AppRestartAssist, HashFieldValuesIgnoresOrder)
+    {
+        vector<FieldValueTuple> fv = { { "neigh", "00:01:02:03:04:05" }, { "family", "IPv4" } };
+        vector<FieldValueTuple> reversed(fv.rbegin(), fv.rend());
+
+        ASSERT_EQ(AppRestartAssist::hashFieldValues(fv), AppRestartAssist::hashFieldValues(reversed));
+    }
+}
@@ -158,6 +158,70 @@ class TestCrm(object):
         intf_tbl._del("Ethernet0|10.0.0.0/31")
         time.sleep(2)
 
+    def test_CrmEventDriven(self, dvs, testlog):
+
+        config_db = swsscommon.DBConnector(swsscommon.CONFIG_DB, dvs.redis_sock, 0)
+        intf_tbl = swsscommon.Table(config_db, "INTERFACE")
+        fvs = swsscommon.FieldValuePairs([("NULL","NULL")])
+        intf_tbl.set("Ethernet0", fvs)
+        intf_tbl.set("Ethernet0|10.0.0.0/31", fvs)
+        dvs.port_admin_set("Ethernet0", "up")
+
+        dvs.setReadOnlyAttr('SAI_OBJECT_TYPE_SWITCH', 'SAI_SWITCH_ATTR_AVAILABLE_IPV4_ROUTE_ENTRY', '1000')
+
+        crm_update(dvs, "polling_interval", "1")
+        crm_update(dvs, "event_driven", "true")
+
+        # add static neighbor
+        dvs.runcmd("ip neigh replace 10.0.0.1 lladdr 11:22:33:44:55:66 dev Ethernet0")
+
+        db = swsscommon.DBConnector(0, dvs.redis_sock, 0)
+        ps = swsscommon.ProducerStateTable(db, "ROUTE_TABLE")
+        fvs = swsscommon.FieldValuePairs([("nexthop","10.0.0.1"), ("ifname", "Ethernet0")])
+
+        time.sleep(2)
+
+        # get counters
+        used_counter = getCrmCounterValue(dvs, 'STATS', 'crm_stats_ipv4_route_used')
+        avail_counter = getCrmCounterValue(dvs, 'STATS', 'crm_stats_ipv4_route_available')
+
+        # add route, the availability is queried again as the usage changed
+        ps.set("2.2.2.0/24", fvs)
+        dvs.setReadOnlyAttr('SAI_OBJECT_TYPE_SWITCH', 'SAI_SWITCH_ATTR_AVAILABLE_IPV4_ROUTE_ENTRY', '999')
+
+        time.sleep(2)
+
+        new_used_counter = getCrmCounterValue(dvs, 'STATS', 'crm_stats_ipv4_route_used')
+        new_avail_counter = getCrmCounterValue(dvs, 'STATS', 'crm_stats_ipv4_route_available')
+
+        assert new_used_counter - used_counter == 1
+        assert avail_counter - new_avail_counter == 1
+
+        # the availability is not queried while the usage doesn't change
+        dvs.setReadOnlyAttr('SAI_OBJECT_TYPE_SWITCH', 'SAI_SWITCH_ATTR_AVAILABLE_IPV4_ROUTE_ENTRY', '500')
+
+        time.sleep(2)
+
+        assert getCrmCounterValue(dvs, 'STATS', 'crm_stats_ipv4_route_available') == new_avail_counter
+
+        # remove route and update available counter
+        ps._del("2.2.2.0/24")
+        dvs.runcmd("ip neigh del 10.0.0.1 lladdr 11:22:33:44:55:66 dev Ethernet0")
+        dvs.setReadOnlyAttr('SAI_OBJECT_TYPE_SWITCH', 'SAI_SWITCH_ATTR_AVAILABLE_IPV4_ROUTE_ENTRY', '1000')
+
+        time.sleep(2)
+
+        new_used_counter = getCrmCounterValue(dvs, 'STATS', 'crm_stats_ipv4_route_used')
+        new_avail_counter = getCrmCounterValue(dvs, 'STATS', 'crm_stats_ipv4_route_available')
+
+        assert new_used_counter == used_counter
+        assert new_avail_counter == avail_counter
+
+        crm_update(dvs, "event_driven", "false")
+
+        intf_tbl._del("Ethernet0|10.0.0.0/31")
+        time.sleep(2)
+
     def test_CrmIpv6Route(self, dvs, testlog):
 
         # Enable IPv6 routing
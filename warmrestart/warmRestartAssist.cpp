@@ -1,5 +1,7 @@
 #include <string>
 #include <algorithm>
+#include <functional>
+#include <inttypes.h>
 #include "logger.h"
 #include "schema.h"
 #include "warm_restart.h"
@@ -68,22 +70,21 @@ AppRestartAssist::AppRestartAssist(RedisPipeline *pipelineAppDB, const std::stri
 
 AppRestartAssist::~AppRestartAssist()
 {
-    for (auto it = m_appTables.begin(); it != m_appTables.end(); it++)
-    {
-        delete (it->second);
-    }
 }
 
-void AppRestartAssist::registerAppTable(const std::string &tableName, ProducerStateTable *psTable)
+void AppRestartAssist::registerAppTable(const std::string &tableName, ProducerStateTable *psTable, bool buffered)
 {
     m_psTables[tableName]  = psTable;
+    if (buffered)
+    {
+        m_bufferedTables.insert(tableName);
+    }
 
     // Clear the producerstate table to make sure no pending data for the AppTable
     if (m_warmStartInProgress)
     {
         psTable->clear();
     }
-    m_appTables[tableName] = new Table(m_pipeLine, tableName, false);
 }
 
 // join the field-value strings for straight printing.
@@ -97,24 +98,44 @@ string AppRestartAssist::joinVectorString(const vector<FieldValueTuple> &fv)
     return s;
 }
 
-// Set the cache entry state
-void AppRestartAssist::setCacheEntryState(std::vector<FieldValueTuple> &fvVector,
-    cache_state_t state)
+// Hash the field-value pairs, independent of their order
+size_t AppRestartAssist::hashFieldValues(const vector<FieldValueTuple> &fv)
 {
-    fvVector.back().second = cacheStateMap.at(state);
+    std::hash<string> hasher;
+    size_t hash = fv.size();
+
+    for (const auto &temps : fv)
+    {
+        size_t h = hasher(temps.first);
+        h ^= hasher(temps.second) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        hash += h;
+    }
+    return hash;
 }
 
-// Get the cache entry state
-AppRestartAssist::cache_state_t AppRestartAssist::getCacheEntryState(const std::vector<FieldValueTuple> &fvVector)
+// Check if both vectors have the same field-value pairs, in any order and as many times
+bool AppRestartAssist::sameFieldValues(const vector<FieldValueTuple> &left,
+                                       const vector<FieldValueTuple> &right)
 {
-    for (auto &iter : cacheStateMap)
+    if (left.size() != right.size())
+    {
+        return false;
+    }
+
+    // applications usually keep the order of the pairs
+    if (left == right)
+    {
+        return true;
+    }
+
+    for (auto const& rv : right)
     {
-        if (fvVector.back().second == iter.second)
+        if (std::count(left.begin(), left.end(), rv) != std::count(right.begin(), right.end(), rv))
         {
-            return iter.first;
+            return false;
         }
     }
-    throw std::logic_error("cache entry state is invalid");
+    return true;
 }
 
 void AppRestartAssist::appDataReplayed()
@@ -127,40 +148,39 @@ void AppRestartAssist::warmStartDisabled()
     WarmStart::setWarmStartState(m_appName, WarmStart::WSDISABLED);
 }
 
-// Read table(s) from APPDB and append stale flag then insert to cachemap
+// Read table(s) from APPDB in chunks and insert them to cachemap as STALE
 void AppRestartAssist::readTablesToMap()
 {
-    vector<string> keys;
+    auto begin = std::chrono::steady_clock::now();
+    vector<KeyOpFieldsValuesTuple> chunk;
 
-    for (auto it = m_appTables.begin(); it != m_appTables.end(); it++)
+    m_reconcileStats = WarmRestartStats();
+    for (auto it = m_psTables.begin(); it != m_psTables.end(); it++)
     {
-        (it->second)->getKeys(keys);
-        FieldValueTuple state(CACHE_STATE_FIELD, "");
+        auto &cacheMap = appTableCacheMap[it->first];
+        WarmRestartScanner scanner(m_pipeLine, it->first);
 
-        for (const auto &key: keys)
+        do
         {
-            vector<FieldValueTuple> fv;
-
-                // if the fieldvalue is empty, skip
-            if (!(it->second)->get(key, fv))
+            scanner.next(chunk);
+            for (auto &kfv : chunk)
             {
-                continue;
-            }
-
-            fv.push_back(state);
-            setCacheEntryState(fv, STALE);
+                auto &fv = kfvFieldsValues(kfv);
+                size_t hash = hashFieldValues(fv);
 
-            string s = joinVectorString(fv);
-
-            SWSS_LOG_INFO("write to cachemap: %s, key: %s, "
-                   "%s", (it->first).c_str(), key.c_str(), s.c_str());
+                // SCAN may return a key more than once, the first copy wins
+                cacheMap.emplace(std::move(kfvKey(kfv)), CacheEntry{std::move(fv), hash, STALE, true});
+            }
+        } while (!scanner.done());
 
-            // insert to the cache map
-            appTableCacheMap[it->first][key] = fv;
-        }
+        m_reconcileStats.restored += cacheMap.size();
         WarmStart::setWarmStartState(m_appName, WarmStart::RESTORED);
-        SWSS_LOG_NOTICE("Restored appDB table to %s internal cache map", (it->first).c_str());
+        SWSS_LOG_NOTICE("Restored %zu entries of appDB table to %s internal cache map",
+                cacheMap.size(), (it->first).c_str());
     }
+
+    m_reconcileStats.restoreDurationMs = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - begin).count();
     return;
 }
 
@@ -181,47 +201,44 @@ void AppRestartAssist::insertToMap(string tableName, string key, vector<FieldVal
     SWSS_LOG_INFO("Received message %s, key: %s, "
             "%s, delete = %d", tableName.c_str(), key.c_str(), joinVectorString(fvVector).c_str(), delete_key);
 
-    auto found = appTableCacheMap[tableName].find(key);
+    auto &cacheMap = appTableCacheMap[tableName];
+    auto found = cacheMap.find(key);
 
     if (delete_key)
     {
         SWSS_LOG_NOTICE("%s, delete key: %s, ", tableName.c_str(), key.c_str());
         /* mark it as DELETE if exist, otherwise, no-op */
-        if (found != appTableCacheMap[tableName].end())
+        if (found != cacheMap.end())
         {
-            setCacheEntryState(found->second, DELETE);
+            found->second.state = DELETE;
         }
+        return;
     }
-    else if (found != appTableCacheMap[tableName].end())
+
+    size_t hash = hashFieldValues(fvVector);
+
+    if (found != cacheMap.end())
     {
-        // check only the original vector range (exclude cache-state field/value)
-        if(! contains(found->second, fvVector))
+        if (found->second.hash != hash || !sameFieldValues(found->second.fvVector, fvVector))
         {
             SWSS_LOG_NOTICE("%s, found key: %s, new value ", tableName.c_str(), key.c_str());
 
-            FieldValueTuple state(CACHE_STATE_FIELD, "");
-            fvVector.push_back(state);
-
             // mark as NEW flag
-            setCacheEntryState(fvVector, NEW);
-            appTableCacheMap[tableName][key] = fvVector;
+            found->second = CacheEntry{std::move(fvVector), hash, NEW, found->second.restored};
         }
         else
         {
             SWSS_LOG_INFO("%s, found key: %s, same value", tableName.c_str(), key.c_str());
 
             // mark as SAME flag
-            setCacheEntryState(found->second, SAME);
+            found->second.state = SAME;
         }
     }
     else
     {
         // not found, mark the entry as NEW and insert to map
         SWSS_LOG_NOTICE("%s, not found key: %s, new", tableName.c_str(), key.c_str());
-        FieldValueTuple state(CACHE_STATE_FIELD, "");
-        fvVector.push_back(state);
-        setCacheEntryState(fvVector, NEW);
-        appTableCacheMap[tableName][key] = fvVector;
+        cacheMap.emplace(std::move(key), CacheEntry{std::move(fvVector), hash, NEW, false});
     }
     return;
 }
@@ -233,54 +250,85 @@ void AppRestartAssist::insertToMap(string tableName, string key, vector<FieldVal
  *  if has "STALE/DELETE" flag, delete it from appDB.
  *  else if "NEW" flag,  add it to appDB
  *  else, throw (should never happen)
+ *
+ * The producer state tables are buffered for the duration of the reconcile,
+ * so that the deletions and sets of a table go out as a single pipelined batch.
  */
 void AppRestartAssist::reconcile()
 {
     std::string tableName;
+    auto begin = std::chrono::steady_clock::now();
 
     SWSS_LOG_ENTER();
     for (auto tableIter = appTableCacheMap.begin(); tableIter != appTableCacheMap.end(); ++tableIter)
     {
         tableName = tableIter->first;
+        ProducerStateTable *psTable = m_psTables[tableName];
+
+        psTable->setBuffered(true);
         for (auto it = (tableIter->second).begin(); it != (tableIter->second).end(); ++it)
         {
-            string s = joinVectorString(it->second);
-            auto state = getCacheEntryState(it->second);
+            CacheEntry &entry = it->second;
 
-            if (state == SAME)
+            if (entry.state == SAME)
             {
-                SWSS_LOG_INFO("%s SAME, key: %s, %s",
-                        tableName.c_str(), it->first.c_str(), s.c_str());
+                SWSS_LOG_INFO("%s SAME, key: %s", tableName.c_str(), it->first.c_str());
+                m_reconcileStats.unchanged++;
                 continue;
             }
-            else if (state == STALE || state == DELETE)
+
+            string s = joinVectorString(entry.fvVector);
+
+            if (entry.state == STALE || entry.state == DELETE)
             {
-                SWSS_LOG_NOTICE("%s STALE/DELETE, key: %s, %s",
-                        tableName.c_str(), it->first.c_str(), s.c_str());
+                SWSS_LOG_NOTICE("%s %s, key: %s, %s", tableName.c_str(),
+                        cacheStateMap.at(entry.state).c_str(), it->first.c_str(), s.c_str());
 
                 //delete from appDB
-                m_psTables[tableName]->del(it->first);
+                psTable->del(it->first);
+                m_reconcileStats.deleted++;
             }
-            else if (state == NEW)
+            else if (entry.state == NEW)
             {
                 SWSS_LOG_NOTICE("%s NEW, key: %s, %s",
                         tableName.c_str(), it->first.c_str(), s.c_str());
 
-                //add to appDB, exclude the state
-                it->second.pop_back();
-                m_psTables[tableName]->set(it->first, it->second);
+                //add to appDB
+                psTable->set(it->first, entry.fvVector);
+                if (entry.restored)
+                {
+                    m_reconcileStats.updated++;
+                }
+                else
+                {
+                    m_reconcileStats.added++;
+                }
             }
             else
             {
                 throw std::logic_error("cache entry state is invalid");
             }
         }
+        m_pipeLine->flush();
+        psTable->setBuffered(m_bufferedTables.count(tableName) != 0);
+
         // reconcile finished, clear the map, mark the warmstart state
-        appTableCacheMap[tableName].clear();
+        tableIter->second.clear();
     }
     appTableCacheMap.clear();
+
+    m_reconcileStats.reconcileDurationMs = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - begin).count();
+    m_reconcileStats.publish(m_appName);
+
     WarmStart::setWarmStartState(m_appName, WarmStart::RECONCILED);
     m_warmStartInProgress = false;
+
+    SWSS_LOG_NOTICE("%s restored %" PRIu64 " entries in %" PRIu64 " ms, reconciled in %" PRIu64
+            " ms: %" PRIu64 " added, %" PRIu64 " updated, %" PRIu64 " deleted, %" PRIu64 " unchanged",
+            m_appName.c_str(), m_reconcileStats.restored, m_reconcileStats.restoreDurationMs,
+            m_reconcileStats.reconcileDurationMs, m_reconcileStats.added, m_reconcileStats.updated,
+            m_reconcileStats.deleted, m_reconcileStats.unchanged);
     return;
 }
 
@@ -314,18 +362,3 @@ bool AppRestartAssist::checkReconcileTimer(Selectable *s)
     }
     return false;
 }
-
-// check if left vector contains all elements of right vector
-bool AppRestartAssist::contains(const std::vector<FieldValueTuple>& left,
-              const std::vector<FieldValueTuple>& right)
-{
-    for (auto const& rv : right)
-    {
-        if (std::find(left.begin(), left.end(), rv) == left.end())
-        {
-            return false;
-        }
-    }
-
-    return true;
-}
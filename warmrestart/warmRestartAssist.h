@@ -2,19 +2,22 @@
 #define __WARM_RESTART_ASSIST__
 
 #include <unordered_map>
+#include <set>
 #include <string>
+#include <chrono>
 #include "dbconnector.h"
 #include "table.h"
 #include "producerstatetable.h"
 #include "selectabletimer.h"
 #include "select.h"
+#include "warmRestartScan.h"
 
 namespace swss {
 
 /*
  * This class is to support application table reconciliation
  * For any application table which has entries with key -> vector<f1/v2, f2/v2..>
- * It is expect that the application owner keeps the order of f/v pairs
+ * An entry is unchanged if it has the same f/v pairs, in any order
  * The application usually takes this class as composition, i.e. includes an instance of
  * this class in their classes.
  * A high level flow to use this class:
@@ -88,13 +91,13 @@ public:
     {
         return m_warmStartInProgress;
     }
-    void registerAppTable(const std::string &tableName, ProducerStateTable *psTable);
+    /* A buffered psTable is flushed by the application, it is kept buffered after reconcile */
+    void registerAppTable(const std::string &tableName, ProducerStateTable *psTable, bool buffered = false);
 
 private:
     typedef std::map<cache_state_t, std::string> cache_state_map;
     // Enum to string translation map
     static const cache_state_map cacheStateMap;
-    const std::string CACHE_STATE_FIELD = "cache-state";
 
     /*
      * Default timer to be 5 seconds
@@ -102,27 +105,39 @@ private:
      * Precedence ascent order: Default -> loading class with value -> configuration
      */
     static const uint32_t DEFAULT_INTERNAL_TIMER_VALUE = 5;
-    typedef std::map<std::string, std::unordered_map<std::string, std::vector<swss::FieldValueTuple>>> AppTableMap;
+
+    /*
+     * Cache entry, the hash of the f/v pairs is independent of their order
+     * so that most changed entries are told apart without comparing them.
+     * restored is set for the entries read from appDB.
+     */
+    struct CacheEntry
+    {
+        std::vector<swss::FieldValueTuple> fvVector;
+        size_t hash;
+        cache_state_t state;
+        bool restored;
+    };
+    typedef std::map<std::string, std::unordered_map<std::string, CacheEntry>> AppTableMap;
 
     // cache map to store temporary application table
     AppTableMap appTableCacheMap;
 
     RedisPipeline      *m_pipeLine;
-    Tables              m_appTables;  // app tables
     std::string         m_dockerName; // docker name of the application
     std::string         m_appName;    // application name
     ProducerStateTables m_psTables;   // producer state tables
+    std::set<std::string> m_bufferedTables; // app tables registered as buffered
 
     bool m_warmStartInProgress;       // indicate if warm start is in progress
     time_t m_reconcileTimer;          // reconcile timer value
     SelectableTimer m_warmStartTimer; // reconcile timer
+    WarmRestartStats m_reconcileStats; // counters of the last restore and reconcile
 
-    // Set or get cache entry state
     std::string joinVectorString(const std::vector<FieldValueTuple> &fv);
-    void setCacheEntryState(std::vector<FieldValueTuple> &fvVector, cache_state_t state);
-    cache_state_t getCacheEntryState(const std::vector<FieldValueTuple> &fvVector);
-    bool contains(const std::vector<FieldValueTuple>& left,
-                  const std::vector<FieldValueTuple>& right);
+    static size_t hashFieldValues(const std::vector<FieldValueTuple> &fv);
+    static bool sameFieldValues(const std::vector<FieldValueTuple> &left,
+                                const std::vector<FieldValueTuple> &right);
 };
 
 }
@@ -1,5 +1,8 @@
 #include <cassert>
+#include <chrono>
+#include <inttypes.h>
 #include <sstream>
+#include <stdexcept>
 
 #include "warmRestartHelper.h"
 
@@ -12,7 +15,7 @@ WarmStartHelper::WarmStartHelper(RedisPipeline      *pipeline,
                                  const std::string  &syncTableName,
                                  const std::string  &dockerName,
                                  const std::string  &appName) :
-    m_restorationTable(pipeline, syncTableName, false),
+    m_pipeline(pipeline),
     m_syncTable(syncTable),
     m_syncTableName(syncTableName),
     m_dockName(dockerName),
@@ -65,7 +68,6 @@ bool WarmStartHelper::checkAndStart(void)
     }
 
     /* Cleaning state from previous (unsuccessful) warm-restart attempts */
-    m_restorationVector.clear();
     m_refreshMap.clear();
 
     /* Keeping track of warm-reboot active/inactive state */
@@ -95,22 +97,28 @@ uint32_t WarmStartHelper::getRestartTimer(void) const
 
 /*
  * Invoked by warmStartHelper clients during initialization. All interested parties
- * are expected to call this method to upload their associated redisDB state into
- * a temporary buffer, which will eventually serve to resolve any conflict between
- * 'old' and 'new' state.
+ * are expected to call this method to check whether there is redisDB state to
+ * reconcile with. The state itself is streamed from AppDB by reconcile(), chunk
+ * by chunk, rather than being held in memory for the whole restart cycle.
  */
 bool WarmStartHelper::runRestoration()
 {
     SWSS_LOG_NOTICE("Warm-Restart: Initiating AppDB restoration process for %s "
                     "application.", m_appName.c_str());
 
-    m_restorationTable.getContent(m_restorationVector);
+    WarmRestartScanner scanner(m_pipeline, m_syncTableName, RECONCILE_SCAN_COUNT);
+    std::vector<std::string> keys;
+
+    do
+    {
+        scanner.scanKeys(keys);
+    } while (keys.empty() && !scanner.done());
 
     /*
      * If there's no AppDB state to restore, then alert callee right away to avoid
      * iterating through the 'reconciliation' process.
      */
-    if (!m_restorationVector.size())
+    if (keys.empty())
     {
         SWSS_LOG_NOTICE("Warm-Restart: No records received from AppDB for %s "
                         "application.", m_appName.c_str());
@@ -120,11 +128,6 @@ bool WarmStartHelper::runRestoration()
         return false;
     }
 
-    SWSS_LOG_NOTICE("Warm-Restart: Received %zu records from AppDB for %s "
-                    "application.",
-                    m_restorationVector.size(),
-                    m_appName.c_str());
-
     setState(WarmStart::RESTORED);
 
     SWSS_LOG_NOTICE("Warm-Restart: Completed AppDB restoration process for %s "
@@ -138,7 +141,88 @@ void WarmStartHelper::insertRefreshMap(const KeyOpFieldsValuesTuple &kfv)
 {
     const std::string key = kfvKey(kfv);
 
-    m_refreshMap[key] = kfv;
+    m_refreshMap[key] = RefreshEntry{kfv, false};
+}
+
+
+/*
+ * Reconcile one restored element with its refreshed counterpart, if any.
+ */
+void WarmStartHelper::reconcileEntry(const KeyOpFieldsValuesTuple          &restoredElem,
+                                     std::unordered_set<std::string>       &staleKeys)
+{
+    const std::string &restoredKey = kfvKey(restoredElem);
+    const auto &restoredFV         = kfvFieldsValues(restoredElem);
+
+    auto iter = m_refreshMap.find(restoredKey);
+
+    /*
+     * If the restored element is not found in the refreshMap, we must
+     * push a delete operation for this entry (once, SCAN may return it again).
+     */
+    if (iter == m_refreshMap.end())
+    {
+        if (!staleKeys.insert(restoredKey).second)
+        {
+            return;
+        }
+        m_reconcileStats.restored++;
+
+        SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting stale entry %s",
+                        printKFV(restoredKey, restoredFV).c_str());
+
+        m_syncTable->del(restoredKey);
+        m_reconcileStats.deleted++;
+        return;
+    }
+
+    /* Already reconciled, SCAN returned this key again */
+    if (iter->second.reconciled)
+    {
+        return;
+    }
+    iter->second.reconciled = true;
+    m_reconcileStats.restored++;
+
+    const KeyOpFieldsValuesTuple &refreshed = iter->second.kfv;
+
+    /*
+     * If an explicit delete request is sent by the application, process it
+     * right away.
+     */
+    if (kfvOp(refreshed) == DEL_COMMAND)
+    {
+        SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting entry %s",
+                        printKFV(restoredKey, restoredFV).c_str());
+
+        m_syncTable->del(restoredKey);
+        m_reconcileStats.deleted++;
+    }
+
+    /*
+     * If a matching entry is found in refreshMap, proceed to compare it
+     * with its restored counterpart.
+     */
+    else
+    {
+        const auto &refreshedFV = kfvFieldsValues(refreshed);
+
+        if (compareAllFV(restoredFV, refreshedFV))
+        {
+            SWSS_LOG_NOTICE("Warm-Restart reconciliation: updating entry %s",
+                            printKFV(restoredKey, refreshedFV).c_str());
+
+            m_syncTable->set(restoredKey, refreshedFV);
+            m_reconcileStats.updated++;
+        }
+        else
+        {
+            SWSS_LOG_INFO("Warm-Restart reconciliation: no changes needed for "
+                          "existing entry %s",
+                          printKFV(restoredKey, refreshedFV).c_str());
+            m_reconcileStats.unchanged++;
+        }
+    }
 }
 
 
@@ -148,6 +232,9 @@ void WarmStartHelper::insertRefreshMap(const KeyOpFieldsValuesTuple &kfv)
  * generated by the application once it completes its restart cycle. If a
  * state-diff is found between these two, we will be honoring the refreshed
  * one received from the application, and will proceed to push it down to AppDB.
+ *
+ * The old state is scanned from AppDB one chunk at a time, and the diffs are
+ * pushed through the (buffered) sync table as they are found.
  */
 void WarmStartHelper::reconcile(void)
 {
@@ -156,75 +243,40 @@ void WarmStartHelper::reconcile(void)
 
     assert(getState() == WarmStart::RESTORED);
 
-    for (auto &restoredElem : m_restorationVector)
-    {
-        std::string restoredKey  = kfvKey(restoredElem);
-        auto restoredFV          = kfvFieldsValues(restoredElem);
-
-        auto iter = m_refreshMap.find(restoredKey);
+    auto begin = std::chrono::steady_clock::now();
+    m_reconcileStats = WarmRestartStats();
+    std::chrono::steady_clock::duration readTime{0};
 
-        /*
-         * If the restored element is not found in the refreshMap, we must
-         * push a delete operation for this entry.
-         */
-        if (iter == m_refreshMap.end())
-        {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting stale entry %s",
-                            printKFV(restoredKey, restoredFV).c_str());
+    WarmRestartScanner scanner(m_pipeline, m_syncTableName, RECONCILE_SCAN_COUNT);
+    std::unordered_set<std::string> staleKeys;
+    kfvVector chunk;
 
-            m_syncTable->del(restoredKey);
-            continue;
-        }
-
-        /*
-         * If an explicit delete request is sent by the application, process it
-         * right away.
-         */
-        else if (kfvOp(iter->second) == DEL_COMMAND)
-        {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting entry %s",
-                            printKFV(restoredKey, restoredFV).c_str());
-
-            m_syncTable->del(restoredKey);
-        }
+    do
+    {
+        auto readBegin = std::chrono::steady_clock::now();
+        scanner.next(chunk);
+        readTime += std::chrono::steady_clock::now() - readBegin;
 
-        /*
-         * If a matching entry is found in refreshMap, proceed to compare it
-         * with its restored counterpart.
-         */
-        else
+        for (const auto &restoredElem : chunk)
         {
-            auto refreshedKey = kfvKey(iter->second);
-            auto refreshedFV  = kfvFieldsValues(iter->second);
-
-            if (compareAllFV(restoredFV, refreshedFV))
-            {
-                SWSS_LOG_NOTICE("Warm-Restart reconciliation: updating entry %s",
-                                printKFV(refreshedKey, refreshedFV).c_str());
-
-                m_syncTable->set(refreshedKey, refreshedFV);
-            }
-            else
-            {
-                SWSS_LOG_INFO("Warm-Restart reconciliation: no changes needed for "
-                              "existing entry %s",
-                              printKFV(refreshedKey, refreshedFV).c_str());
-            }
+            reconcileEntry(restoredElem, staleKeys);
         }
-
-        /* Deleting the just-processed restored entry from the refreshMap */
-        m_refreshMap.erase(restoredKey);
-    }
+    } while (!scanner.done());
 
     /*
-     * Iterate through all the entries left in the refreshMap, which correspond
-     * to brand-new entries to be pushed down to AppDB.
+     * Iterate through all the entries left unreconciled in the refreshMap, which
+     * correspond to brand-new entries to be pushed down to AppDB.
      */
-    for (auto &kfv : m_refreshMap)
+    for (auto &entry : m_refreshMap)
     {
-        auto refreshedKey = kfvKey(kfv.second);
-        auto refreshedOp  = kfvOp(kfv.second);
-        auto refreshedFV  = kfvFieldsValues(kfv.second);
+        if (entry.second.reconciled)
+        {
+            continue;
+        }
+
+        const auto &refreshedKey = kfvKey(entry.second.kfv);
+        const auto &refreshedOp  = kfvOp(entry.second.kfv);
+        const auto &refreshedFV  = kfvFieldsValues(entry.second.kfv);
 
         /*
          * During warm-reboot, apps could receive an 'add' and a 'delete' for an
@@ -244,28 +296,45 @@ void WarmStartHelper::reconcile(void)
                             printKFV(refreshedKey, refreshedFV).c_str());
 
             m_syncTable->set(refreshedKey, refreshedFV);
+            m_reconcileStats.added++;
         }
     }
 
     /* Clearing pending kfv's from refreshMap */
     m_refreshMap.clear();
 
-    /* Clearing restoration vector */
-    m_restorationVector.clear();
+    /* The restored state is read chunk by chunk as it is reconciled */
+    m_reconcileStats.restoreDurationMs = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+            readTime).count();
+    m_reconcileStats.reconcileDurationMs = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - begin - readTime).count();
+    m_reconcileStats.publish(m_appName);
 
     setState(WarmStart::RECONCILED);
 
     SWSS_LOG_NOTICE("Warm-Restart: Concluded reconciliation process for %s "
-                    "application.", m_appName.c_str());
+                    "application, restored %" PRIu64 " entries in %" PRIu64 " ms, reconciled in "
+                    "%" PRIu64 " ms: %" PRIu64 " added, %" PRIu64 " updated, %" PRIu64 " deleted, "
+                    "%" PRIu64 " unchanged.", m_appName.c_str(), m_reconcileStats.restored,
+                    m_reconcileStats.restoreDurationMs, m_reconcileStats.reconcileDurationMs,
+                    m_reconcileStats.added,
+                    m_reconcileStats.updated, m_reconcileStats.deleted,
+                    m_reconcileStats.unchanged);
 }
 
 
 /*
- * Compare all field-value-tuples within two vectors.
+ * Compare all field-value-tuples within two vectors, without allocating.
  *
  * Example: v1 {nexthop: 10.1.1.1, ifname: eth1}
  *          v2 {nexthop: 10.1.1.2, ifname: eth2}
  *
+ * Every application relies on a uniform schema to create/generate information
+ * (fpmsyncd always pushes "nexthop" and "ifname" fields, neighsyncd "family"
+ * and "neigh", etc.), so the vectors are small and a field present in only one
+ * of them, e.g. an optional "weight", is a change. A field repeated within a
+ * vector must be repeated as often, with matching values, in the other one.
+ *
  * Returns:
  *
  *    'false' : If the content of both 'fields' and 'values' fully match
@@ -274,27 +343,23 @@ void WarmStartHelper::reconcile(void)
 bool WarmStartHelper::compareAllFV(const std::vector<FieldValueTuple> &v1,
                                    const std::vector<FieldValueTuple> &v2)
 {
-    std::unordered_map<std::string, std::string> v1Map((v1.begin()), v1.end());
+    if (v1.size() != v2.size())
+    {
+        return true;
+    }
 
-     /* Iterate though all v2 tuples to check if their content match v1 ones */
-    for (auto &v2fv : v2)
+    auto sameFV = [&](const FieldValueTuple &fv)
     {
-        auto v1Iter = v1Map.find(v2fv.first);
-        /*
-         * The sizes of both tuple-vectors should always match within any
-         * given application. In other words, all fields within v1 should be
-         * also present in v2.
-         *
-         * To make this possible, every application should continue relying on a
-         * uniform schema to create/generate information. For example, fpmsyncd
-         * will be always expected to push FieldValueTuples with "nexthop" and
-         * "ifname" fields; neighsyncd is expected to make use of "family" and
-         * "neigh" fields, etc. The existing reconciliation logic will rely on
-         * this assumption.
-         */
-        assert(v1Iter != v1Map.end());
+        return [&fv](const FieldValueTuple &other)
+        {
+            return fvField(other) == fvField(fv) && !compareOneFV(fvValue(other), fvValue(fv));
+        };
+    };
 
-        if (compareOneFV(v1Map[fvField(*v1Iter)], fvValue(v2fv)))
+    for (const auto &v2fv : v2)
+    {
+        if (std::count_if(v1.begin(), v1.end(), sameFV(v2fv)) !=
+            std::count_if(v2.begin(), v2.end(), sameFV(v2fv)))
         {
             return true;
         }
@@ -305,7 +370,34 @@ bool WarmStartHelper::compareAllFV(const std::vector<FieldValueTuple> &v1,
 
 
 /*
- * Compare the values of a single field-value within two different KFVs.
+ * Number of occurrences of 'token' among the comma separated elements of 's'.
+ */
+static size_t countToken(const std::string &s, const char *token, size_t len)
+{
+    size_t count = 0;
+    size_t start = 0;
+
+    while (start <= s.size())
+    {
+        size_t end = s.find(',', start);
+        if (end == std::string::npos)
+        {
+            end = s.size();
+        }
+        if (end - start == len && !s.compare(start, len, token, len))
+        {
+            count++;
+        }
+        start = end + 1;
+    }
+
+    return count;
+}
+
+
+/*
+ * Compare the values of a single field-value within two different KFVs,
+ * ignoring the order of the comma separated elements.
  *
  * Example: s1 {nexthop: 10.1.1.1, 10.1.1.2}
  *          s2 {nexthop: 10.1.1.2, 10.1.1.1}
@@ -325,23 +417,28 @@ bool WarmStartHelper::compareOneFV(const std::string &s1, const std::string &s2)
         return true;
     }
 
-    std::vector<std::string> splitValuesS1 = tokenize(s1, ',');
-    std::vector<std::string> splitValuesS2 = tokenize(s2, ',');
-
-    if (splitValuesS1.size() != splitValuesS2.size())
+    if (s1 == s2)
     {
-        return true;
+        return false;
     }
 
-    std::sort(splitValuesS1.begin(), splitValuesS1.end());
-    std::sort(splitValuesS2.begin(), splitValuesS2.end());
-
-    for (size_t i = 0; i < splitValuesS1.size(); i++)
+    /* Same length, so the elements match iff each one occurs as often in both */
+    size_t start = 0;
+    while (start <= s2.size())
     {
-        if (splitValuesS1[i] != splitValuesS2[i])
+        size_t end = s2.find(',', start);
+        if (end == std::string::npos)
+        {
+            end = s2.size();
+        }
+
+        const char *token = s2.data() + start;
+        size_t len = end - start;
+        if (countToken(s1, token, len) != countToken(s2, token, len))
         {
             return true;
         }
+        start = end + 1;
     }
 
     return false;
@@ -5,6 +5,7 @@
 #include <vector>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 
 #include "dbconnector.h"
@@ -13,6 +14,7 @@
 #include "table.h"
 #include "tokenize.h"
 #include "warm_restart.h"
+#include "warmRestartScan.h"
 
 
 namespace swss {
@@ -61,15 +63,32 @@ class WarmStartHelper {
 
   private:
 
-    bool compareAllFV(const std::vector<FieldValueTuple> &left,
-                      const std::vector<FieldValueTuple> &right);
+    /* Restored entries are scanned from AppDB in chunks of this many keys */
+    static const int RECONCILE_SCAN_COUNT = 1000;
 
-    bool compareOneFV(const std::string &v1, const std::string &v2);
+    /*
+     * Entry of the refreshMap. Entries are flagged once their restored
+     * counterpart is reconciled, as SCAN may return a key more than once.
+     */
+    struct RefreshEntry
+    {
+        KeyOpFieldsValuesTuple kfv;
+        bool                   reconciled;
+    };
+
+    void reconcileEntry(const KeyOpFieldsValuesTuple          &restoredElem,
+                        std::unordered_set<std::string>       &staleKeys);
+
+    static bool compareAllFV(const std::vector<FieldValueTuple> &left,
+                             const std::vector<FieldValueTuple> &right);
+
+    static bool compareOneFV(const std::string &v1, const std::string &v2);
 
+    RedisPipeline            *m_pipeline;          // pipeline of the restoration table
     ProducerStateTable       *m_syncTable;         // producer-table to sync/push state to
-    Table                     m_restorationTable;  // redis table to import current-state from
-    kfvVector                 m_restorationVector; // buffer struct to hold old state
-    kfvMap                    m_refreshMap;        // buffer struct to hold new state
+    std::unordered_map<std::string, RefreshEntry>
+                              m_refreshMap;        // buffer struct to hold new state
+    WarmRestartStats          m_reconcileStats;    // counters of the last reconciliation
     WarmStart::WarmStartState m_state;             // cached value of warmStart's FSM state
     bool                      m_enabled;           // warm-reboot enabled/disabled status
     std::string               m_syncTableName;     // producer-table-name to sync/push state to
@@ -0,0 +1,102 @@
+#include <stdexcept>
+
+#include "rediscommand.h"
+#include "redisreply.h"
+#include "schema.h"
+#include "warmRestartScan.h"
+
+using namespace swss;
+
+WarmRestartScanner::WarmRestartScanner(RedisPipeline *pipeline, const std::string &tableName, int count) :
+    m_pipeline(new RedisPipeline(pipeline->getDBConnector())),
+    m_reader(m_pipeline.get()),
+    m_table(pipeline, tableName, false),
+    m_count(count),
+    m_cursor("0"),
+    m_done(false)
+{
+}
+
+void WarmRestartScanner::scanKeys(std::vector<std::string> &keys)
+{
+    const std::string pattern = m_table.getKeyName("*");
+    const size_t prefixLen = pattern.size() - 1;
+
+    keys.clear();
+    if (m_done)
+    {
+        return;
+    }
+
+    RedisCommand scan;
+    scan.format({ "SCAN", m_cursor, "MATCH", pattern, "COUNT", std::to_string(m_count) });
+    RedisReply r(m_pipeline->getDBConnector(), scan, REDIS_REPLY_ARRAY);
+    redisReply *reply = r.getContext();
+
+    if (reply->elements != 2 ||
+        reply->element[0]->type != REDIS_REPLY_STRING ||
+        reply->element[1]->type != REDIS_REPLY_ARRAY)
+    {
+        throw std::runtime_error("Warm-Restart: failed to scan " + pattern);
+    }
+
+    redisReply *keyArray = reply->element[1];
+    for (size_t i = 0; i < keyArray->elements; i++)
+    {
+        redisReply *key = keyArray->element[i];
+        if (key->type == REDIS_REPLY_STRING && key->len > prefixLen)
+        {
+            keys.emplace_back(key->str + prefixLen, key->len - prefixLen);
+        }
+    }
+
+    m_cursor.assign(reply->element[0]->str, reply->element[0]->len);
+    m_done = (m_cursor == "0");
+}
+
+void WarmRestartScanner::getEntries(const std::vector<std::string> &keys,
+                                    std::vector<KeyOpFieldsValuesTuple> &entries)
+{
+    for (const auto &key : keys)
+    {
+        m_reader.hgetall(m_table.getKeyName(key));
+    }
+
+    std::vector<RedisBatchReader::Reply> replies;
+    m_reader.exec(replies);
+
+    entries.clear();
+    for (size_t k = 0; k < keys.size(); k++)
+    {
+        const auto &reply = replies[k];
+
+        /* The entry was removed since it was scanned */
+        if (reply.empty())
+        {
+            continue;
+        }
+
+        std::vector<FieldValueTuple> fvVector;
+        fvVector.reserve(reply.size() / 2);
+        for (size_t i = 0; i + 1 < reply.size(); i += 2)
+        {
+            fvVector.emplace_back(*reply[i], *reply[i + 1]);
+        }
+        entries.emplace_back(keys[k], "", std::move(fvVector));
+    }
+}
+
+void WarmRestartStats::publish(const std::string &appName) const
+{
+    DBConnector stateDb("STATE_DB", 0);
+    Table warmRestartTable(&stateDb, STATE_WARM_RESTART_TABLE_NAME);
+
+    std::vector<FieldValueTuple> fvVector = {
+        {"restore_duration_ms", std::to_string(restoreDurationMs)},
+        {"reconcile_duration_ms", std::to_string(reconcileDurationMs)},
+        {"reconcile_added", std::to_string(added)},
+        {"reconcile_updated", std::to_string(updated)},
+        {"reconcile_deleted", std::to_string(deleted)},
+    };
+    warmRestartTable.set(appName, fvVector);
+}
@@ -0,0 +1,82 @@
+#ifndef __WARMRESTART_SCAN__
+#define __WARMRESTART_SCAN__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dbconnector.h"
+#include "redispipeline.h"
+#include "table.h"
+#include "redisbatch.h"
+
+namespace swss {
+
+/*
+ * Reads an AppDB table in chunks, on a pipeline of its own so that it does
+ * not interfere with the pipeline of the application. Each chunk costs one
+ * SCAN round trip for its keys and one pipelined round trip for all their
+ * HGETALLs, instead of one KEYS plus one HGETALL round trip per entry.
+ *
+ * SCAN may return a key more than once, callers must tolerate duplicates.
+ */
+class WarmRestartScanner
+{
+public:
+    /* Keys scanned per chunk, a hint to redis */
+    static const int DEFAULT_SCAN_COUNT = 1000;
+
+    WarmRestartScanner(RedisPipeline *pipeline, const std::string &tableName,
+                       int count = DEFAULT_SCAN_COUNT);
+
+    /* Scan the keys of the next chunk, stripped of the table name */
+    void scanKeys(std::vector<std::string> &keys);
+
+    /* Read the given keys, those removed since they were scanned are skipped */
+    void getEntries(const std::vector<std::string> &keys,
+                    std::vector<KeyOpFieldsValuesTuple> &entries);
+
+    /* Scan and read the next chunk */
+    void next(std::vector<KeyOpFieldsValuesTuple> &entries)
+    {
+        scanKeys(m_keys);
+        getEntries(m_keys, entries);
+    }
+
+    /* The whole table was scanned */
+    bool done() const
+    {
+        return m_done;
+    }
+
+private:
+    std::unique_ptr<RedisPipeline>  m_pipeline;
+    RedisBatchReader                m_reader;
+    Table                           m_table;
+    int                             m_count;
+    std::string                     m_cursor;
+    bool                            m_done;
+    std::vector<std::string>        m_keys;
+};
+
+/*
+ * Outcome of the restore and reconcile of a warm restart, the same for every
+ * application so that they can be compared in STATE_DB.
+ */
+struct WarmRestartStats
+{
+    uint64_t restored = 0;
+    uint64_t restoreDurationMs = 0;
+    uint64_t added = 0;
+    uint64_t updated = 0;
+    uint64_t deleted = 0;
+    uint64_t unchanged = 0;
+    uint64_t reconcileDurationMs = 0;
+
+    /* Record the stats next to the warm restart state of the application */
+    void publish(const std::string &appName) const;
+};
+
+}
+
+#endif